@@ -0,0 +1,111 @@
+#ifndef MOAB_BOOLEAN_SINK_H_
+#define MOAB_BOOLEAN_SINK_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/rectilinear_grid.h"
+#include "moab/sweep_frontier.h"
+
+namespace moab {
+
+namespace gtl = boost::polygon;
+
+namespace boolean_sink_internal {
+
+// A horizontal edge of an input box.
+template <typename T>
+struct Event {
+  T y;
+  int delta;
+  int input;
+  T x0;
+  T x1;
+};
+
+// Appends the edges of a Box2, a rectilinear ring, or a polygon set. Shapes of
+// a container are added one by one and may overlap each other.
+template <typename T, typename Geometry>
+void CollectEvents(const Geometry& g, int input,
+                   std::vector<Event<T>>& events) {
+  using concept_type = typename gtl::geometry_concept<Geometry>::type;
+  if constexpr (std::is_same_v<concept_type, gtl::rectangle_concept>) {
+    const T xl = gtl::xl(g), yl = gtl::yl(g), xh = gtl::xh(g), yh = gtl::yh(g);
+    if (xl >= xh || yl >= yh) return;
+    events.push_back({yl, 1, input, xl, xh});
+    events.push_back({yh, -1, input, xl, xh});
+  } else if constexpr (std::is_same_v<concept_type, gtl::undefined_concept>) {
+    for (const auto& e : g) CollectEvents<T>(e, input, events);
+  } else {
+    for (const Box2<T>& b : ToBoxes<T>(g)) CollectEvents<T>(b, input, events);
+  }
+}
+
+}  // namespace boolean_sink_internal
+
+// Rectilinear polygon set boolean that streams its output.
+// Calls sink(const Box2<T>&) for every box of lhs op rhs, in increasing order
+// of top edge, as soon as the scanline has passed the box. lhs and rhs are a
+// Box2, a rectilinear ring, or a polygon set (e.g., a std::vector of Box2 with
+// overlaps).
+//
+// The output boxes do not overlap. Each is a maximal horizontal run of the
+// result, extended upward while the run stays the same. Besides the edges of
+// the inputs, only the scanline state is kept (see SweepFrontier), so peak
+// memory is bounded by the input and not by the output, and results can go
+// straight into an Rtree or a file:
+//
+//   Rtree<Box2_i> index;
+//   StreamBooleanSet(a, b, BooleanOp::kSubtract,
+//                    [&index](const Box2_i& box) { index.Insert(box); });
+template <typename Lhs, typename Rhs, typename Sink>
+void StreamBooleanSet(const Lhs& lhs, const Rhs& rhs, BooleanOp op,
+                      Sink&& sink) {
+  using T = coordinate_of_t<Lhs>;
+  using Event = boolean_sink_internal::Event<T>;
+  std::vector<Event> events;
+  boolean_sink_internal::CollectEvents<T>(lhs, 0, events);
+  boolean_sink_internal::CollectEvents<T>(rhs, 1, events);
+  std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+    return a.y < b.y;
+  });
+
+  // The state of an x is how many boxes of each input cover it.
+  auto inside = [op](const std::array<int, 2>& counts) {
+    const bool a = counts[0] > 0, b = counts[1] > 0;
+    switch (op) {
+      case BooleanOp::kUnion:
+        return a || b;
+      case BooleanOp::kIntersection:
+        return a && b;
+      case BooleanOp::kDisjointUnion:
+        return a != b;
+      case BooleanOp::kSubtract:
+        return a && !b;
+    }
+    return false;
+  };
+  SweepFrontier<T, std::array<int, 2>, decltype(inside)> frontier(inside);
+  auto emit = [&sink](const Box2<T>& b, bool) { sink(b); };
+  std::size_t e = 0;
+  while (e < events.size()) {
+    const T y = events[e].y;
+    for (; e < events.size() && events[e].y == y; ++e) {
+      const Event& ev = events[e];
+      frontier.Update(ev.x0, ev.x1, [&ev](std::array<int, 2>& counts) {
+        counts[ev.input] += ev.delta;
+      });
+    }
+    frontier.Flush(y, emit);
+  }
+}
+
+}  // namespace moab
+
+#endif  // MOAB_BOOLEAN_SINK_H_
@@ -0,0 +1,127 @@
+#include "boolean_sink.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+#include "moab/rtree.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(StreamBooleanSet, Empty) {
+  std::vector<Box2_i> out;
+  StreamBooleanSet(std::vector<Box2_i>{}, std::vector<Box2_i>{},
+                   BooleanOp::kUnion,
+                   [&out](const Box2_i& b) { out.push_back(b); });
+
+  EXPECT_THAT(out, IsEmpty());
+}
+
+TEST(StreamBooleanSet, Subtract) {
+  std::vector<Box2_i> out;
+  StreamBooleanSet(Box2_i(0, 0, 30, 30), Box2_i(10, 10, 20, 20),
+                   BooleanOp::kSubtract,
+                   [&out](const Box2_i& b) { out.push_back(b); });
+
+  // In increasing order of top edge.
+  EXPECT_THAT(out, ElementsAre(Box2_i(0, 0, 30, 10), Box2_i(0, 10, 10, 20),
+                               Box2_i(20, 10, 30, 20),
+                               Box2_i(0, 20, 30, 30)));
+}
+
+TEST(StreamBooleanSet, OverlappingInputs) {
+  std::vector<Box2_i> a = {Box2_i(0, 0, 20, 10), Box2_i(10, 0, 30, 10)};
+  std::vector<Box2_i> out;
+  StreamBooleanSet(a, Box2_i(5, 0, 25, 10), BooleanOp::kDisjointUnion,
+                   [&out](const Box2_i& b) { out.push_back(b); });
+
+  EXPECT_THAT(out, ElementsAre(Box2_i(0, 0, 5, 10), Box2_i(25, 0, 30, 10)));
+}
+
+TEST(StreamBooleanSet, IntoRtree) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(30, 0), Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(0, 10),
+               Point2_i(0, 0)};
+  Rtree<Box2_i> index;
+  StreamBooleanSet(r, Box2_i(10, 0, 40, 20), BooleanOp::kIntersection,
+                   [&index](const Box2_i& b) { index.Insert(b); });
+
+  std::vector<Box2_i> boxes(index.begin(), index.end());
+  EXPECT_EQ(Area(boxes), 20 * 10 + 10 * 10);
+}
+
+void CheckRandomBooleans(BooleanOp op) {
+  std::mt19937 gen(37);
+  std::uniform_int_distribution<int> pos(0, 500);
+  std::uniform_int_distribution<int> size(1, 80);
+  std::vector<Box2_i> a, b;
+  for (int i = 0; i < 200; ++i) {
+    int x = pos(gen), y = pos(gen);
+    (i % 2 == 0 ? a : b).emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+  std::vector<Box2_i> expected;
+  Assign(expected, a);
+  BooleanSet(expected, b, op);
+
+  std::vector<Box2_i> out;
+  int prev_top = -1;
+  bool ordered = true;
+  StreamBooleanSet(a, b, op, [&](const Box2_i& box) {
+    ordered = ordered && box.yh() >= prev_top;
+    prev_top = box.yh();
+    out.push_back(box);
+  });
+
+  EXPECT_TRUE(ordered);
+  EXPECT_TRUE(Equivalence(out, expected));
+  // Non-overlapping.
+  int64_t sum = 0;
+  for (const Box2_i& box : out) sum += box.Area();
+  EXPECT_EQ(sum, Area(expected));
+}
+
+TEST(StreamBooleanSet, RandomUnion) { CheckRandomBooleans(BooleanOp::kUnion); }
+
+TEST(StreamBooleanSet, RandomIntersection) {
+  CheckRandomBooleans(BooleanOp::kIntersection);
+}
+
+TEST(StreamBooleanSet, RandomDisjointUnion) {
+  CheckRandomBooleans(BooleanOp::kDisjointUnion);
+}
+
+TEST(StreamBooleanSet, RandomSubtract) {
+  CheckRandomBooleans(BooleanOp::kSubtract);
+}
+
+// Disjoint boxes with distinct x: the sweep must not be quadratic in the
+// number of distinct x.
+TEST(StreamBooleanSet, ManyBoxes) {
+  constexpr int kBoxesPerSide = 100000;
+  std::vector<Box2_i> a, b;
+  for (int i = 0; i < kBoxesPerSide; ++i) {
+    const int x = 10 * i, y = 100 * (i % 1000);
+    a.emplace_back(x, y, x + 2, y + 50);
+    b.emplace_back(x + 5, y, x + 7, y + 50);
+  }
+  int64_t count = 0, area = 0;
+  StreamBooleanSet(a, b, BooleanOp::kUnion, [&](const Box2_i& box) {
+    ++count;
+    area += box.Area();
+  });
+
+  EXPECT_EQ(count, 2 * kBoxesPerSide);
+  EXPECT_EQ(area, 2 * kBoxesPerSide * 2 * 50);
+}
+
+}  // namespace moab
@@ -0,0 +1,66 @@
+#ifndef MOAB_BOUNDING_BOX_H_
+#define MOAB_BOUNDING_BOX_H_
+
+#include <cstddef>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/point2.h"
+
+namespace moab {
+
+// Returns the bounding box of the points, reduced over contiguous blocks on up
+// to num_threads threads (0 means one thread per hardware thread). Small
+// inputs run on the calling thread only.
+template <typename T>
+Box2<T> BoundingBox(const std::vector<Point2<T>>& points,
+                    std::size_t num_threads = 0) {
+  CHECK(!points.empty()) << "Points container is empty.";
+  std::vector<Box2<T>> partial(NumBlocks(points.size(), num_threads));
+  ParallelForBlocks(points.size(), num_threads,
+                    [&](std::size_t block, std::size_t begin, std::size_t end) {
+                      partial[block] =
+                          Box2<T>::BoundingBox(&points[begin], end - begin);
+                    });
+  Box2<T> box = partial[0];
+  for (const Box2<T>& b : partial) box.Encompass(b);
+  return box;
+}
+
+// Returns the bounding box of every group of a CSR (compressed sparse row)
+// layout: group i holds points[offsets[i], offsets[i + 1]), e.g., the pins of
+// net i. offsets starts at 0, does not decrease and ends at points.size().
+// Empty groups get Box2(). Groups are split into contiguous blocks handled on
+// up to num_threads threads (0 means one thread per hardware thread).
+//
+// One call replaces a BoundingBox call per group, with its container and
+// thread setup.
+template <typename T>
+std::vector<Box2<T>> BoundingBoxes(const std::vector<Point2<T>>& points,
+                                   const std::vector<std::size_t>& offsets,
+                                   std::size_t num_threads = 0) {
+  CHECK(!offsets.empty() && offsets.front() == 0 &&
+        offsets.back() == points.size())
+      << "Offsets must run from 0 to the number of points.";
+  const std::size_t groups = offsets.size() - 1;
+  std::vector<Box2<T>> boxes(groups);
+  constexpr std::size_t kMinGroupsPerBlock = 256;
+  ParallelForBlocks(
+      groups, num_threads,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+          DCHECK(offsets[i] <= offsets[i + 1]);
+          if (offsets[i] == offsets[i + 1]) continue;
+          boxes[i] = Box2<T>::BoundingBox(&points[offsets[i]],
+                                          offsets[i + 1] - offsets[i]);
+        }
+      },
+      kMinGroupsPerBlock);
+  return boxes;
+}
+
+}  // namespace moab
+
+#endif  // MOAB_BOUNDING_BOX_H_
@@ -0,0 +1,86 @@
+#include "bounding_box.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/point2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+std::vector<Point2_i> RandomPoints(std::size_t n, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> pos(-1000000, 1000000);
+  std::vector<Point2_i> points;
+  for (std::size_t i = 0; i < n; ++i) points.emplace_back(pos(gen), pos(gen));
+  return points;
+}
+
+Box2_i NaiveBoundingBox(const std::vector<Point2_i>& points, std::size_t begin,
+                        std::size_t end) {
+  Box2_i box(points[begin], points[begin]);
+  for (std::size_t i = begin; i < end; ++i) box.Encompass(points[i]);
+  return box;
+}
+
+TEST(BoundingBox, Contiguous) {
+  for (std::size_t n : {1, 7, 8, 9, 100}) {
+    const std::vector<Point2_i> points = RandomPoints(n, n);
+
+    EXPECT_EQ(Box2_i::BoundingBox(points), NaiveBoundingBox(points, 0, n));
+    EXPECT_EQ(Box2_i::BoundingBox(points.data(), n),
+              NaiveBoundingBox(points, 0, n));
+  }
+}
+
+TEST(BoundingBox, Parallel) {
+  const std::vector<Point2_i> points = RandomPoints(100000, 41);
+  const Box2_i expected = NaiveBoundingBox(points, 0, points.size());
+
+  EXPECT_EQ(BoundingBox(points, 1), expected);
+  EXPECT_EQ(BoundingBox(points, 4), expected);
+  EXPECT_EQ(BoundingBox(std::vector<Point2_i>{Point2_i(1, 2)}, 4),
+            Box2_i(1, 2, 1, 2));
+}
+
+TEST(BoundingBoxes, Groups) {
+  const std::vector<Point2_i> points = {Point2_i(0, 0), Point2_i(2, 3),
+                                        Point2_i(5, 5), Point2_i(-1, 4),
+                                        Point2_i(3, -2)};
+
+  EXPECT_THAT(BoundingBoxes(points, {0, 2, 2, 5}),
+              ElementsAre(Box2_i(0, 0, 2, 3), Box2_i(), Box2_i(-1, -2, 5, 5)));
+  EXPECT_THAT(BoundingBoxes(points, {0, 5}),
+              ElementsAre(Box2_i(-1, -2, 5, 5)));
+  EXPECT_DEATH(BoundingBoxes(points, {0, 4}), "Offsets must run");
+}
+
+TEST(BoundingBoxes, Parallel) {
+  const std::vector<Point2_i> points = RandomPoints(20000, 42);
+  std::mt19937 gen(43);
+  std::uniform_int_distribution<std::size_t> size(0, 10);
+  std::vector<std::size_t> offsets = {0};
+  while (offsets.back() < points.size()) {
+    offsets.push_back(std::min(points.size(), offsets.back() + size(gen)));
+  }
+  const std::vector<Box2_i> boxes = BoundingBoxes(points, offsets, 4);
+
+  ASSERT_EQ(boxes.size(), offsets.size() - 1);
+  for (std::size_t i = 0; i + 1 < offsets.size(); ++i) {
+    if (offsets[i] == offsets[i + 1]) {
+      EXPECT_EQ(boxes[i], Box2_i());
+    } else {
+      EXPECT_EQ(boxes[i], NaiveBoundingBox(points, offsets[i], offsets[i + 1]));
+    }
+  }
+  EXPECT_EQ(BoundingBoxes(points, offsets, 1), boxes);
+}
+
+}  // namespace moab
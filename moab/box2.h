@@ -1,9 +1,11 @@
 #ifndef MOAB_BOX2_H_
 #define MOAB_BOX2_H_
 
+#include <algorithm>
 #include <array>
 #include <cstdint>
 #include <initializer_list>
+#include <iterator>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -25,6 +27,20 @@ namespace moab {
 
 namespace gtl = boost::polygon;
 
+namespace box2_internal {
+
+// True if Container stores Point2<T> contiguously, e.g., std::vector.
+template <typename Container, typename T, typename = void>
+struct is_contiguous_points : std::false_type {};
+template <typename Container, typename T>
+struct is_contiguous_points<
+    Container, T,
+    std::enable_if_t<std::is_same_v<
+        decltype(std::data(std::declval<const Container&>())),
+        const Point2<T>*>>> : std::true_type {};
+
+}  // namespace box2_internal
+
 template <typename T>
 class Box2 {
  public:
@@ -34,9 +50,13 @@ class Box2 {
   using interval_type = Interval<T>;
 
   // Constructors.
-  Box2() : d_({Point2<T>(0, 0), Point2<T>(0, 0)}) {}
-  explicit Box2(const Point2<T>& p1, const Point2<T>& p2) { Set(p1, p2); }
-  explicit Box2(T xl, T yl, T xh, T yh) { Set(xl, yl, xh, yh); }
+  constexpr Box2() noexcept : d_({Point2<T>(0, 0), Point2<T>(0, 0)}) {}
+  constexpr explicit Box2(const Point2<T>& p1, const Point2<T>& p2) noexcept {
+    Set(p1, p2);
+  }
+  constexpr explicit Box2(T xl, T yl, T xh, T yh) noexcept {
+    Set(xl, yl, xh, yh);
+  }
   explicit Box2(const Box2Proto& proto) { SetFromProto(proto); }
   Box2(const Box2&) = default;
   Box2(Box2&&) = default;
@@ -47,30 +67,30 @@ class Box2 {
   Box2& operator=(Box2&&) = default;
 
   // Accessors.
-  Point2<T>& ll() { return d_[0]; }
-  const Point2<T>& ll() const { return d_[0]; }
-  Point2<T>& ur() { return d_[1]; }
-  const Point2<T>& ur() const { return d_[1]; }
-
-  Point2<T>& MinCorner() { return d_[0]; }
-  const Point2<T>& MinCorner() const { return d_[0]; }
-  Point2<T>& MaxCorner() { return d_[1]; }
-  const Point2<T>& MaxCorner() const { return d_[1]; }
-
-  T xl() const { return d_[0].x(); }
-  T yl() const { return d_[0].y(); }
-  T xh() const { return d_[1].x(); }
-  T yh() const { return d_[1].y(); }
-
-  T MinX() const { return d_[0].x(); }
-  T MinY() const { return d_[0].y(); }
-  T MaxX() const { return d_[1].x(); }
-  T MaxY() const { return d_[1].y(); }
-
-  T Width() const { return d_[1].x() - d_[0].x(); }
-  T Height() const { return d_[1].y() - d_[0].y(); }
-
-  std::tuple<T, T, T, T> ToTuple() const {
+  constexpr Point2<T>& ll() noexcept { return d_[0]; }
+  constexpr const Point2<T>& ll() const noexcept { return d_[0]; }
+  constexpr Point2<T>& ur() noexcept { return d_[1]; }
+  constexpr const Point2<T>& ur() const noexcept { return d_[1]; }
+
+  constexpr Point2<T>& MinCorner() noexcept { return d_[0]; }
+  constexpr const Point2<T>& MinCorner() const noexcept { return d_[0]; }
+  constexpr Point2<T>& MaxCorner() noexcept { return d_[1]; }
+  constexpr const Point2<T>& MaxCorner() const noexcept { return d_[1]; }
+
+  constexpr T xl() const noexcept { return d_[0].x(); }
+  constexpr T yl() const noexcept { return d_[0].y(); }
+  constexpr T xh() const noexcept { return d_[1].x(); }
+  constexpr T yh() const noexcept { return d_[1].y(); }
+
+  constexpr T MinX() const noexcept { return d_[0].x(); }
+  constexpr T MinY() const noexcept { return d_[0].y(); }
+  constexpr T MaxX() const noexcept { return d_[1].x(); }
+  constexpr T MaxY() const noexcept { return d_[1].y(); }
+
+  constexpr T Width() const noexcept { return d_[1].x() - d_[0].x(); }
+  constexpr T Height() const noexcept { return d_[1].y() - d_[0].y(); }
+
+  constexpr std::tuple<T, T, T, T> ToTuple() const noexcept {
     return std::make_tuple(d_[0].x(), d_[0].y(), d_[1].x(), d_[1].y());
   }
 
@@ -83,41 +103,49 @@ class Box2 {
     return p;
   }
 
-  T Area() const { return Width() * Height(); }
-  T HalfPerimeter() const { return (Width() + Height()); }
-  T Perimeter() const { return 2 * (Width() + Height()); }
+  constexpr T Area() const noexcept { return Width() * Height(); }
+  constexpr T HalfPerimeter() const noexcept { return (Width() + Height()); }
+  constexpr T Perimeter() const noexcept { return 2 * (Width() + Height()); }
 
   // Mutators.
-  void Set(T xl, T yl, T xh, T yh) {
+  constexpr void Set(T xl, T yl, T xh, T yh) noexcept {
     // Ensure that the box is valid. Automatically swap if necessary.
     d_[0].Set((xl < xh ? xl : xh), (yl < yh ? yl : yh));
     d_[1].Set((xl < xh ? xh : xl), (yl < yh ? yh : yl));
   }
-  void Set(const Point2<T>& ll, const Point2<T>& ur) {
+  constexpr void Set(const Point2<T>& ll, const Point2<T>& ur) noexcept {
     Set(ll.x(), ll.y(), ur.x(), ur.y());
   }
 
-  void set_xl(T xl) { Set(xl, yl(), xh(), yh()); }
-  void set_yl(T yl) { Set(xl(), yl, xh(), yh()); }
-  void set_xh(T xh) { Set(xl(), yl(), xh, yh()); }
-  void set_yh(T yh) { Set(xl(), yl(), xh(), yh); }
-  void set_ll(const Point2<T>& p) { Set(p.x(), p.y(), xh(), yh()); }
-  void set_ur(const Point2<T>& p) { Set(xl(), yl(), p.x(), p.y()); }
+  constexpr void set_xl(T xl) noexcept { Set(xl, yl(), xh(), yh()); }
+  constexpr void set_yl(T yl) noexcept { Set(xl(), yl, xh(), yh()); }
+  constexpr void set_xh(T xh) noexcept { Set(xl(), yl(), xh, yh()); }
+  constexpr void set_yh(T yh) noexcept { Set(xl(), yl(), xh(), yh); }
+  constexpr void set_ll(const Point2<T>& p) noexcept {
+    Set(p.x(), p.y(), xh(), yh());
+  }
+  constexpr void set_ur(const Point2<T>& p) noexcept {
+    Set(xl(), yl(), p.x(), p.y());
+  }
 
-  void SetMinCorner(const Point2<T>& p) { Set(p.x(), p.y(), xh(), yh()); }
-  void SetMaxCorner(const Point2<T>& p) { Set(xl(), yl(), p.x(), p.y()); }
+  constexpr void SetMinCorner(const Point2<T>& p) noexcept {
+    Set(p.x(), p.y(), xh(), yh());
+  }
+  constexpr void SetMaxCorner(const Point2<T>& p) noexcept {
+    Set(xl(), yl(), p.x(), p.y());
+  }
 
   // Operations.
   // Operations - Shift (It's safe. No need to check for validity.)
-  void Shift(T dx, T dy) {
+  constexpr void Shift(T dx, T dy) noexcept {
     d_[0].Shift(dx, dy);
     d_[1].Shift(dx, dy);
   }
-  void ShiftX(T dx) {
+  constexpr void ShiftX(T dx) noexcept {
     d_[0].ShiftX(dx);
     d_[1].ShiftX(dx);
   }
-  void ShiftY(T dy) {
+  constexpr void ShiftY(T dy) noexcept {
     d_[0].ShiftY(dy);
     d_[1].ShiftY(dy);
   }
@@ -145,27 +173,41 @@ class Box2 {
 
   // Operators.
   // Operators - Subscript
-  Point2<T>& operator[](std::size_t i) { return d_[i]; }
-  const Point2<T>& operator[](std::size_t i) const { return d_.at(i); }
+  constexpr Point2<T>& operator[](std::size_t i) noexcept { return d_[i]; }
+  constexpr const Point2<T>& operator[](std::size_t i) const noexcept {
+    return d_[i];
+  }
   // Operators - Equality
-  bool operator==(const Box2& b) const {
+  constexpr bool operator==(const Box2& b) const noexcept {
     return d_[0] == b.d_[0] && d_[1] == b.d_[1];
   }
-  bool operator!=(const Box2& b) const { return !(*this == b); }
+  constexpr bool operator!=(const Box2& b) const noexcept {
+    return !(*this == b);
+  }
   // Operators - Inequality
-  bool operator<(const Box2& b) const {
+  constexpr bool operator<(const Box2& b) const noexcept {
     return d_[0] != b.d_[0] ? d_[0] < b.d_[0] : d_[1] < b.d_[1];
   }
-  bool operator>(const Box2& b) const { return b < *this; }
-  bool operator<=(const Box2& b) const { return !(*this > b); }
-  bool operator>=(const Box2& b) const { return !(*this < b); }
+  constexpr bool operator>(const Box2& b) const noexcept { return b < *this; }
+  constexpr bool operator<=(const Box2& b) const noexcept {
+    return !(*this > b);
+  }
+  constexpr bool operator>=(const Box2& b) const noexcept {
+    return !(*this < b);
+  }
 
   // Utilities.
+  // Returns the bounding box of the points. Contiguous containers (e.g.,
+  // std::vector, std::array) take the pointer overload below.
   template <typename Container>
   static Box2 BoundingBox(const Container& points);
   static Box2 BoundingBox(std::initializer_list<Point2<T>> points) {
     return BoundingBox<std::initializer_list<Point2<T>>>(points);
   }
+  // Returns the bounding box of points[0, n). Reduces the coordinates with
+  // independent min/max accumulators, which compilers turn into vector
+  // instructions.
+  static Box2 BoundingBox(const Point2<T>* points, std::size_t n);
 
   // String conversion.
   template <typename Sink>
@@ -251,11 +293,52 @@ Box2<T> Box2<T>::BoundingBox(const Container& points) {
   static_assert(std::is_same_v<typename Container::value_type, Point2<T>>,
                 "Container must hold Point2<T> elements.");
   CHECK(points.begin() != points.end()) << "Points container is empty.";
-  Box2<T> box(*points.begin(), *points.begin());
-  for (const Point2<T>& p : points) {
-    box.Encompass(p);
+  if constexpr (box2_internal::is_contiguous_points<Container, T>::value) {
+    return BoundingBox(std::data(points), std::size(points));
+  } else {
+    T xl = points.begin()->x(), yl = points.begin()->y();
+    T xh = xl, yh = yl;
+    for (const Point2<T>& p : points) {
+      xl = std::min(xl, p.x());
+      yl = std::min(yl, p.y());
+      xh = std::max(xh, p.x());
+      yh = std::max(yh, p.y());
+    }
+    return Box2<T>(xl, yl, xh, yh);
+  }
+}
+
+template <typename T>
+Box2<T> Box2<T>::BoundingBox(const Point2<T>* points, std::size_t n) {
+  CHECK(n > 0) << "Points container is empty.";
+  // Eight independent accumulators per bound break the dependency chain
+  // between iterations.
+  constexpr std::size_t kLanes = 8;
+  std::array<T, kLanes> xl, yl, xh, yh;
+  xl.fill(points[0].x());
+  xh.fill(points[0].x());
+  yl.fill(points[0].y());
+  yh.fill(points[0].y());
+  std::size_t i = 0;
+  for (; i + kLanes <= n; i += kLanes) {
+    for (std::size_t k = 0; k < kLanes; ++k) {
+      const T x = points[i + k].x(), y = points[i + k].y();
+      xl[k] = x < xl[k] ? x : xl[k];
+      yl[k] = y < yl[k] ? y : yl[k];
+      xh[k] = x > xh[k] ? x : xh[k];
+      yh[k] = y > yh[k] ? y : yh[k];
+    }
   }
-  return box;
+  for (; i < n; ++i) {
+    xl[0] = std::min(xl[0], points[i].x());
+    yl[0] = std::min(yl[0], points[i].y());
+    xh[0] = std::max(xh[0], points[i].x());
+    yh[0] = std::max(yh[0], points[i].y());
+  }
+  return Box2<T>(*std::min_element(xl.begin(), xl.end()),
+                 *std::min_element(yl.begin(), yl.end()),
+                 *std::max_element(xh.begin(), xh.end()),
+                 *std::max_element(yh.begin(), yh.end()));
 }
 
 // Aliases.
@@ -263,6 +346,12 @@ using Box2_i = Box2<int>;
 using Box2_i32 = Box2<int32_t>;
 using Box2_i64 = Box2<int64_t>;
 
+// Boxes are plain values, so vectors of boxes relocate with memcpy and the
+// Boost predicates inline down to coordinate compares.
+static_assert(std::is_trivially_copyable_v<Box2_i>);
+static_assert(std::is_nothrow_default_constructible_v<Box2_i>);
+static_assert(Box2_i(0, 0, 2, 3).Area() == 6);
+
 }  // namespace moab
 
 // Boost geometry traits.
@@ -0,0 +1,425 @@
+#ifndef MOAB_BOX_ARRAY_H_
+#define MOAB_BOX_ARRAY_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/numeric/bits.h"
+#include "moab/box2.h"
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace moab {
+
+// Predicates of a box against a query box, as in operation.h. Boxes are
+// closed.
+enum class BoxPredicate {
+  kIntersects,  // IsIntersect(box, query)
+  kCoveredBy,   // IsCoveredBy(box, query): the box lies inside the query
+  kCovers,      // IsCoveredBy(query, box): the query lies inside the box
+  kTouches,     // IsTouch(box, query): boundaries meet, interiors do not
+};
+
+namespace box_array_internal {
+
+// Allocates storage aligned to a cache line, so that vector loads of a
+// coordinate array never straddle one at the start.
+template <typename T>
+struct AlignedAllocator {
+  using value_type = T;
+  static constexpr std::align_val_t kAlignment{64};
+
+  AlignedAllocator() = default;
+  template <typename U>
+  AlignedAllocator(const AlignedAllocator<U>&) {}
+
+  T* allocate(std::size_t n) {
+    return static_cast<T*>(::operator new(n * sizeof(T), kAlignment));
+  }
+  void deallocate(T* p, std::size_t) { ::operator delete(p, kAlignment); }
+
+  template <typename U>
+  bool operator==(const AlignedAllocator<U>&) const {
+    return true;
+  }
+  template <typename U>
+  bool operator!=(const AlignedAllocator<U>&) const {
+    return false;
+  }
+};
+
+// Comparison kernels over kWidth coordinates at a time. Gt returns a lane
+// mask, Bits turns it into an integer with bit i set for lane i. The scalar
+// kernel compares one coordinate at a time.
+template <typename T>
+struct ScalarLanes {
+  static constexpr std::size_t kWidth = 1;
+  using Vec = T;
+  using Mask = bool;
+
+  static Vec Load(const T* p) { return *p; }
+  static Vec Broadcast(T v) { return v; }
+  static Mask Gt(Vec a, Vec b) { return a > b; }
+  static Mask And(Mask a, Mask b) { return a & b; }
+  static Mask Or(Mask a, Mask b) { return a | b; }
+  static uint64_t Bits(Mask m) { return m; }
+};
+
+// Vector kernels for signed 32- and 64-bit coordinates, if enabled, and the
+// scalar kernel otherwise.
+template <typename T, typename = void>
+struct Lanes : ScalarLanes<T> {};
+
+template <typename T, std::size_t N>
+using enable_if_signed_t = std::enable_if_t<
+    std::is_integral_v<T> && std::is_signed_v<T> && sizeof(T) == N>;
+
+#if defined(__AVX512F__)
+template <typename T>
+struct Lanes<T, enable_if_signed_t<T, 4>> {
+  static constexpr std::size_t kWidth = 16;
+  using Vec = __m512i;
+  using Mask = __mmask16;
+
+  static Vec Load(const T* p) { return _mm512_loadu_si512(p); }
+  static Vec Broadcast(T v) { return _mm512_set1_epi32(v); }
+  static Mask Gt(Vec a, Vec b) { return _mm512_cmpgt_epi32_mask(a, b); }
+  static Mask And(Mask a, Mask b) { return a & b; }
+  static Mask Or(Mask a, Mask b) { return a | b; }
+  static uint64_t Bits(Mask m) { return m; }
+};
+template <typename T>
+struct Lanes<T, enable_if_signed_t<T, 8>> {
+  static constexpr std::size_t kWidth = 8;
+  using Vec = __m512i;
+  using Mask = __mmask8;
+
+  static Vec Load(const T* p) { return _mm512_loadu_si512(p); }
+  static Vec Broadcast(T v) {
+    return _mm512_set1_epi64(static_cast<long long>(v));
+  }
+  static Mask Gt(Vec a, Vec b) { return _mm512_cmpgt_epi64_mask(a, b); }
+  static Mask And(Mask a, Mask b) { return a & b; }
+  static Mask Or(Mask a, Mask b) { return a | b; }
+  static uint64_t Bits(Mask m) { return m; }
+};
+#elif defined(__AVX2__)
+template <typename T>
+struct Lanes<T, enable_if_signed_t<T, 4>> {
+  static constexpr std::size_t kWidth = 8;
+  using Vec = __m256i;
+  using Mask = __m256i;
+
+  static Vec Load(const T* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static Vec Broadcast(T v) { return _mm256_set1_epi32(v); }
+  static Mask Gt(Vec a, Vec b) { return _mm256_cmpgt_epi32(a, b); }
+  static Mask And(Mask a, Mask b) { return _mm256_and_si256(a, b); }
+  static Mask Or(Mask a, Mask b) { return _mm256_or_si256(a, b); }
+  static uint64_t Bits(Mask m) {
+    return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+  }
+};
+template <typename T>
+struct Lanes<T, enable_if_signed_t<T, 8>> {
+  static constexpr std::size_t kWidth = 4;
+  using Vec = __m256i;
+  using Mask = __m256i;
+
+  static Vec Load(const T* p) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+  }
+  static Vec Broadcast(T v) {
+    return _mm256_set1_epi64x(static_cast<long long>(v));
+  }
+  static Mask Gt(Vec a, Vec b) { return _mm256_cmpgt_epi64(a, b); }
+  static Mask And(Mask a, Mask b) { return _mm256_and_si256(a, b); }
+  static Mask Or(Mask a, Mask b) { return _mm256_or_si256(a, b); }
+  static uint64_t Bits(Mask m) {
+    return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+  }
+};
+#endif
+
+// Returns bit i set if box i of the kWidth boxes at xl, yl, xh, yh satisfies
+// the predicate against the query q = {qxl, qyl, qxh, qyh}.
+template <BoxPredicate P, typename L, typename T>
+uint64_t Match(const T* xl, const T* yl, const T* xh, const T* yh,
+               const typename L::Vec (&q)[4]) {
+  constexpr uint64_t kAll = (uint64_t{1} << L::kWidth) - 1;
+  const typename L::Vec bxl = L::Load(xl), byl = L::Load(yl);
+  const typename L::Vec bxh = L::Load(xh), byh = L::Load(yh);
+  // A closed box misses the query if it lies strictly on one side of it.
+  auto misses = [&] {
+    return L::Bits(L::Or(L::Or(L::Gt(bxl, q[2]), L::Gt(q[0], bxh)),
+                         L::Or(L::Gt(byl, q[3]), L::Gt(q[1], byh))));
+  };
+  if constexpr (P == BoxPredicate::kIntersects) {
+    return ~misses() & kAll;
+  } else if constexpr (P == BoxPredicate::kCoveredBy) {
+    return ~L::Bits(L::Or(L::Or(L::Gt(q[0], bxl), L::Gt(bxh, q[2])),
+                          L::Or(L::Gt(q[1], byl), L::Gt(byh, q[3])))) &
+           kAll;
+  } else if constexpr (P == BoxPredicate::kCovers) {
+    return ~L::Bits(L::Or(L::Or(L::Gt(bxl, q[0]), L::Gt(q[2], bxh)),
+                          L::Or(L::Gt(byl, q[1]), L::Gt(q[3], byh)))) &
+           kAll;
+  } else {
+    // The interiors overlap if the open intervals overlap on both axes.
+    const uint64_t interiors =
+        L::Bits(L::And(L::And(L::Gt(q[2], bxl), L::Gt(bxh, q[0])),
+                       L::And(L::Gt(q[3], byl), L::Gt(byh, q[1]))));
+    return ~(misses() | interiors) & kAll;
+  }
+}
+
+}  // namespace box_array_internal
+
+// Boxes stored as a structure of arrays: xl, yl, xh and yh each in their own
+// cache-line-aligned array. Bulk predicates against one query box compare a
+// whole vector of coordinates per instruction, which a std::vector of Box2
+// (an array of point pairs) does not allow.
+//
+// With AVX-512 (__AVX512F__) or AVX2 (__AVX2__) enabled at compile time,
+// signed 32- and 64-bit integral coordinates use vector kernels; other builds
+// and coordinate types use the equivalent scalar loop.
+//
+// Results come as bitmasks, bit i % 64 of word i / 64 for box i, or as
+// compacted indices in increasing order:
+//
+//   BoxArray_i boxes(leaf_boxes);
+//   std::vector<uint32_t> hits;
+//   boxes.Select(window, BoxPredicate::kIntersects, hits);
+template <typename T>
+class BoxArray {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+  using area_type = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  using array_type =
+      std::vector<T, box_array_internal::AlignedAllocator<T>>;
+
+  // Constructors.
+  BoxArray() = default;
+  explicit BoxArray(const std::vector<Box2<T>>& boxes) {
+    Reserve(boxes.size());
+    for (const Box2<T>& b : boxes) Append(b);
+  }
+  BoxArray(const BoxArray&) = default;
+  BoxArray(BoxArray&&) = default;
+  ~BoxArray() = default;
+
+  // Assignment operators.
+  BoxArray& operator=(const BoxArray&) = default;
+  BoxArray& operator=(BoxArray&&) = default;
+
+  // Accessors.
+  std::size_t Size() const { return xl_.size(); }
+  bool Empty() const { return xl_.empty(); }
+  Box2<T> Get(std::size_t i) const {
+    DCHECK(i < Size());
+    return Box2<T>(xl_[i], yl_[i], xh_[i], yh_[i]);
+  }
+  const array_type& Xl() const { return xl_; }
+  const array_type& Yl() const { return yl_; }
+  const array_type& Xh() const { return xh_; }
+  const array_type& Yh() const { return yh_; }
+  std::vector<Box2<T>> ToBoxes() const {
+    std::vector<Box2<T>> boxes;
+    boxes.reserve(Size());
+    for (std::size_t i = 0; i < Size(); ++i) boxes.push_back(Get(i));
+    return boxes;
+  }
+
+  // Mutators.
+  void Append(const Box2<T>& b) {
+    xl_.push_back(b.xl());
+    yl_.push_back(b.yl());
+    xh_.push_back(b.xh());
+    yh_.push_back(b.yh());
+  }
+  void Set(std::size_t i, const Box2<T>& b) {
+    DCHECK(i < Size());
+    xl_[i] = b.xl();
+    yl_[i] = b.yl();
+    xh_[i] = b.xh();
+    yh_[i] = b.yh();
+  }
+  void Reserve(std::size_t n) {
+    xl_.reserve(n);
+    yl_.reserve(n);
+    xh_.reserve(n);
+    yh_.reserve(n);
+  }
+  void Clear() {
+    xl_.clear();
+    yl_.clear();
+    xh_.clear();
+    yh_.clear();
+  }
+
+  // Operations.
+  // Writes the boxes that satisfy pred against query as a bitmask of
+  // (Size() + 63) / 64 words. The bits past Size() are zero.
+  void Mask(const Box2<T>& query, BoxPredicate pred,
+            std::vector<uint64_t>& out) const;
+  std::vector<uint64_t> Mask(const Box2<T>& query, BoxPredicate pred) const {
+    std::vector<uint64_t> out;
+    Mask(query, pred, out);
+    return out;
+  }
+  // Writes the indices of the boxes that satisfy pred against query, in
+  // increasing order. out is overwritten and its capacity reused. Returns the
+  // number of indices.
+  std::size_t Select(const Box2<T>& query, BoxPredicate pred,
+                     std::vector<uint32_t>& out) const;
+  // Returns the number of boxes that satisfy pred against query.
+  std::size_t Count(const Box2<T>& query, BoxPredicate pred) const;
+  // Writes the area of every box.
+  void Areas(std::vector<area_type>& out) const;
+  // Returns the sum of the box areas. Overlaps are counted once per box.
+  area_type TotalArea() const;
+
+  // Operators.
+  // Operator - Equality
+  bool operator==(const BoxArray& a) const {
+    return xl_ == a.xl_ && yl_ == a.yl_ && xh_ == a.xh_ && yh_ == a.yh_;
+  }
+  bool operator!=(const BoxArray& a) const { return !(*this == a); }
+
+ private:
+  // Calls visit(word, bits) for every 64 boxes, bit i of word w for box
+  // 64 * w + i.
+  template <BoxPredicate P, typename Visit>
+  void ForEachWord(const Box2<T>& query, Visit&& visit) const;
+  template <typename Visit>
+  void Dispatch(const Box2<T>& query, BoxPredicate pred, Visit&& visit) const;
+
+  array_type xl_;
+  array_type yl_;
+  array_type xh_;
+  array_type yh_;
+};
+
+template <typename T>
+template <BoxPredicate P, typename Visit>
+void BoxArray<T>::ForEachWord(const Box2<T>& query, Visit&& visit) const {
+  using Vector = box_array_internal::Lanes<T>;
+  using Scalar = box_array_internal::ScalarLanes<T>;
+  static_assert(64 % Vector::kWidth == 0, "Lanes must divide a word.");
+  const typename Vector::Vec vq[4] = {
+      Vector::Broadcast(query.xl()), Vector::Broadcast(query.yl()),
+      Vector::Broadcast(query.xh()), Vector::Broadcast(query.yh())};
+  const typename Scalar::Vec sq[4] = {query.xl(), query.yl(), query.xh(),
+                                      query.yh()};
+  const std::size_t n = Size();
+  const T* xl = xl_.data();
+  const T* yl = yl_.data();
+  const T* xh = xh_.data();
+  const T* yh = yh_.data();
+  for (std::size_t begin = 0; begin < n; begin += 64) {
+    const std::size_t end = std::min(begin + 64, n);
+    uint64_t bits = 0;
+    std::size_t i = begin;
+    for (; i + Vector::kWidth <= end; i += Vector::kWidth) {
+      bits |= box_array_internal::Match<P, Vector>(xl + i, yl + i, xh + i,
+                                                   yh + i, vq)
+              << (i - begin);
+    }
+    for (; i < end; ++i) {
+      bits |= box_array_internal::Match<P, Scalar>(xl + i, yl + i, xh + i,
+                                                   yh + i, sq)
+              << (i - begin);
+    }
+    visit(begin / 64, bits);
+  }
+}
+
+template <typename T>
+template <typename Visit>
+void BoxArray<T>::Dispatch(const Box2<T>& query, BoxPredicate pred,
+                           Visit&& visit) const {
+  switch (pred) {
+    case BoxPredicate::kIntersects:
+      ForEachWord<BoxPredicate::kIntersects>(query, visit);
+      break;
+    case BoxPredicate::kCoveredBy:
+      ForEachWord<BoxPredicate::kCoveredBy>(query, visit);
+      break;
+    case BoxPredicate::kCovers:
+      ForEachWord<BoxPredicate::kCovers>(query, visit);
+      break;
+    case BoxPredicate::kTouches:
+      ForEachWord<BoxPredicate::kTouches>(query, visit);
+      break;
+  }
+}
+
+template <typename T>
+void BoxArray<T>::Mask(const Box2<T>& query, BoxPredicate pred,
+                       std::vector<uint64_t>& out) const {
+  out.resize((Size() + 63) / 64);
+  Dispatch(query, pred,
+           [&out](std::size_t word, uint64_t bits) { out[word] = bits; });
+}
+
+template <typename T>
+std::size_t BoxArray<T>::Select(const Box2<T>& query, BoxPredicate pred,
+                                std::vector<uint32_t>& out) const {
+  CHECK(Size() <= UINT32_MAX) << "Too many boxes for 32-bit indices.";
+  out.clear();
+  Dispatch(query, pred, [&out](std::size_t word, uint64_t bits) {
+    for (; bits != 0; bits &= bits - 1) {
+      out.push_back(static_cast<uint32_t>(64 * word + absl::countr_zero(bits)));
+    }
+  });
+  return out.size();
+}
+
+template <typename T>
+std::size_t BoxArray<T>::Count(const Box2<T>& query,
+                               BoxPredicate pred) const {
+  std::size_t count = 0;
+  Dispatch(query, pred, [&count](std::size_t, uint64_t bits) {
+    count += absl::popcount(bits);
+  });
+  return count;
+}
+
+template <typename T>
+void BoxArray<T>::Areas(std::vector<area_type>& out) const {
+  out.resize(Size());
+  // Independent iterations over contiguous arrays; compilers vectorize this
+  // loop for the enabled instruction set.
+  for (std::size_t i = 0; i < Size(); ++i) {
+    out[i] = static_cast<area_type>(xh_[i] - xl_[i]) *
+             static_cast<area_type>(yh_[i] - yl_[i]);
+  }
+}
+
+template <typename T>
+typename BoxArray<T>::area_type BoxArray<T>::TotalArea() const {
+  area_type total = 0;
+  for (std::size_t i = 0; i < Size(); ++i) {
+    total += static_cast<area_type>(xh_[i] - xl_[i]) *
+             static_cast<area_type>(yh_[i] - yl_[i]);
+  }
+  return total;
+}
+
+// Aliases.
+using BoxArray_i = BoxArray<int>;
+using BoxArray_i32 = BoxArray<int32_t>;
+using BoxArray_i64 = BoxArray<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_BOX_ARRAY_H_
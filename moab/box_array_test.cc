@@ -0,0 +1,140 @@
+#include "box_array.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+template <typename T>
+std::vector<Box2<T>> RandomBoxes(int n, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> pos(0, 100);
+  std::uniform_int_distribution<int> size(1, 30);
+  std::vector<Box2<T>> boxes;
+  for (int i = 0; i < n; ++i) {
+    T x = pos(gen), y = pos(gen);
+    boxes.emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+  return boxes;
+}
+
+// Checks every predicate against the matching function of operation.h.
+template <typename T>
+void CheckPredicates(const std::vector<Box2<T>>& boxes,
+                     const std::vector<Box2<T>>& queries) {
+  const BoxArray<T> array(boxes);
+  std::vector<uint32_t> indices;
+  for (const Box2<T>& q : queries) {
+    for (BoxPredicate pred :
+         {BoxPredicate::kIntersects, BoxPredicate::kCoveredBy,
+          BoxPredicate::kCovers, BoxPredicate::kTouches}) {
+      std::vector<uint32_t> expected;
+      for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const Box2<T>& b = boxes[i];
+        bool match = false;
+        switch (pred) {
+          case BoxPredicate::kIntersects:
+            match = IsIntersect(b, q);
+            break;
+          case BoxPredicate::kCoveredBy:
+            match = IsCoveredBy(b, q);
+            break;
+          case BoxPredicate::kCovers:
+            match = IsCoveredBy(q, b);
+            break;
+          case BoxPredicate::kTouches:
+            match = IsTouch(b, q);
+            break;
+        }
+        if (match) expected.push_back(static_cast<uint32_t>(i));
+      }
+      const std::vector<uint64_t> mask = array.Mask(q, pred);
+
+      EXPECT_EQ(array.Select(q, pred, indices), expected.size());
+      EXPECT_EQ(indices, expected);
+      EXPECT_EQ(array.Count(q, pred), expected.size());
+      ASSERT_EQ(mask.size(), (boxes.size() + 63) / 64);
+      for (std::size_t i = 0; i < boxes.size(); ++i) {
+        const bool bit = (mask[i / 64] >> (i % 64)) & 1;
+        EXPECT_EQ(bit, std::count(expected.begin(), expected.end(), i) == 1);
+      }
+    }
+  }
+}
+
+TEST(Constructor, Boxes) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 1, 2, 3), Box2_i(4, 5, 6, 7)};
+  BoxArray_i array(boxes);
+
+  EXPECT_EQ(array.Size(), 2);
+  EXPECT_FALSE(array.Empty());
+  EXPECT_EQ(array.Get(1), Box2_i(4, 5, 6, 7));
+  EXPECT_THAT(array.Xl(), ElementsAre(0, 4));
+  EXPECT_THAT(array.Yh(), ElementsAre(3, 7));
+  EXPECT_EQ(array.ToBoxes(), boxes);
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(array.Xl().data()) % 64, 0);
+}
+
+TEST(Mutators, AppendSetClear) {
+  BoxArray_i array;
+  array.Append(Box2_i(0, 0, 1, 1));
+  array.Append(Box2_i(0, 0, 2, 2));
+  array.Set(0, Box2_i(1, 1, 3, 3));
+
+  EXPECT_EQ(array, BoxArray_i({Box2_i(1, 1, 3, 3), Box2_i(0, 0, 2, 2)}));
+
+  array.Clear();
+
+  EXPECT_TRUE(array.Empty());
+  EXPECT_TRUE(array.Mask(Box2_i(0, 0, 1, 1), BoxPredicate::kIntersects)
+                  .empty());
+}
+
+TEST(Operations, Predicates) {
+  BoxArray_i array({Box2_i(0, 0, 10, 10), Box2_i(10, 0, 20, 10),
+                    Box2_i(2, 2, 4, 4), Box2_i(-5, -5, 15, 15),
+                    Box2_i(30, 30, 40, 40)});
+  const Box2_i q(0, 0, 10, 10);
+  std::vector<uint32_t> out;
+
+  array.Select(q, BoxPredicate::kIntersects, out);
+  EXPECT_THAT(out, ElementsAre(0, 1, 2, 3));
+  array.Select(q, BoxPredicate::kCoveredBy, out);
+  EXPECT_THAT(out, ElementsAre(0, 2));
+  array.Select(q, BoxPredicate::kCovers, out);
+  EXPECT_THAT(out, ElementsAre(0, 3));
+  array.Select(q, BoxPredicate::kTouches, out);
+  EXPECT_THAT(out, ElementsAre(1));
+  EXPECT_THAT(array.Mask(q, BoxPredicate::kIntersects), ElementsAre(0b1111));
+}
+
+TEST(Operations, MatchesOperations) {
+  // Sizes that leave partial vectors and partial words.
+  for (int n : {1, 7, 64, 203}) {
+    CheckPredicates(RandomBoxes<int>(n, n), RandomBoxes<int>(20, n + 1));
+    CheckPredicates(RandomBoxes<int64_t>(n, n),
+                    RandomBoxes<int64_t>(20, n + 1));
+    CheckPredicates(RandomBoxes<double>(n, n), RandomBoxes<double>(20, n + 1));
+  }
+}
+
+TEST(Operations, Areas) {
+  BoxArray_i array({Box2_i(0, 0, 2, 3), Box2_i(0, 0, 50000, 50000)});
+  std::vector<int64_t> areas;
+  array.Areas(areas);
+
+  EXPECT_THAT(areas, ElementsAre(6, 2500000000));
+  EXPECT_EQ(array.TotalArea(), 2500000006);
+}
+
+}  // namespace moab
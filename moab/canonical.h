@@ -0,0 +1,213 @@
+#ifndef MOAB_CANONICAL_H_
+#define MOAB_CANONICAL_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "moab/box2.h"
+#include "moab/decomposition.h"
+#include "moab/point2.h"
+#include "moab/rectilinear_grid.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+// A 128-bit hash value.
+struct Hash128 {
+  uint64_t lo = 0;
+  uint64_t hi = 0;
+
+  bool operator==(const Hash128& h) const { return lo == h.lo && hi == h.hi; }
+  bool operator!=(const Hash128& h) const { return !(*this == h); }
+
+  // String conversion.
+  template <typename Sink>
+  friend void AbslStringify(Sink& sink, const Hash128& h) {
+    absl::Format(&sink, "%016x%016x", h.hi, h.lo);
+  }
+  std::string ToString() const { return absl::StrCat(*this); }
+  friend std::ostream& operator<<(std::ostream& os, const Hash128& h) {
+    os << h.ToString();
+    return os;
+  }
+};
+
+// A stable 128-bit hash over a sequence of 64-bit words (MurmurHash3 x64 128
+// with seed 0). Unlike absl::Hash, the value does not change between runs or
+// builds, so it can be stored and compared across processes.
+class StableHasher {
+ public:
+  void Add(uint64_t word) {
+    if (count_++ % 2 == 0) {
+      pending_ = word;
+      return;
+    }
+    Mix(pending_, word);
+  }
+  void Add(int64_t word) { Add(static_cast<uint64_t>(word)); }
+
+  Hash128 Finish() const {
+    uint64_t h1 = h1_, h2 = h2_;
+    if (count_ % 2 == 1) {
+      h1 ^= Rotl(pending_ * kC1, 31) * kC2;
+    }
+    h1 ^= count_;
+    h2 ^= count_;
+    h1 += h2;
+    h2 += h1;
+    h1 = Fmix(h1);
+    h2 = Fmix(h2);
+    h1 += h2;
+    h2 += h1;
+    return {h1, h2};
+  }
+
+ private:
+  static constexpr uint64_t kC1 = 0x87c37b91114253d5ULL;
+  static constexpr uint64_t kC2 = 0x4cf5ad432745937fULL;
+
+  static uint64_t Rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
+  static uint64_t Fmix(uint64_t k) {
+    k ^= k >> 33;
+    k *= 0xff51afd7ed558ccdULL;
+    k ^= k >> 33;
+    k *= 0xc4ceb9fe1a85ec53ULL;
+    k ^= k >> 33;
+    return k;
+  }
+  void Mix(uint64_t k1, uint64_t k2) {
+    h1_ ^= Rotl(k1 * kC1, 31) * kC2;
+    h1_ = Rotl(h1_, 27) + h2_;
+    h1_ = h1_ * 5 + 0x52dce729;
+    h2_ ^= Rotl(k2 * kC2, 33) * kC1;
+    h2_ = Rotl(h2_, 31) + h1_;
+    h2_ = h2_ * 5 + 0x38495ab5;
+  }
+
+  uint64_t h1_ = 0;
+  uint64_t h2_ = 0;
+  uint64_t pending_ = 0;
+  uint64_t count_ = 0;
+};
+
+// Returns the canonical form of a rectilinear Box2, ring or polygon with
+// holes, or polygon set (e.g., a std::vector of Box2, Ring2 or Polygon2): the
+// horizontal slab decomposition, sorted. Sets that cover the same area have
+// the same canonical form, no matter how they are split into shapes. Built by
+// a scanline over the edges (see HorizontalSlabs), in O(n log n) for n edges.
+template <typename Geometry>
+std::vector<Box2<coordinate_of_t<Geometry>>> CanonicalBoxes(
+    const Geometry& g) {
+  using T = coordinate_of_t<Geometry>;
+  std::vector<Box2<T>> boxes = Decompose(g, DecompositionMode::kHorizontal);
+  std::sort(boxes.begin(), boxes.end());
+  return boxes;
+}
+
+// Returns the stable hash of a ring's canonical form (see Ring2::Canonical).
+template <typename T>
+Hash128 CanonicalHash(const Ring2<T>& r) {
+  StableHasher hasher;
+  const Ring2<T> c = r.Canonical();
+  hasher.Add(static_cast<uint64_t>(c.Size()));
+  for (const Point2<T>& p : c) {
+    hasher.Add(static_cast<int64_t>(p.x()));
+    hasher.Add(static_cast<int64_t>(p.y()));
+  }
+  return hasher.Finish();
+}
+
+// Returns the stable hash of a set of canonical boxes (see CanonicalBoxes).
+template <typename T>
+Hash128 CanonicalHash(const std::vector<Box2<T>>& canonical_boxes) {
+  StableHasher hasher;
+  hasher.Add(static_cast<uint64_t>(canonical_boxes.size()));
+  for (const Box2<T>& b : canonical_boxes) {
+    hasher.Add(static_cast<int64_t>(b.xl()));
+    hasher.Add(static_cast<int64_t>(b.yl()));
+    hasher.Add(static_cast<int64_t>(b.xh()));
+    hasher.Add(static_cast<int64_t>(b.yh()));
+  }
+  return hasher.Finish();
+}
+
+// Returns the stable hash of the area covered by a rectilinear geometry (see
+// CanonicalBoxes). Sets that cover the same area have the same hash.
+template <typename Geometry>
+Hash128 CanonicalSetHash(const Geometry& g) {
+  return CanonicalHash(CanonicalBoxes(g));
+}
+
+// Polygon set equivalence for rectilinear geometries, decided by comparing
+// the canonical forms in O(n log n) for n edges instead of running a full
+// boolean.
+template <typename Geometry1, typename Geometry2>
+bool CanonicalEquivalence(const Geometry1& lhs, const Geometry2& rhs) {
+  return CanonicalBoxes(lhs) == CanonicalBoxes(rhs);
+}
+
+// A rectilinear polygon set stored in canonical form together with its stable
+// hash. Comparing two CanonicalSets rejects different sets in O(1) by hash
+// and confirms equal sets in O(n); the boxes are only compared when the hashes
+// match.
+template <typename T>
+class CanonicalSet {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // Constructors.
+  CanonicalSet() : hash_(CanonicalHash(boxes_)) {}
+  CanonicalSet(const CanonicalSet&) = default;
+  CanonicalSet(CanonicalSet&&) = default;
+  ~CanonicalSet() = default;
+
+  // Assignment operators.
+  CanonicalSet& operator=(const CanonicalSet&) = default;
+  CanonicalSet& operator=(CanonicalSet&&) = default;
+
+  // Builds the set from a rectilinear geometry (see CanonicalBoxes).
+  template <typename Geometry>
+  static CanonicalSet FromGeometry(const Geometry& g) {
+    CanonicalSet s;
+    s.boxes_ = CanonicalBoxes(g);
+    s.hash_ = CanonicalHash(s.boxes_);
+    return s;
+  }
+
+  // Accessors.
+  const std::vector<Box2<T>>& Boxes() const { return boxes_; }
+  const Hash128& Hash() const { return hash_; }
+  bool Empty() const { return boxes_.empty(); }
+
+  // Operators.
+  // Operator - Equality
+  bool operator==(const CanonicalSet& s) const {
+    return hash_ == s.hash_ && boxes_ == s.boxes_;
+  }
+  bool operator!=(const CanonicalSet& s) const { return !(*this == s); }
+
+  // Hash.
+  template <typename H>
+  friend H AbslHashValue(H h, const CanonicalSet& s) {
+    return H::combine(std::move(h), s.hash_.lo, s.hash_.hi);
+  }
+
+ private:
+  std::vector<Box2<T>> boxes_;
+  Hash128 hash_;
+};
+
+// Aliases.
+using CanonicalSet_i = CanonicalSet<int>;
+using CanonicalSet_i32 = CanonicalSet<int32_t>;
+using CanonicalSet_i64 = CanonicalSet<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_CANONICAL_H_
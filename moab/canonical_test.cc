@@ -0,0 +1,152 @@
+#include "canonical.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "absl/hash/hash_testing.h"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/polygon2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+TEST(StableHasher, IsStable) {
+  StableHasher hasher;
+  hasher.Add(int64_t{1});
+  hasher.Add(int64_t{-2});
+  hasher.Add(uint64_t{3});
+
+  // Fixed value: the hash must not change between runs or builds.
+  EXPECT_EQ(hasher.Finish().lo, 0x0cd9e434e14a4d44ULL);
+  EXPECT_EQ(hasher.Finish().hi, 0xd6b0526473da8843ULL);
+}
+
+TEST(StableHasher, OrderMatters) {
+  StableHasher a, b;
+  a.Add(int64_t{1});
+  a.Add(int64_t{2});
+  b.Add(int64_t{2});
+  b.Add(int64_t{1});
+
+  EXPECT_NE(a.Finish(), b.Finish());
+}
+
+TEST(CanonicalBoxes, IndependentOfSplit) {
+  std::vector<Box2_i> a = {Box2_i(0, 0, 10, 10)};
+  std::vector<Box2_i> b = {Box2_i(5, 0, 10, 10), Box2_i(0, 0, 5, 4),
+                           Box2_i(0, 3, 6, 10)};
+
+  EXPECT_THAT(CanonicalBoxes(a), ElementsAre(Box2_i(0, 0, 10, 10)));
+  EXPECT_THAT(CanonicalBoxes(b), ElementsAre(Box2_i(0, 0, 10, 10)));
+}
+
+TEST(CanonicalHash, Ring) {
+  Ring2_i r1 = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+                Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+                Point2_i(0, 0)};
+  // Same ring, clockwise from another start point.
+  Ring2_i r2 = {Point2_i(20, 40), Point2_i(40, 40), Point2_i(40, 0),
+                Point2_i(0, 0),   Point2_i(0, 20),  Point2_i(20, 20),
+                Point2_i(20, 40)};
+  Ring2_i r3(Box2_i(0, 0, 40, 40));
+
+  EXPECT_EQ(CanonicalHash(r1), CanonicalHash(r2));
+  EXPECT_NE(CanonicalHash(r1), CanonicalHash(r3));
+}
+
+TEST(CanonicalSetHash, EqualAreaEqualHash) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 40, 20), Box2_i(20, 0, 40, 40)};
+
+  EXPECT_EQ(CanonicalSetHash(r), CanonicalSetHash(boxes));
+  EXPECT_NE(CanonicalSetHash(r), CanonicalSetHash(Box2_i(0, 0, 40, 40)));
+}
+
+TEST(CanonicalEquivalence, MatchesEquivalence) {
+  std::mt19937 gen(30);
+  std::uniform_int_distribution<int> pos(0, 50);
+  std::uniform_int_distribution<int> size(1, 30);
+  for (int t = 0; t < 100; ++t) {
+    std::vector<Box2_i> a, b;
+    for (int i = 0; i < 4; ++i) {
+      int x = pos(gen), y = pos(gen);
+      Box2_i box(x, y, x + size(gen), y + size(gen));
+      a.push_back(box);
+      // b covers the same area split into two halves, except sometimes.
+      int mid = x + (box.Width() + 1) / 2;
+      b.push_back(Box2_i(x, y, mid, box.yh()));
+      b.push_back(Box2_i(mid, y, box.xh(), box.yh() - (t % 3 == 0)));
+    }
+
+    EXPECT_EQ(CanonicalEquivalence(a, b), Equivalence(a, b));
+    EXPECT_EQ(CanonicalSetHash(a) == CanonicalSetHash(b), Equivalence(a, b));
+  }
+}
+
+TEST(CanonicalEquivalence, RingSet) {
+  // An L-shape split into two rings of opposite orientations.
+  std::vector<Ring2_i> rings = {
+      Ring2_i(Box2_i(0, 0, 40, 20)),
+      Ring2_i({Point2_i(20, 20), Point2_i(20, 40), Point2_i(40, 40),
+               Point2_i(40, 20), Point2_i(20, 20)})};
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 20, 20), Box2_i(20, 0, 40, 40)};
+
+  EXPECT_THAT(CanonicalBoxes(rings),
+              ElementsAre(Box2_i(0, 0, 40, 20), Box2_i(20, 20, 40, 40)));
+  EXPECT_TRUE(CanonicalEquivalence(rings, boxes));
+  EXPECT_EQ(CanonicalSetHash(rings), CanonicalSetHash(boxes));
+  EXPECT_FALSE(CanonicalEquivalence(rings, Box2_i(0, 0, 40, 40)));
+}
+
+TEST(CanonicalEquivalence, PolygonSet) {
+  std::vector<Polygon2_i> polygons = {
+      Polygon2_i(Ring2_i(Box2_i(0, 0, 30, 30)),
+                 {Ring2_i(Box2_i(10, 10, 20, 20))})};
+  std::vector<Box2_i> frame = {Box2_i(0, 0, 30, 10), Box2_i(0, 20, 30, 30),
+                               Box2_i(0, 0, 10, 30), Box2_i(20, 0, 30, 30)};
+
+  EXPECT_THAT(CanonicalBoxes(polygons),
+              ElementsAre(Box2_i(0, 0, 30, 10), Box2_i(0, 10, 10, 20),
+                          Box2_i(0, 20, 30, 30), Box2_i(20, 10, 30, 20)));
+  EXPECT_TRUE(CanonicalEquivalence(polygons, frame));
+  EXPECT_EQ(CanonicalSet_i::FromGeometry(polygons),
+            CanonicalSet_i::FromGeometry(frame));
+  EXPECT_FALSE(CanonicalEquivalence(polygons, Box2_i(0, 0, 30, 30)));
+}
+
+TEST(CanonicalSetHash, ManyShapes) {
+  // Diagonal boxes have a distinct x and y each, the worst case for a grid.
+  std::vector<Box2_i> boxes;
+  std::vector<Ring2_i> rings;
+  for (int i = 0; i < 100000; ++i) {
+    boxes.push_back(Box2_i(i * 10, i * 10, i * 10 + 15, i * 10 + 5));
+    rings.push_back(Ring2_i(boxes.back()));
+  }
+
+  EXPECT_EQ(CanonicalBoxes(boxes).size(), 100000);
+  EXPECT_EQ(CanonicalSetHash(boxes), CanonicalSetHash(rings));
+}
+
+TEST(CanonicalSet, Equality) {
+  CanonicalSet_i a = CanonicalSet_i::FromGeometry(
+      std::vector<Box2_i>{Box2_i(0, 0, 10, 10), Box2_i(10, 0, 20, 10)});
+  CanonicalSet_i b = CanonicalSet_i::FromGeometry(Box2_i(0, 0, 20, 10));
+  CanonicalSet_i c = CanonicalSet_i::FromGeometry(Box2_i(0, 0, 20, 11));
+
+  EXPECT_EQ(a, b);
+  EXPECT_EQ(a.Hash(), b.Hash());
+  EXPECT_NE(a, c);
+  EXPECT_TRUE(CanonicalSet_i().Empty());
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({a, b, c}));
+}
+
+}  // namespace moab
@@ -0,0 +1,158 @@
+#ifndef MOAB_CLIP_H_
+#define MOAB_CLIP_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+namespace clip_internal {
+
+// Clips a closed polygon, given without its closing point, against one side
+// of the window (Sutherland-Hodgman). side: 0 = left, 1 = right, 2 = bottom,
+// 3 = top. In and Out are contiguous containers of Point2<T>.
+template <typename T, typename In, typename Out>
+void ClipSide(const In& in, const Box2<T>& window, int side, Out& out) {
+  out.clear();
+  if (in.empty()) return;
+  auto inside = [&](const Point2<T>& p) {
+    switch (side) {
+      case 0:
+        return p.x() >= window.xl();
+      case 1:
+        return p.x() <= window.xh();
+      case 2:
+        return p.y() >= window.yl();
+      default:
+        return p.y() <= window.yh();
+    }
+  };
+  // Returns the point where p -> q crosses the side.
+  auto cross = [&](const Point2<T>& p, const Point2<T>& q) {
+    const bool vertical_side = side < 2;
+    const T c = side == 0   ? window.xl()
+                : side == 1 ? window.xh()
+                : side == 2 ? window.yl()
+                            : window.yh();
+    const double p0 = vertical_side ? p.x() : p.y();
+    const double q0 = vertical_side ? q.x() : q.y();
+    const double p1 = vertical_side ? p.y() : p.x();
+    const double q1 = vertical_side ? q.y() : q.x();
+    // Rectilinear edges cross at an exact coordinate.
+    T t = static_cast<T>(p1);
+    if (p1 != q1) {
+      const double v = p1 + (q1 - p1) * (c - p0) / (q0 - p0);
+      t = std::is_integral_v<T> ? static_cast<T>(std::llround(v))
+                                : static_cast<T>(v);
+    }
+    return vertical_side ? Point2<T>(c, t) : Point2<T>(t, c);
+  };
+  const Point2<T>* prev = &in.back();
+  bool prev_in = inside(*prev);
+  for (const Point2<T>& p : in) {
+    const bool p_in = inside(p);
+    if (p_in != prev_in) out.push_back(cross(*prev, p));
+    if (p_in) out.push_back(p);
+    prev = &p;
+    prev_in = p_in;
+  }
+}
+
+}  // namespace clip_internal
+
+// Clips each box to a window on its own: out receives the non-empty
+// intersections, in input order. out is overwritten and its capacity reused;
+// it may be boxes itself. Returns the number of output boxes.
+//
+// The result covers the same area as IntersectionSet with the window (they
+// pass Equivalence), without its sorting and scanline pass. It is not the same
+// set of boxes: overlapping input boxes stay overlapping. Use IntersectionSet
+// when non-overlapping output is needed.
+template <typename T>
+std::size_t ClipEachToBox(const std::vector<Box2<T>>& boxes,
+                          const Box2<T>& window, std::vector<Box2<T>>& out) {
+  out.resize(boxes.size());
+  std::size_t n = 0;
+  // Every box is written; the write position only advances past non-empty
+  // ones, so the loop has no data-dependent branches.
+  for (const Box2<T>& b : boxes) {
+    const T xl = std::max(b.xl(), window.xl());
+    const T yl = std::max(b.yl(), window.yl());
+    const T xh = std::min(b.xh(), window.xh());
+    const T yh = std::min(b.yh(), window.yh());
+    const bool keep = (xl < xh) & (yl < yh);
+    out[n] = Box2<T>(xl, yl, std::max(xl, xh), std::max(yl, yh));
+    n += keep;
+  }
+  out.resize(n);
+  return n;
+}
+
+// Clips a ring to a window edge by edge in time linear in the number of
+// points (Sutherland-Hodgman). out receives a closed ring, or an empty ring if
+// nothing is left; it may be ring itself. scratch is working space; both
+// buffers keep their capacity across calls.
+//
+// out is always a single ring. When the intersection has several parts (a
+// concave ring), they are joined by zero-width bridges along the window
+// border, so out is only weakly simple: it covers the same area as
+// IntersectionSet with the window (they pass Equivalence), but is not the same
+// set of separate rings. Use IntersectionSet when the parts are needed apart.
+// Crossings of non-rectilinear edges are rounded to the nearest integer for
+// integral T.
+template <typename T>
+void ClipToBox(const Ring2<T>& ring, const Box2<T>& window, Ring2<T>& out,
+               std::vector<Point2<T>>& scratch) {
+  out.UpdatePoints([&](auto& pts) {
+    if (&ring != &out) pts.assign(ring.begin(), ring.end());
+    if (pts.size() > 1 && pts.front() == pts.back()) pts.pop_back();
+    // The points go back and forth between the two buffers and end in pts.
+    for (int side = 0; side < 4; side += 2) {
+      clip_internal::ClipSide(pts, window, side, scratch);
+      clip_internal::ClipSide(scratch, window, side + 1, pts);
+    }
+    // Drops repeated points.
+    pts.erase(std::unique(pts.begin(), pts.end()), pts.end());
+    while (pts.size() > 1 && pts.front() == pts.back()) pts.pop_back();
+  });
+  if (out.Size() < 3 || out.Area() == 0) {
+    out.Clear();
+    return;
+  }
+  out.Append(out[0]);
+}
+template <typename T>
+void ClipToBox(const Ring2<T>& ring, const Box2<T>& window, Ring2<T>& out) {
+  std::vector<Point2<T>> scratch;
+  ClipToBox(ring, window, out, scratch);
+}
+
+// Clips each ring to a window on its own (see ClipToBox above). out receives
+// the non-empty clipped rings, in input order, and keeps the capacity of its
+// rings across calls; it may be rings itself. Returns the number of output
+// rings. As with the boxes, the result passes Equivalence with
+// IntersectionSet, but overlapping rings stay overlapping.
+template <typename T>
+std::size_t ClipEachToBox(const std::vector<Ring2<T>>& rings,
+                          const Box2<T>& window, std::vector<Ring2<T>>& out) {
+  std::vector<Point2<T>> scratch;
+  if (out.size() < rings.size()) out.resize(rings.size());
+  std::size_t n = 0;
+  for (const Ring2<T>& r : rings) {
+    ClipToBox(r, window, out[n], scratch);
+    n += !out[n].Empty();
+  }
+  out.resize(n);
+  return n;
+}
+
+}  // namespace moab
+
+#endif  // MOAB_CLIP_H_
@@ -0,0 +1,174 @@
+#include "clip.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+TEST(ClipEachToBox, Boxes) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 10, 10), Box2_i(20, 20, 30, 30),
+                               Box2_i(5, 5, 25, 8), Box2_i(15, 0, 20, 5)};
+  std::vector<Box2_i> out = {Box2_i(1, 1, 2, 2)};
+
+  EXPECT_EQ(ClipEachToBox(boxes, Box2_i(5, 0, 15, 10), out), 2);
+  // Box2_i(15, 0, 20, 5) only touches the window.
+  EXPECT_THAT(out, ElementsAre(Box2_i(5, 0, 10, 10), Box2_i(5, 5, 15, 8)));
+}
+
+TEST(ClipEachToBox, OverlappingBoxes) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 20, 20), Box2_i(10, 10, 30, 30)};
+  Box2_i window(5, 5, 25, 25);
+  std::vector<Box2_i> expected = boxes;
+  IntersectionSet(expected, window);
+
+  EXPECT_EQ(ClipEachToBox(boxes, window, boxes), 2);
+  // Clipped in place, and still overlapping.
+  EXPECT_THAT(boxes, ElementsAre(Box2_i(5, 5, 20, 20), Box2_i(10, 10, 25, 25)));
+  EXPECT_NE(boxes, expected);
+  EXPECT_TRUE(Equivalence(boxes, expected));
+}
+
+TEST(ClipEachToBox, RandomBoxes) {
+  std::mt19937 gen(38);
+  std::uniform_int_distribution<int> pos(0, 500);
+  std::uniform_int_distribution<int> size(1, 100);
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < 300; ++i) {
+    int x = pos(gen), y = pos(gen);
+    boxes.emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+  std::vector<Box2_i> out;
+  for (int i = 0; i < 20; ++i) {
+    int x = pos(gen), y = pos(gen);
+    Box2_i window(x, y, x + 2 * size(gen), y + 2 * size(gen));
+    ClipEachToBox(boxes, window, out);
+    std::vector<Box2_i> expected;
+    Assign(expected, boxes);
+    IntersectionSet(expected, window);
+
+    EXPECT_TRUE(Equivalence(out, expected)) << "window: " << window;
+  }
+}
+
+TEST(ClipToBox, RingInsideAndOutside) {
+  Ring2_i r(Box2_i(10, 10, 20, 20));
+  Ring2_i out;
+
+  ClipToBox(r, Box2_i(0, 0, 100, 100), out);
+
+  EXPECT_EQ(out, r);
+
+  ClipToBox(r, Box2_i(30, 30, 40, 40), out);
+
+  EXPECT_TRUE(out.Empty());
+
+  // Shares an edge only.
+  ClipToBox(r, Box2_i(20, 0, 40, 40), out);
+
+  EXPECT_TRUE(out.Empty());
+}
+
+TEST(ClipToBox, Ring) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(30, 0), Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(0, 10),
+               Point2_i(0, 0)};
+  Ring2_i out;
+  ClipToBox(r, Box2_i(10, 5, 25, 20), out);
+
+  EXPECT_THAT(out.Points(),
+              ElementsAre(Point2_i(10, 5), Point2_i(25, 5), Point2_i(25, 20),
+                          Point2_i(20, 20), Point2_i(20, 10), Point2_i(10, 10),
+                          Point2_i(10, 5)));
+}
+
+TEST(ClipToBox, ConcaveRingSplits) {
+  // A U shape; the window cuts off its bottom, leaving two arms.
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(30, 0),  Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(10, 10),
+               Point2_i(10, 30), Point2_i(0, 30),  Point2_i(0, 0)};
+  Box2_i window(0, 15, 30, 30);
+  Ring2_i out;
+  ClipToBox(r, window, out);
+  std::vector<Ring2_i> expected = {r};
+  IntersectionSet(expected, window);
+
+  // One ring with a bridge, against the two separate arms of IntersectionSet.
+  EXPECT_EQ(expected.size(), 2);
+  EXPECT_EQ(out.Area(), 300);
+  EXPECT_TRUE(Equivalence(std::vector<Ring2_i>{out}, expected));
+}
+
+TEST(ClipToBox, InPlace) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(30, 0), Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(0, 10),
+               Point2_i(0, 0)};
+  Ring2_i expected;
+  ClipToBox(r, Box2_i(10, 5, 25, 20), expected);
+  ClipToBox(r, Box2_i(10, 5, 25, 20), r);
+
+  EXPECT_EQ(r, expected);
+}
+
+TEST(ClipToBox, Triangle) {
+  Ring2_i r = {Point2_i(0, 0), Point2_i(20, 0), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  Ring2_i out;
+  ClipToBox(r, Box2_i(0, 0, 10, 10), out);
+
+  EXPECT_EQ(out.Area(), 100);
+
+  ClipToBox(r, Box2_i(5, 0, 30, 30), out);
+
+  EXPECT_EQ(out.Area(), 15 * 15 / 2);
+}
+
+TEST(ClipEachToBox, Rings) {
+  std::vector<Ring2_i> rings = {Ring2_i(Box2_i(0, 0, 10, 10)),
+                                Ring2_i(Box2_i(50, 50, 60, 60)),
+                                Ring2_i(Box2_i(5, 5, 15, 15))};
+  std::vector<Ring2_i> out;
+
+  EXPECT_EQ(ClipEachToBox(rings, Box2_i(0, 0, 12, 12), out), 2);
+  EXPECT_THAT(out, ElementsAre(Ring2_i(Box2_i(0, 0, 10, 10)),
+                               Ring2_i(Box2_i(5, 5, 12, 12))));
+
+  EXPECT_EQ(ClipEachToBox(rings, Box2_i(100, 100, 120, 120), out), 0);
+  EXPECT_THAT(out, IsEmpty());
+}
+
+TEST(ClipEachToBox, RandomRectilinearRings) {
+  std::mt19937 gen(381);
+  std::uniform_int_distribution<int> pos(0, 100);
+  std::uniform_int_distribution<int> size(1, 40);
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < 30; ++i) {
+    int x = pos(gen), y = pos(gen);
+    boxes.emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+  // Keyholed rings of the union, some of them concave.
+  std::vector<Ring2_i> rings;
+  Assign(rings, boxes);
+  std::vector<Ring2_i> out;
+  for (int i = 0; i < 20; ++i) {
+    int x = pos(gen), y = pos(gen);
+    Box2_i window(x, y, x + size(gen), y + size(gen));
+    ClipEachToBox(rings, window, out);
+    std::vector<Ring2_i> expected = rings;
+    IntersectionSet(expected, window);
+
+    EXPECT_TRUE(Equivalence(out, expected)) << "window: " << window;
+  }
+}
+
+}  // namespace moab
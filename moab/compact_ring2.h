@@ -0,0 +1,322 @@
+#ifndef MOAB_COMPACT_RING2_H_
+#define MOAB_COMPACT_RING2_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "boost/geometry.hpp"
+#include "boost/iterator/iterator_facade.hpp"
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+namespace gtl = boost::polygon;
+
+// A rectilinear ring stored as its unique coordinates only: x0, y0, x1, y1,
+// ... for the vertices (x0, y0), (x1, y0), (x1, y1), (x2, y1), ...,
+// (x0, y[n/2 - 1]). A ring of n vertices takes n coordinates, where Ring2
+// takes 2 * (n + 1) for the same ring (both coordinates of every vertex, plus
+// the closing point).
+//
+// The ring is kept counterclockwise, without repeated or collinear vertices,
+// starting at the lowest vertex (by x, then y) whose outgoing edge is
+// horizontal. It is registered with Boost.Polygon as polygon_90_concept, with
+// a known winding, and with Boost.Geometry as an open counterclockwise ring
+// whose points are produced on the fly by a random access iterator.
+template <typename T>
+class CompactRing2 {
+ public:
+  class PointIterator;
+
+  // Type aliases. (Required by Boost geometry/polygon traits.)
+  using coordinate_type = T;
+  using point_type = Point2<T>;
+  using compact_iterator_type = typename std::vector<T>::const_iterator;
+  using const_iterator_type = PointIterator;
+
+  // Constructors.
+  CompactRing2() = default;
+  // Builds the ring from the points of a rectilinear Ring2. Rings without
+  // area become empty.
+  explicit CompactRing2(const Ring2<T>& r) { SetPoints(r.Points()); }
+  explicit CompactRing2(const Box2<T>& b) {
+    if (b.Width() > 0 && b.Height() > 0) {
+      d_ = {b.xl(), b.yl(), b.xh(), b.yh()};
+    }
+  }
+  CompactRing2(const CompactRing2&) = default;
+  CompactRing2(CompactRing2&&) = default;
+  ~CompactRing2() = default;
+
+  // Assignment operators.
+  CompactRing2& operator=(const CompactRing2&) = default;
+  CompactRing2& operator=(CompactRing2&&) = default;
+
+  // Iterators.
+  PointIterator begin() const { return PointIterator(&d_, 0); }
+  PointIterator end() const { return PointIterator(&d_, d_.size()); }
+  compact_iterator_type begin_compact() const { return d_.begin(); }
+  compact_iterator_type end_compact() const { return d_.end(); }
+
+  // Accessors.
+  // Returns the unique coordinates.
+  const std::vector<T>& Coordinates() const { return d_; }
+  // Returns the number of vertices.
+  std::size_t Size() const { return d_.size(); }
+  // Required by Boost.Polygon.
+  std::size_t size() const { return d_.size(); }
+  bool Empty() const { return d_.empty(); }
+  // Returns vertex i.
+  Point2<T> Vertex(std::size_t i) const {
+    DCHECK(i < d_.size());
+    return Point2<T>(d_[((i + 1) / 2 * 2) % d_.size()], d_[i / 2 * 2 + 1]);
+  }
+  T Area() const { return gtl::area(*this); }
+  Box2<T> BoundingBox() const {
+    CHECK(!d_.empty()) << "Ring is empty.";
+    T xl = d_[0], xh = d_[0], yl = d_[1], yh = d_[1];
+    for (std::size_t i = 0; i < d_.size(); i += 2) {
+      xl = std::min(xl, d_[i]);
+      xh = std::max(xh, d_[i]);
+      yl = std::min(yl, d_[i + 1]);
+      yh = std::max(yh, d_[i + 1]);
+    }
+    return Box2<T>(xl, yl, xh, yh);
+  }
+  // Returns the ring as a closed, counterclockwise Ring2.
+  Ring2<T> ToRing2() const {
+    std::vector<Point2<T>> points(begin(), end());
+    if (!points.empty()) points.push_back(points.front());
+    return Ring2<T>(std::move(points));
+  }
+
+  // Mutators.
+  void Clear() { d_.clear(); }
+  // Sets the ring from the vertices of a rectilinear ring, closed or open, in
+  // either orientation, given as a range of Point2<T>. Rings without area
+  // become empty.
+  template <typename Points>
+  void SetPoints(const Points& points);
+  // Sets the ring from unique coordinates starting with an x, as produced by
+  // Boost.Polygon.
+  template <typename InputIt>
+  void SetCompact(InputIt first, InputIt last) {
+    d_.clear();
+    for (; first != last; ++first) d_.push_back(*first);
+    CHECK(d_.size() % 2 == 0) << "Compact coordinates must come in pairs.";
+    SetPoints(std::vector<Point2<T>>(begin(), end()));
+  }
+
+  // Operators.
+  // Operators - Equality
+  bool operator==(const CompactRing2& r) const { return d_ == r.d_; }
+  bool operator!=(const CompactRing2& r) const { return !(*this == r); }
+
+  // String conversion.
+  template <typename Sink>
+  friend void AbslStringify(Sink& sink, const CompactRing2& r) {
+    const std::vector<Point2<T>> points(r.begin(), r.end());
+    absl::Format(&sink, "(%s)", absl::StrJoin(points, " "));
+  }
+  std::string ToString() const { return absl::StrCat(*this); }
+  friend std::ostream& operator<<(std::ostream& os, const CompactRing2& r) {
+    os << r.ToString();
+    return os;
+  }
+
+  // Hash.
+  template <typename H>
+  friend H AbslHashValue(H h, const CompactRing2& r) {
+    return H::combine(std::move(h), r.d_);
+  }
+
+ private:
+  std::vector<T> d_;
+};
+
+// Random access iterator over the vertices, computed from the coordinates.
+template <typename T>
+class CompactRing2<T>::PointIterator
+    : public boost::iterator_facade<PointIterator, Point2<T>,
+                                    boost::random_access_traversal_tag,
+                                    Point2<T>> {
+ public:
+  PointIterator() = default;
+  explicit PointIterator(const std::vector<T>* d, std::size_t i)
+      : d_(d), i_(i) {}
+
+ private:
+  friend class boost::iterator_core_access;
+
+  Point2<T> dereference() const {
+    const std::vector<T>& d = *d_;
+    return Point2<T>(d[((i_ + 1) / 2 * 2) % d.size()], d[i_ / 2 * 2 + 1]);
+  }
+  bool equal(const PointIterator& it) const { return i_ == it.i_; }
+  void increment() { ++i_; }
+  void decrement() { --i_; }
+  void advance(std::ptrdiff_t n) { i_ += n; }
+  std::ptrdiff_t distance_to(const PointIterator& it) const {
+    return static_cast<std::ptrdiff_t>(it.i_) -
+           static_cast<std::ptrdiff_t>(i_);
+  }
+
+  const std::vector<T>* d_ = nullptr;
+  std::size_t i_ = 0;
+};
+
+template <typename T>
+template <typename Points>
+void CompactRing2<T>::SetPoints(const Points& points) {
+  // Drops repeated and collinear vertices, including the closing point.
+  std::vector<Point2<T>> pts;
+  pts.reserve(points.size());
+  auto collinear = [](const Point2<T>& a, const Point2<T>& b,
+                      const Point2<T>& c) {
+    return (a.x() == b.x() && b.x() == c.x()) ||
+           (a.y() == b.y() && b.y() == c.y());
+  };
+  for (const Point2<T>& p : points) {
+    if (!pts.empty() && pts.back() == p) continue;
+    while (pts.size() >= 2 && collinear(pts[pts.size() - 2], pts.back(), p)) {
+      pts.pop_back();
+    }
+    pts.push_back(p);
+  }
+  while (pts.size() >= 3) {
+    const std::size_t n = pts.size();
+    if (pts[n - 1] == pts[0] || collinear(pts[n - 2], pts[n - 1], pts[0])) {
+      pts.pop_back();
+    } else if (collinear(pts[n - 1], pts[0], pts[1])) {
+      pts.erase(pts.begin());
+    } else {
+      break;
+    }
+  }
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  W area2 = 0;
+  for (std::size_t i = 0; i < pts.size(); ++i) {
+    const Point2<T>& p = pts[i];
+    const Point2<T>& q = pts[(i + 1) % pts.size()];
+    CHECK(p.x() == q.x() || p.y() == q.y())
+        << "Ring is not rectilinear: " << p << " " << q;
+    area2 += static_cast<W>(p.x()) * q.y() - static_cast<W>(q.x()) * p.y();
+  }
+  d_.clear();
+  if (pts.size() < 4 || area2 == 0) return;
+  if (area2 < 0) std::reverse(pts.begin(), pts.end());
+  // Starts at the lowest vertex whose outgoing edge is horizontal. Edges
+  // alternate, so these are every other vertex.
+  std::size_t start = pts[0].y() == pts[1].y() ? 0 : 1;
+  for (std::size_t i = start + 2; i < pts.size(); i += 2) {
+    if (pts[i] < pts[start]) start = i;
+  }
+  std::rotate(pts.begin(), pts.begin() + start, pts.end());
+  d_.reserve(pts.size());
+  for (std::size_t i = 0; i < pts.size(); i += 2) {
+    d_.push_back(pts[i].x());
+    d_.push_back(pts[i].y());
+  }
+}
+
+// Aliases.
+using CompactRing2_i = CompactRing2<int>;
+using CompactRing2_i32 = CompactRing2<int32_t>;
+using CompactRing2_i64 = CompactRing2<int64_t>;
+
+}  // namespace moab
+
+// Boost geometry traits.
+namespace boost::geometry::traits {
+
+template <typename T>
+struct tag<moab::CompactRing2<T>> {
+  using type = ring_tag;
+};
+
+template <typename T>
+struct point_order<moab::CompactRing2<T>> {
+  static const order_selector value = counterclockwise;
+};
+
+template <typename T>
+struct closure<moab::CompactRing2<T>> {
+  static const closure_selector value = open;
+};
+
+}  // namespace boost::geometry::traits
+
+// Boost range traits.
+namespace boost {
+
+template <typename T>
+struct range_mutable_iterator<moab::CompactRing2<T>> {
+  using type = typename moab::CompactRing2<T>::const_iterator_type;
+};
+
+template <typename T>
+struct range_const_iterator<moab::CompactRing2<T>> {
+  using type = typename moab::CompactRing2<T>::const_iterator_type;
+};
+
+}  // namespace boost
+
+// Boost polygon traits.
+namespace boost::polygon {
+
+template <typename T>
+struct geometry_concept<moab::CompactRing2<T>> {
+  using type = polygon_90_concept;
+};
+
+template <typename T>
+struct polygon_90_traits<moab::CompactRing2<T>> {
+  using coordinate_type = T;
+  using compact_iterator_type =
+      typename moab::CompactRing2<T>::compact_iterator_type;
+
+  static inline compact_iterator_type begin_compact(
+      const moab::CompactRing2<T>& r) {
+    return r.begin_compact();
+  }
+  static inline compact_iterator_type end_compact(
+      const moab::CompactRing2<T>& r) {
+    return r.end_compact();
+  }
+  static inline std::size_t size(const moab::CompactRing2<T>& r) {
+    return r.Size();
+  }
+  // Rings are kept counterclockwise, so Boost skips its winding pass.
+  static inline winding_direction winding(const moab::CompactRing2<T>&) {
+    return counterclockwise_winding;
+  }
+};
+
+template <typename T>
+struct polygon_90_mutable_traits<moab::CompactRing2<T>> {
+  template <typename iT>
+  static inline moab::CompactRing2<T>& set_compact(moab::CompactRing2<T>& r,
+                                                   iT input_begin,
+                                                   iT input_end) {
+    r.SetCompact(input_begin, input_end);
+    return r;
+  }
+};
+
+}  // namespace boost::polygon
+
+#endif  // MOAB_COMPACT_RING2_H_
@@ -0,0 +1,97 @@
+#include "compact_ring2.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "absl/hash/hash_testing.h"
+#include "absl/strings/str_format.h"
+#include "boost/geometry.hpp"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+// An L shape, clockwise, starting with a vertical edge, with a collinear
+// vertex on the bottom edge.
+Ring2_i LShape() {
+  return Ring2_i({Point2_i(40, 0), Point2_i(20, 0), Point2_i(0, 0),
+                  Point2_i(0, 20), Point2_i(20, 20), Point2_i(20, 40),
+                  Point2_i(40, 40), Point2_i(40, 0)});
+}
+
+TEST(Constructor, Ring) {
+  CompactRing2_i r(LShape());
+
+  EXPECT_THAT(r.Coordinates(), ElementsAre(0, 0, 40, 40, 20, 20));
+  EXPECT_EQ(r.Size(), 6);
+  EXPECT_THAT(std::vector<Point2_i>(r.begin(), r.end()),
+              ElementsAre(Point2_i(0, 0), Point2_i(40, 0), Point2_i(40, 40),
+                          Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20)));
+  EXPECT_EQ(r.Vertex(5), Point2_i(0, 20));
+  EXPECT_EQ(r.Area(), 1200);
+  EXPECT_EQ(r.BoundingBox(), Box2_i(0, 0, 40, 40));
+  EXPECT_TRUE(Equivalence(std::vector<Ring2_i>{r.ToRing2()},
+                          std::vector<Ring2_i>{LShape()}));
+}
+
+TEST(Constructor, Box) {
+  CompactRing2_i r(Box2_i(1, 2, 3, 4));
+
+  EXPECT_THAT(r.Coordinates(), ElementsAre(1, 2, 3, 4));
+  EXPECT_EQ(r, CompactRing2_i(Ring2_i(Box2_i(1, 2, 3, 4))));
+  EXPECT_TRUE(CompactRing2_i(Box2_i(1, 2, 1, 4)).Empty());
+  EXPECT_TRUE(CompactRing2_i(Ring2_i()).Empty());
+}
+
+TEST(Constructor, NotRectilinear) {
+  EXPECT_DEATH(CompactRing2_i(Ring2_i({Point2_i(0, 0), Point2_i(2, 0),
+                                       Point2_i(0, 2), Point2_i(0, 0)})),
+               "not rectilinear");
+}
+
+TEST(Traits, BoostGeometry) {
+  CompactRing2_i r(LShape());
+
+  EXPECT_EQ(boost::geometry::area(r), 1200);
+  EXPECT_TRUE(boost::geometry::within(Point2_i(10, 10), r));
+  EXPECT_FALSE(boost::geometry::within(Point2_i(10, 30), r));
+  Box2_i envelope;
+  boost::geometry::envelope(r, envelope);
+  EXPECT_EQ(envelope, Box2_i(0, 0, 40, 40));
+}
+
+TEST(Traits, BoostPolygon) {
+  std::vector<CompactRing2_i> rings = {CompactRing2_i(LShape())};
+  UnionSet(rings, Box2_i(0, 20, 20, 40));
+
+  EXPECT_THAT(rings, ElementsAre(CompactRing2_i(Box2_i(0, 0, 40, 40))));
+
+  SubtractSet(rings, Box2_i(10, 10, 30, 30));
+  EXPECT_EQ(Area(rings), 1200);
+
+  std::vector<Box2_i> boxes;
+  Assign(boxes, rings);
+  EXPECT_TRUE(Equivalence(boxes, rings));
+}
+
+TEST(StringConversion, SupportsAbslStringify) {
+  EXPECT_EQ(absl::StrFormat("%v", CompactRing2_i(Box2_i(0, 0, 1, 2))),
+            "((0 0) (1 0) (1 2) (0 2))");
+}
+
+TEST(Hash, SupportsAbslHash) {
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      CompactRing2_i(),
+      CompactRing2_i(Box2_i(0, 0, 1, 1)),
+      CompactRing2_i(Box2_i(0, 0, 1, 2)),
+      CompactRing2_i(LShape()),
+  }));
+}
+
+}  // namespace moab
@@ -0,0 +1,288 @@
+#ifndef MOAB_CONNECTED_COMPONENTS_H_
+#define MOAB_CONNECTED_COMPONENTS_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include <set>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "boost/geometry.hpp"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/parallel.h"
+#include "moab/point2.h"
+#include "moab/rtree.h"
+
+namespace moab {
+
+namespace bg = boost::geometry;
+
+// When two shapes are considered connected.
+enum class TouchSemantics {
+  // The shapes share interior area.
+  kOverlap,
+  // The shapes share area or a boundary segment of positive length.
+  kEdge,
+  // The shapes share at least one point, e.g., only a corner.
+  kCorner,
+};
+
+// A via-style connectivity rule: shapes on via_layer connect the shapes on
+// lower_layer and upper_layer that they are connected to. Shapes on the same
+// layer always connect to each other.
+struct ViaRule {
+  int via_layer;
+  int lower_layer;
+  int upper_layer;
+};
+
+// Disjoint sets over the integers [0, n) with path halving and union by
+// index (the smaller root becomes the parent).
+class UnionFind {
+ public:
+  // Constructors.
+  UnionFind() = default;
+  explicit UnionFind(std::size_t n) : parent_(n) {
+    std::iota(parent_.begin(), parent_.end(), 0);
+  }
+  UnionFind(const UnionFind&) = default;
+  UnionFind(UnionFind&&) = default;
+  ~UnionFind() = default;
+
+  // Assignment operators.
+  UnionFind& operator=(const UnionFind&) = default;
+  UnionFind& operator=(UnionFind&&) = default;
+
+  // Accessors.
+  std::size_t Size() const { return parent_.size(); }
+
+  // Returns the representative of the set containing x.
+  std::size_t Find(std::size_t x) {
+    DCHECK(x < parent_.size()) << "Invalid element. x: " << x;
+    while (parent_[x] != x) x = parent_[x] = parent_[parent_[x]];
+    return x;
+  }
+
+  // Mutators.
+  // Merges the sets containing x and y. Returns true if they were disjoint.
+  bool Union(std::size_t x, std::size_t y) {
+    x = Find(x);
+    y = Find(y);
+    if (x == y) return false;
+    if (x < y) std::swap(x, y);
+    parent_[x] = y;
+    return true;
+  }
+  // Merges every set of other into this. Both must have the same size.
+  void Merge(UnionFind& other) {
+    CHECK(other.Size() == Size()) << "Size mismatch.";
+    for (std::size_t x = 0; x < Size(); ++x) {
+      if (other.parent_[x] != x) Union(x, other.Find(x));
+    }
+  }
+
+  // Returns the dense component id of every element. Ids are numbered in the
+  // order of the first element of each component.
+  std::vector<std::size_t> Components() {
+    std::vector<std::size_t> ids(Size());
+    std::vector<std::size_t> root_id(Size(), Size());
+    std::size_t next = 0;
+    for (std::size_t x = 0; x < Size(); ++x) {
+      const std::size_t r = Find(x);
+      if (root_id[r] == Size()) root_id[r] = next++;
+      ids[x] = root_id[r];
+    }
+    return ids;
+  }
+
+ private:
+  std::vector<std::size_t> parent_;
+};
+
+namespace connected_components_internal {
+
+// Returns true if segments (a0, a1) and (b0, b1) are collinear and overlap in
+// a segment of positive length.
+template <typename T>
+bool SharesSegment(const Point2<T>& a0, const Point2<T>& a1,
+                   const Point2<T>& b0, const Point2<T>& b1) {
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  const W dx = static_cast<W>(a1.x()) - a0.x();
+  const W dy = static_cast<W>(a1.y()) - a0.y();
+  auto cross = [&](const Point2<T>& p) {
+    return dx * (static_cast<W>(p.y()) - a0.y()) -
+           dy * (static_cast<W>(p.x()) - a0.x());
+  };
+  if ((dx == 0 && dy == 0) || cross(b0) != 0 || cross(b1) != 0) return false;
+  // Project onto the segment direction.
+  auto dot = [&](const Point2<T>& p) {
+    return dx * (static_cast<W>(p.x()) - a0.x()) +
+           dy * (static_cast<W>(p.y()) - a0.y());
+  };
+  const W len = dx * dx + dy * dy;
+  const W lo = std::min(dot(b0), dot(b1));
+  const W hi = std::max(dot(b0), dot(b1));
+  return std::min(hi, len) > std::max(lo, W(0));
+}
+
+// Returns true if two closed rings share a boundary segment of positive
+// length.
+template <typename Ring>
+bool SharesEdge(const Ring& r1, const Ring& r2) {
+  for (std::size_t i = 0; i + 1 < r1.Size(); ++i) {
+    for (std::size_t j = 0; j + 1 < r2.Size(); ++j) {
+      if (SharesSegment(r1[i], r1[i + 1], r2[j], r2[j + 1])) return true;
+    }
+  }
+  return false;
+}
+
+// Returns true if g1 and g2 (with bounding boxes b1 and b2) are connected.
+template <typename Geometry, typename T>
+bool IsConnected(const Geometry& g1, const Box2<T>& b1, const Geometry& g2,
+                 const Box2<T>& b2, TouchSemantics semantics) {
+  // Extent of the bounding box intersection; negative if disjoint.
+  const T dx = std::min(b1.xh(), b2.xh()) - std::max(b1.xl(), b2.xl());
+  const T dy = std::min(b1.yh(), b2.yh()) - std::max(b1.yl(), b2.yl());
+  if (dx < 0 || dy < 0) return false;
+  if constexpr (std::is_same_v<Geometry, Box2<T>>) {
+    switch (semantics) {
+      case TouchSemantics::kOverlap:
+        return dx > 0 && dy > 0;
+      case TouchSemantics::kEdge:
+        return dx > 0 || dy > 0;
+      case TouchSemantics::kCorner:
+        return true;
+    }
+    return false;
+  } else {
+    switch (semantics) {
+      case TouchSemantics::kOverlap:
+        return IsStrictlyIntersect(g1, g2);
+      case TouchSemantics::kEdge:
+        return IsStrictlyIntersect(g1, g2) || SharesEdge(g1, g2);
+      case TouchSemantics::kCorner:
+        return IsIntersect(g1, g2);
+    }
+    return false;
+  }
+}
+
+}  // namespace connected_components_internal
+
+// Groups shapes into connected components.
+//
+// Candidate pairs come from an R-tree over the bounding boxes, so each shape
+// is only compared with the shapes whose box meets its own in both x and y.
+// Shapes are sorted by their left x and split into blocks of that order, each
+// processed on its own thread. A block unions its pairs in a private
+// UnionFind over only its own shapes and the later shapes they touch, and
+// hands back the spanning forest as an edge list; the edge lists are then
+// unioned into the result. Memory stays O(n) plus the pairs of the largest
+// block, whatever the number of threads.
+//
+// Geometry is Box2 or a closed ring such as Ring2. layers[i] is the layer of
+// shapes[i]; shapes on different layers only connect through a ViaRule.
+template <typename Range>
+std::vector<std::size_t> ConnectedComponents(
+    const Range& shapes, const std::vector<int>& layers,
+    const std::vector<ViaRule>& rules,
+    TouchSemantics semantics = TouchSemantics::kCorner,
+    std::size_t num_threads = 0) {
+  using Geometry = typename Range::value_type;
+  using T = typename Geometry::coordinate_type;
+  using Edge = std::pair<std::size_t, std::size_t>;
+  namespace internal = connected_components_internal;
+  const std::size_t n = shapes.size();
+  CHECK(layers.empty() || layers.size() == n)
+      << "Layer count mismatch. shapes: " << n << ", layers: " << layers.size();
+  if (n == 0) return {};
+
+  // Layer pairs that connect, stored with the smaller layer first.
+  std::set<std::pair<int, int>> links;
+  for (const ViaRule& r : rules) {
+    links.emplace(std::minmax(r.via_layer, r.lower_layer));
+    links.emplace(std::minmax(r.via_layer, r.upper_layer));
+  }
+  auto layers_connect = [&](std::size_t i, std::size_t j) {
+    if (layers.empty() || layers[i] == layers[j]) return true;
+    return links.count(std::minmax(layers[i], layers[j])) > 0;
+  };
+
+  std::vector<Box2<T>> boxes(n);
+  for (std::size_t i = 0; i < n; ++i) {
+    if constexpr (std::is_same_v<Geometry, Box2<T>>) {
+      boxes[i] = shapes[i];
+    } else {
+      bg::envelope(shapes[i], boxes[i]);
+    }
+  }
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), 0);
+  std::sort(order.begin(), order.end(), [&boxes](std::size_t a, std::size_t b) {
+    return boxes[a].xl() < boxes[b].xl();
+  });
+  // Bounding boxes keyed by their rank in the sorted order.
+  std::vector<std::pair<Box2<T>, std::size_t>> ranked(n);
+  for (std::size_t k = 0; k < n; ++k) ranked[k] = {boxes[order[k]], k};
+  const Rtree<std::pair<Box2<T>, std::size_t>> tree(ranked);
+
+  constexpr std::size_t kMinBlock = 1024;
+  const std::size_t blocks = NumBlocks(n, num_threads, kMinBlock);
+  std::vector<std::vector<Edge>> forests(blocks);
+  ParallelForBlocks(n, num_threads, [&](std::size_t block, std::size_t begin,
+                                        std::size_t end) {
+    // The shapes of the block take the local ids [0, end - begin); later
+    // shapes that they connect to take the following ids.
+    std::vector<std::size_t> global(end - begin);
+    for (std::size_t k = begin; k < end; ++k) global[k - begin] = order[k];
+    absl::flat_hash_map<std::size_t, std::size_t> boundary;
+    auto local = [&](std::size_t m) {
+      if (m < end) return m - begin;
+      auto [it, inserted] = boundary.try_emplace(m, global.size());
+      if (inserted) global.push_back(order[m]);
+      return it->second;
+    };
+    std::vector<Edge> pairs;
+    for (std::size_t k = begin; k < end; ++k) {
+      const std::size_t i = order[k];
+      for (std::size_t m : tree.template QueryIntersects<1>(boxes[i])) {
+        if (m <= k) continue;
+        const std::size_t j = order[m];
+        if (!layers_connect(i, j)) continue;
+        if (internal::IsConnected(shapes[i], boxes[i], shapes[j], boxes[j],
+                                  semantics)) {
+          pairs.emplace_back(k - begin, local(m));
+        }
+      }
+    }
+    UnionFind uf(global.size());
+    for (const auto& [a, b] : pairs) uf.Union(a, b);
+    for (std::size_t x = 0; x < uf.Size(); ++x) {
+      const std::size_t r = uf.Find(x);
+      if (r != x) forests[block].emplace_back(global[x], global[r]);
+    }
+  }, kMinBlock);
+  UnionFind result(n);
+  for (const std::vector<Edge>& forest : forests) {
+    for (const auto& [a, b] : forest) result.Union(a, b);
+  }
+  return result.Components();
+}
+
+// Groups shapes on a single layer into connected components.
+template <typename Range>
+std::vector<std::size_t> ConnectedComponents(
+    const Range& shapes, TouchSemantics semantics = TouchSemantics::kCorner,
+    std::size_t num_threads = 0) {
+  return ConnectedComponents(shapes, {}, {}, semantics, num_threads);
+}
+
+}  // namespace moab
+
+#endif  // MOAB_CONNECTED_COMPONENTS_H_
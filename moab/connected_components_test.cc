@@ -0,0 +1,148 @@
+#include "connected_components.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+TEST(UnionFind, Union) {
+  UnionFind uf(5);
+
+  EXPECT_TRUE(uf.Union(3, 1));
+  EXPECT_TRUE(uf.Union(4, 3));
+  EXPECT_FALSE(uf.Union(1, 4));
+  EXPECT_EQ(uf.Find(4), 1);
+  EXPECT_THAT(uf.Components(), ElementsAre(0, 1, 2, 1, 1));
+}
+
+TEST(UnionFind, Merge) {
+  UnionFind a(4);
+  UnionFind b(4);
+  a.Union(0, 1);
+  b.Union(1, 2);
+  a.Merge(b);
+
+  EXPECT_THAT(a.Components(), ElementsAre(0, 0, 0, 1));
+}
+
+TEST(ConnectedComponents, Empty) {
+  EXPECT_THAT(ConnectedComponents(std::vector<Box2_i>()), ElementsAre());
+}
+
+TEST(ConnectedComponents, TouchSemantics) {
+  std::vector<Box2_i> boxes = {
+      Box2_i(0, 0, 10, 10),    // 0
+      Box2_i(5, 5, 15, 15),    // 1: overlaps 0.
+      Box2_i(15, 0, 20, 10),   // 2: shares an edge with 1.
+      Box2_i(20, 10, 30, 20),  // 3: shares a corner with 2.
+      Box2_i(50, 50, 60, 60),  // 4: isolated.
+  };
+
+  EXPECT_THAT(ConnectedComponents(boxes, TouchSemantics::kOverlap),
+              ElementsAre(0, 0, 1, 2, 3));
+  EXPECT_THAT(ConnectedComponents(boxes, TouchSemantics::kEdge),
+              ElementsAre(0, 0, 0, 1, 2));
+  EXPECT_THAT(ConnectedComponents(boxes, TouchSemantics::kCorner),
+              ElementsAre(0, 0, 0, 0, 1));
+}
+
+TEST(ConnectedComponents, Rings) {
+  Ring2_i l = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  // Inside the bounding box of l but outside l, touching its edge.
+  Ring2_i a(Box2_i(0, 20, 20, 30));
+  // Touches only the corner (40, 40) of l.
+  Ring2_i b(Box2_i(40, 40, 50, 50));
+  // Shares an edge with b only.
+  Ring2_i c(Box2_i(50, 40, 60, 50));
+  std::vector<Ring2_i> rings = {l, a, b, c};
+
+  EXPECT_THAT(ConnectedComponents(rings, TouchSemantics::kOverlap),
+              ElementsAre(0, 1, 2, 3));
+  EXPECT_THAT(ConnectedComponents(rings, TouchSemantics::kEdge),
+              ElementsAre(0, 0, 1, 1));
+  EXPECT_THAT(ConnectedComponents(rings, TouchSemantics::kCorner),
+              ElementsAre(0, 0, 0, 0));
+}
+
+TEST(ConnectedComponents, ViaRules) {
+  // Two metal1 wires joined through a via to one metal2 wire.
+  std::vector<Box2_i> boxes = {
+      Box2_i(0, 0, 10, 2),     // 0: metal1
+      Box2_i(20, 0, 30, 2),    // 1: metal1
+      Box2_i(0, 0, 30, 2),     // 2: metal2 over both.
+      Box2_i(0, 0, 2, 2),      // 3: via12 on 0.
+      Box2_i(28, 0, 30, 2),    // 4: via12 on 1.
+      Box2_i(100, 0, 110, 2),  // 5: metal3
+  };
+  std::vector<int> layers = {1, 1, 2, 12, 12, 3};
+
+  EXPECT_THAT(ConnectedComponents(boxes, layers, {}),
+              ElementsAre(0, 1, 2, 3, 4, 5));
+  EXPECT_THAT(ConnectedComponents(boxes, layers, {{12, 1, 2}}),
+              ElementsAre(0, 0, 0, 0, 0, 1));
+  // Without the via on 1, the second metal1 wire is isolated.
+  EXPECT_THAT(ConnectedComponents(std::vector<Box2_i>(boxes.begin(),
+                                                      boxes.begin() + 4),
+                                  {1, 1, 2, 12}, {{12, 1, 2}}),
+              ElementsAre(0, 1, 0, 0));
+}
+
+TEST(ConnectedComponents, MatchesBruteForce) {
+  std::mt19937 gen(28);
+  std::uniform_int_distribution<int> pos(0, 4000);
+  std::uniform_int_distribution<int> size(1, 20);
+  std::uniform_int_distribution<int> layer(0, 2);
+  std::vector<Box2_i> boxes;
+  std::vector<int> layers;
+  for (int i = 0; i < 5000; ++i) {
+    int x = pos(gen), y = pos(gen);
+    boxes.push_back(Box2_i(x, y, x + size(gen), y + size(gen)));
+    layers.push_back(layer(gen));
+  }
+  std::vector<ViaRule> rules = {{1, 0, 2}};
+  UnionFind uf(boxes.size());
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    for (std::size_t j = i + 1; j < boxes.size(); ++j) {
+      if (layers[i] != layers[j] && layers[i] != 1 && layers[j] != 1) continue;
+      if (IsIntersect(boxes[i], boxes[j])) uf.Union(i, j);
+    }
+  }
+  std::vector<std::size_t> expected = uf.Components();
+
+  EXPECT_EQ(ConnectedComponents(boxes, layers, rules, TouchSemantics::kCorner,
+                                1),
+            expected);
+  EXPECT_EQ(ConnectedComponents(boxes, layers, rules, TouchSemantics::kCorner,
+                                4),
+            expected);
+}
+
+TEST(ConnectedComponents, LongWires) {
+  // Parallel wires that all overlap in x, and a strap joining the first ten.
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < 50000; ++i) {
+    boxes.push_back(Box2_i(i % 7, i * 10, 1000000, i * 10 + 5));
+  }
+  boxes.push_back(Box2_i(500, 0, 505, 95));
+  std::vector<std::size_t> expected(boxes.size());
+  for (std::size_t i = 0; i < expected.size(); ++i) {
+    expected[i] = i < 10 ? 0 : i - 9;
+  }
+  expected.back() = 0;
+
+  EXPECT_EQ(ConnectedComponents(boxes, TouchSemantics::kEdge, 1), expected);
+  EXPECT_EQ(ConnectedComponents(boxes, TouchSemantics::kEdge, 4), expected);
+}
+
+}  // namespace moab
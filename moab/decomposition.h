@@ -0,0 +1,460 @@
+#ifndef MOAB_DECOMPOSITION_H_
+#define MOAB_DECOMPOSITION_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/rectilinear_grid.h"
+
+namespace moab {
+
+// Decomposition modes.
+enum class DecompositionMode {
+  // Cuts along horizontal lines through the reflex vertices.
+  kHorizontal,
+  // Cuts along vertical lines through the reflex vertices.
+  kVertical,
+  // Minimizes the number of rectangles.
+  kMinimum,
+};
+
+namespace decomposition_internal {
+
+// A chord along a grid line between two reflex vertices.
+struct Chord {
+  std::size_t line;   // Grid line index (y index for horizontal chords).
+  std::size_t begin;  // Grid point index along the line.
+  std::size_t end;    // Grid point index along the line, end > begin.
+};
+
+// Maximum bipartite matching (Kuhn's algorithm). adj[u] lists the right
+// vertices adjacent to left vertex u. Returns the matched left vertex of each
+// right vertex, or -1.
+inline std::vector<int> MaxMatching(const std::vector<std::vector<int>>& adj,
+                                    std::size_t num_right) {
+  std::vector<int> match_right(num_right, -1);
+  std::vector<int> visited(num_right, -1);
+  // Iterative augmenting path search from left vertex root.
+  auto augment = [&](int root) {
+    std::vector<std::pair<int, std::size_t>> stack = {{root, 0}};
+    std::vector<int> path;  // Right vertices along the current path.
+    while (!stack.empty()) {
+      auto& [u, k] = stack.back();
+      if (k == adj[u].size()) {
+        stack.pop_back();
+        if (!path.empty()) path.pop_back();
+        continue;
+      }
+      const int v = adj[u][k++];
+      if (visited[v] == root) continue;
+      visited[v] = root;
+      path.push_back(v);
+      if (match_right[v] < 0) {
+        // Flip the path.
+        for (std::size_t i = 0; i < path.size(); ++i) {
+          match_right[path[i]] = stack[i].first;
+        }
+        return true;
+      }
+      stack.emplace_back(match_right[v], 0);
+    }
+    return false;
+  };
+  for (std::size_t u = 0; u < adj.size(); ++u) augment(static_cast<int>(u));
+  return match_right;
+}
+
+// Cuts a RectilinearGrid into rectangles with the fewest pieces. The method
+// follows the classic chord-matching construction: take a maximum set of
+// non-intersecting chords between reflex vertices (the complement of a
+// minimum vertex cover in the bipartite intersection graph of horizontal and
+// vertical chords, by Konig's theorem), then resolve every remaining reflex
+// vertex with one cut to the nearest boundary or cut.
+template <typename T>
+class MinimumCutter {
+ public:
+  explicit MinimumCutter(const RectilinearGrid<T>& grid)
+      : grid_(grid),
+        nc_(grid.NumCols()),
+        nr_(grid.NumRows()),
+        hcut_((nr_ + 1) * nc_, 0),
+        vcut_((nc_ + 1) * nr_, 0) {}
+
+  std::vector<Box2<T>> Run() {
+    FindReflexVertices();
+    std::vector<Chord> hchords = GoodChords(true);
+    std::vector<Chord> vchords = GoodChords(false);
+    // Intersection graph between horizontal and vertical chords.
+    std::vector<std::vector<int>> adj(hchords.size());
+    for (std::size_t h = 0; h < hchords.size(); ++h) {
+      for (std::size_t v = 0; v < vchords.size(); ++v) {
+        if (hchords[h].begin <= vchords[v].line &&
+            vchords[v].line <= hchords[h].end &&
+            vchords[v].begin <= hchords[h].line &&
+            hchords[h].line <= vchords[v].end) {
+          adj[h].push_back(static_cast<int>(v));
+        }
+      }
+    }
+    const std::vector<int> match_right = MaxMatching(adj, vchords.size());
+    std::vector<bool> h_matched(hchords.size(), false);
+    for (int u : match_right) {
+      if (u >= 0) h_matched[u] = true;
+    }
+    // Alternating reachability from unmatched horizontal chords.
+    std::vector<bool> h_reached(hchords.size(), false);
+    std::vector<bool> v_reached(vchords.size(), false);
+    std::vector<int> queue;
+    for (std::size_t h = 0; h < hchords.size(); ++h) {
+      if (!h_matched[h]) {
+        h_reached[h] = true;
+        queue.push_back(static_cast<int>(h));
+      }
+    }
+    while (!queue.empty()) {
+      const int h = queue.back();
+      queue.pop_back();
+      for (int v : adj[h]) {
+        if (v_reached[v]) continue;
+        v_reached[v] = true;
+        const int next = match_right[v];
+        if (next >= 0 && !h_reached[next]) {
+          h_reached[next] = true;
+          queue.push_back(next);
+        }
+      }
+    }
+    // Maximum independent set: reached horizontal and unreached vertical.
+    for (std::size_t h = 0; h < hchords.size(); ++h) {
+      if (h_reached[h]) AddChord(hchords[h], true);
+    }
+    for (std::size_t v = 0; v < vchords.size(); ++v) {
+      if (!v_reached[v]) AddChord(vchords[v], false);
+    }
+    // Resolve the remaining reflex vertices.
+    for (const Reflex& r : reflex_) {
+      if (HasIncidentCut(r.i, r.j)) continue;
+      Extend(r);
+    }
+    return Faces();
+  }
+
+ private:
+  struct Reflex {
+    std::size_t i;  // Grid point x index.
+    std::size_t j;  // Grid point y index.
+    int dx;         // Horizontal chord direction.
+    int dy;         // Vertical chord direction.
+  };
+
+  bool Covered(std::ptrdiff_t c, std::ptrdiff_t r) const {
+    if (c < 0 || r < 0 || c >= static_cast<std::ptrdiff_t>(nc_) ||
+        r >= static_cast<std::ptrdiff_t>(nr_)) {
+      return false;
+    }
+    return grid_.IsCovered(c, r);
+  }
+  // Horizontal edge from grid point (c, j) to (c + 1, j).
+  bool IsBoundaryH(std::size_t c, std::size_t j) const {
+    return Covered(c, j) != Covered(c, static_cast<std::ptrdiff_t>(j) - 1);
+  }
+  bool IsInteriorH(std::size_t c, std::size_t j) const {
+    return Covered(c, j) && Covered(c, static_cast<std::ptrdiff_t>(j) - 1);
+  }
+  bool IsWallH(std::size_t c, std::size_t j) const {
+    return IsBoundaryH(c, j) || hcut_[j * nc_ + c];
+  }
+  // Vertical edge from grid point (i, r) to (i, r + 1).
+  bool IsBoundaryV(std::size_t i, std::size_t r) const {
+    return Covered(i, r) != Covered(static_cast<std::ptrdiff_t>(i) - 1, r);
+  }
+  bool IsInteriorV(std::size_t i, std::size_t r) const {
+    return Covered(i, r) && Covered(static_cast<std::ptrdiff_t>(i) - 1, r);
+  }
+  bool IsWallV(std::size_t i, std::size_t r) const {
+    return IsBoundaryV(i, r) || vcut_[i * nr_ + r];
+  }
+
+  void FindReflexVertices() {
+    for (std::size_t j = 1; j < nr_; ++j) {
+      for (std::size_t i = 1; i < nc_; ++i) {
+        const bool ll = Covered(i - 1, j - 1), lr = Covered(i, j - 1);
+        const bool ul = Covered(i - 1, j), ur = Covered(i, j);
+        if (ll + lr + ul + ur != 3) continue;
+        // The chords continue the boundary edges away from the missing cell.
+        const int mx = (!ll || !ul) ? -1 : 1;
+        const int my = (!ll || !lr) ? -1 : 1;
+        reflex_.push_back({i, j, -mx, -my});
+      }
+    }
+  }
+
+  // Returns the chords between two reflex vertices that lie in the interior.
+  std::vector<Chord> GoodChords(bool horizontal) const {
+    // Reflex vertices grouped by grid line, ordered along the line.
+    std::map<std::size_t, std::vector<std::pair<std::size_t, int>>> lines;
+    for (const Reflex& r : reflex_) {
+      if (horizontal) {
+        lines[r.j].emplace_back(r.i, r.dx);
+      } else {
+        lines[r.i].emplace_back(r.j, r.dy);
+      }
+    }
+    std::vector<Chord> chords;
+    for (auto& [line, points] : lines) {
+      std::sort(points.begin(), points.end());
+      for (std::size_t k = 0; k + 1 < points.size(); ++k) {
+        if (points[k].second != 1 || points[k + 1].second != -1) continue;
+        bool interior = true;
+        for (std::size_t p = points[k].first;
+             interior && p < points[k + 1].first; ++p) {
+          interior = horizontal ? IsInteriorH(p, line) : IsInteriorV(line, p);
+        }
+        if (interior) {
+          chords.push_back({line, points[k].first, points[k + 1].first});
+        }
+      }
+    }
+    return chords;
+  }
+
+  void AddChord(const Chord& c, bool horizontal) {
+    for (std::size_t p = c.begin; p < c.end; ++p) {
+      if (horizontal) {
+        hcut_[c.line * nc_ + p] = 1;
+      } else {
+        vcut_[c.line * nr_ + p] = 1;
+      }
+    }
+  }
+
+  bool HasIncidentCut(std::size_t i, std::size_t j) const {
+    return (i > 0 && hcut_[j * nc_ + i - 1]) ||
+           (i < nc_ && hcut_[j * nc_ + i]) ||
+           (j > 0 && vcut_[i * nr_ + j - 1]) ||
+           (j < nr_ && vcut_[i * nr_ + j]);
+  }
+
+  // Extends a horizontal cut from a reflex vertex until it reaches a boundary
+  // or another cut.
+  void Extend(const Reflex& r) {
+    std::size_t i = r.i;
+    while (true) {
+      const std::size_t c = r.dx > 0 ? i : i - 1;
+      hcut_[r.j * nc_ + c] = 1;
+      i = r.dx > 0 ? i + 1 : i - 1;
+      // Stop at any wall crossing or continuing through grid point (i, r.j).
+      const bool up = r.j < nr_ && IsWallV(i, r.j);
+      const bool down = r.j > 0 && IsWallV(i, r.j - 1);
+      const bool ahead = r.dx > 0 ? (i >= nc_ || IsWallH(i, r.j))
+                                  : (i == 0 || IsWallH(i - 1, r.j));
+      if (up || down || ahead) break;
+    }
+  }
+
+  // Returns the bounding boxes of the faces left by the cuts.
+  std::vector<Box2<T>> Faces() const {
+    std::vector<std::size_t> parent(nc_ * nr_);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto find = [&parent](std::size_t x) {
+      while (parent[x] != x) x = parent[x] = parent[parent[x]];
+      return x;
+    };
+    for (std::size_t r = 0; r < nr_; ++r) {
+      for (std::size_t c = 0; c < nc_; ++c) {
+        if (!grid_.IsCovered(c, r)) continue;
+        if (c + 1 < nc_ && grid_.IsCovered(c + 1, r) &&
+            !vcut_[(c + 1) * nr_ + r]) {
+          parent[find(r * nc_ + c)] = find(r * nc_ + c + 1);
+        }
+        if (r + 1 < nr_ && grid_.IsCovered(c, r + 1) &&
+            !hcut_[(r + 1) * nc_ + c]) {
+          parent[find(r * nc_ + c)] = find((r + 1) * nc_ + c);
+        }
+      }
+    }
+    // Cell index bounds per face: (c0, r0, c1, r1).
+    std::map<std::size_t, std::array<std::size_t, 4>> faces;
+    for (std::size_t r = 0; r < nr_; ++r) {
+      for (std::size_t c = 0; c < nc_; ++c) {
+        if (!grid_.IsCovered(c, r)) continue;
+        auto [it, inserted] =
+            faces.try_emplace(find(r * nc_ + c), std::array<std::size_t, 4>{
+                                                     c, r, c + 1, r + 1});
+        std::array<std::size_t, 4>& f = it->second;
+        f[0] = std::min(f[0], c);
+        f[1] = std::min(f[1], r);
+        f[2] = std::max(f[2], c + 1);
+        f[3] = std::max(f[3], r + 1);
+      }
+    }
+    std::vector<Box2<T>> boxes;
+    boxes.reserve(faces.size());
+    for (const auto& [root, f] : faces) {
+      boxes.push_back(grid_.CellsBox(f[0], f[1], f[2], f[3]));
+    }
+    return boxes;
+  }
+
+  const RectilinearGrid<T>& grid_;
+  std::size_t nc_;
+  std::size_t nr_;
+  std::vector<uint8_t> hcut_;  // (nr_ + 1) x nc_ horizontal edges.
+  std::vector<uint8_t> vcut_;  // (nc_ + 1) x nr_ vertical edges.
+  std::vector<Reflex> reflex_;
+};
+
+// Returns the boxes with x and y swapped.
+template <typename T>
+std::vector<Box2<T>> Transposed(std::vector<Box2<T>> boxes) {
+  for (Box2<T>& b : boxes) b = Box2<T>(b.yl(), b.xl(), b.yh(), b.xh());
+  return boxes;
+}
+
+// Returns the vertical slabs of a region given as non-overlapping boxes.
+template <typename T>
+std::vector<Box2<T>> VerticalSlabs(const std::vector<Box2<T>>& boxes) {
+  std::vector<HorizontalEdge<T>> edges;
+  for (const Box2<T>& b : Transposed(boxes)) AppendHorizontalEdges<T>(b, edges);
+  return Transposed(HorizontalSlabs(std::move(edges)));
+}
+
+// Groups horizontal slabs (see HorizontalSlabs) into the connected components
+// of their region, i.e., slabs that share a horizontal edge of positive
+// length. Slabs ending at each y are matched with those starting there in
+// order of x, so it takes O(n log n).
+template <typename T>
+std::vector<std::vector<Box2<T>>> Components(
+    const std::vector<Box2<T>>& slabs) {
+  const std::size_t n = slabs.size();
+  std::vector<std::size_t> parent(n);
+  std::iota(parent.begin(), parent.end(), 0);
+  auto find = [&parent](std::size_t x) {
+    while (parent[x] != x) x = parent[x] = parent[parent[x]];
+    return x;
+  };
+  std::vector<std::size_t> tops(n), bottoms(n);
+  std::iota(tops.begin(), tops.end(), 0);
+  std::iota(bottoms.begin(), bottoms.end(), 0);
+  std::sort(tops.begin(), tops.end(), [&slabs](std::size_t a, std::size_t b) {
+    return std::make_pair(slabs[a].yh(), slabs[a].xl()) <
+           std::make_pair(slabs[b].yh(), slabs[b].xl());
+  });
+  std::sort(bottoms.begin(), bottoms.end(),
+            [&slabs](std::size_t a, std::size_t b) {
+              return std::make_pair(slabs[a].yl(), slabs[a].xl()) <
+                     std::make_pair(slabs[b].yl(), slabs[b].xl());
+            });
+  std::size_t i = 0, j = 0;
+  while (i < n && j < n) {
+    const Box2<T>& below = slabs[tops[i]];
+    const Box2<T>& above = slabs[bottoms[j]];
+    if (below.yh() != above.yl()) {
+      if (below.yh() < above.yl()) {
+        ++i;
+      } else {
+        ++j;
+      }
+      continue;
+    }
+    if (std::max(below.xl(), above.xl()) < std::min(below.xh(), above.xh())) {
+      parent[find(tops[i])] = find(bottoms[j]);
+    }
+    // The slab that ends first along the line touches no later slab.
+    if (below.xh() < above.xh()) {
+      ++i;
+    } else {
+      ++j;
+    }
+  }
+  std::vector<std::vector<Box2<T>>> components;
+  std::vector<std::size_t> index(n, n);
+  for (std::size_t k = 0; k < n; ++k) {
+    std::size_t& c = index[find(k)];
+    if (c == n) {
+      c = components.size();
+      components.emplace_back();
+    }
+    components[c].push_back(slabs[k]);
+  }
+  return components;
+}
+
+// Decomposes a region given as its horizontal slabs.
+template <typename T>
+std::vector<Box2<T>> DecomposeSlabs(std::vector<Box2<T>> slabs,
+                                    DecompositionMode mode) {
+  switch (mode) {
+    case DecompositionMode::kHorizontal:
+      return slabs;
+    case DecompositionMode::kVertical:
+      return VerticalSlabs(slabs);
+    case DecompositionMode::kMinimum: {
+      // Components are cut independently, each on its own grid.
+      std::vector<Box2<T>> boxes;
+      for (const std::vector<Box2<T>>& component : Components(slabs)) {
+        const RectilinearGrid<T> grid(component);
+        std::vector<Box2<T>> cut = MinimumCutter<T>(grid).Run();
+        boxes.insert(boxes.end(), cut.begin(), cut.end());
+      }
+      return boxes;
+    }
+  }
+  return {};
+}
+
+}  // namespace decomposition_internal
+
+// Decomposes a rectilinear region into non-overlapping boxes.
+// kHorizontal / kVertical give the slab decompositions, built by a scanline
+// over the edges in O(n log n). kMinimum gives a decomposition with the fewest
+// boxes. It cuts every connected component on a grid of the coordinates of
+// that component, so its cost grows with the square of the vertices of the
+// largest component, not of the whole set.
+template <typename T>
+std::vector<Box2<T>> Decompose(const RectilinearGrid<T>& grid,
+                               DecompositionMode mode) {
+  namespace internal = decomposition_internal;
+  if (mode == DecompositionMode::kMinimum) {
+    return internal::MinimumCutter<T>(grid).Run();
+  }
+  return internal::DecomposeSlabs(ToBoxes<T>(grid.RowRuns()), mode);
+}
+
+// Decomposes a Box2, a rectilinear ring or polygon with holes, or a polygon
+// set (e.g., a std::vector of Box2, Ring2 or Polygon2) into non-overlapping
+// boxes. See above for the modes.
+template <typename Geometry>
+std::vector<Box2<coordinate_of_t<Geometry>>> Decompose(
+    const Geometry& g, DecompositionMode mode = DecompositionMode::kMinimum) {
+  using T = coordinate_of_t<Geometry>;
+  return decomposition_internal::DecomposeSlabs(ToBoxes<T>(g), mode);
+}
+
+// Decomposes every geometry of a range independently, on up to num_threads
+// threads (0 means one thread per hardware thread). Returns one box vector
+// per input geometry, in input order.
+template <typename Range>
+auto DecomposeAll(const Range& geometries,
+                  DecompositionMode mode = DecompositionMode::kMinimum,
+                  std::size_t num_threads = 0) {
+  using Geometry = typename Range::value_type;
+  std::vector<std::vector<Box2<coordinate_of_t<Geometry>>>> result(
+      geometries.size());
+  ParallelFor(geometries.size(), num_threads, [&](std::size_t i) {
+    result[i] = Decompose(geometries[i], mode);
+  });
+  return result;
+}
+
+}  // namespace moab
+
+#endif  // MOAB_DECOMPOSITION_H_
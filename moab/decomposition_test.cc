@@ -0,0 +1,224 @@
+#include "decomposition.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/polygon2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::UnorderedElementsAre;
+
+// Returns true if no two boxes share interior points.
+bool IsDisjointSet(const std::vector<Box2_i>& boxes) {
+  for (std::size_t i = 0; i < boxes.size(); ++i) {
+    for (std::size_t j = i + 1; j < boxes.size(); ++j) {
+      if (IsStrictlyIntersect(boxes[i], boxes[j])) return false;
+    }
+  }
+  return true;
+}
+
+// A 30 x 30 square with 10 x 10 notches cut from the middle of the top and
+// bottom edges.
+Ring2_i SidewaysH() {
+  return Ring2_i({Point2_i(0, 0), Point2_i(10, 0), Point2_i(10, 10),
+                  Point2_i(20, 10), Point2_i(20, 0), Point2_i(30, 0),
+                  Point2_i(30, 30), Point2_i(20, 30), Point2_i(20, 20),
+                  Point2_i(10, 20), Point2_i(10, 30), Point2_i(0, 30),
+                  Point2_i(0, 0)});
+}
+
+TEST(Decompose, Empty) {
+  EXPECT_THAT(Decompose(std::vector<Box2_i>()), UnorderedElementsAre());
+}
+
+TEST(Decompose, Box) {
+  EXPECT_THAT(Decompose(Box2_i(0, 0, 10, 20)),
+              UnorderedElementsAre(Box2_i(0, 0, 10, 20)));
+}
+
+TEST(Decompose, LShapeHorizontal) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+
+  EXPECT_THAT(Decompose(r, DecompositionMode::kHorizontal),
+              UnorderedElementsAre(Box2_i(0, 0, 40, 20),
+                                   Box2_i(20, 20, 40, 40)));
+}
+
+TEST(Decompose, LShapeVertical) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+
+  EXPECT_THAT(Decompose(r, DecompositionMode::kVertical),
+              UnorderedElementsAre(Box2_i(0, 0, 20, 20),
+                                   Box2_i(20, 0, 40, 40)));
+}
+
+TEST(Decompose, SidewaysHUsesGoodChords) {
+  Ring2_i r = SidewaysH();
+
+  EXPECT_EQ(Decompose(r, DecompositionMode::kHorizontal).size(), 5);
+  EXPECT_THAT(Decompose(r, DecompositionMode::kVertical),
+              UnorderedElementsAre(Box2_i(0, 0, 10, 30), Box2_i(10, 10, 20, 20),
+                                   Box2_i(20, 0, 30, 30)));
+  EXPECT_THAT(Decompose(r, DecompositionMode::kMinimum),
+              UnorderedElementsAre(Box2_i(0, 0, 10, 30), Box2_i(10, 10, 20, 20),
+                                   Box2_i(20, 0, 30, 30)));
+}
+
+TEST(Decompose, Cross) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 10, 30, 20), Box2_i(10, 0, 20, 30)};
+  std::vector<Box2_i> result = Decompose(boxes);
+
+  EXPECT_EQ(result.size(), 3);
+  EXPECT_TRUE(IsDisjointSet(result));
+  EXPECT_TRUE(Equivalence(result, boxes));
+}
+
+TEST(Decompose, Hole) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 30, 10), Box2_i(0, 20, 30, 30),
+                               Box2_i(0, 0, 10, 30), Box2_i(20, 0, 30, 30)};
+  std::vector<Box2_i> result = Decompose(boxes);
+
+  EXPECT_EQ(result.size(), 4);
+  EXPECT_TRUE(IsDisjointSet(result));
+  EXPECT_TRUE(Equivalence(result, boxes));
+}
+
+TEST(Decompose, Staircase) {
+  // Staircase with 4 steps, which needs 4 rectangles in any mode.
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 10, 40), Box2_i(0, 0, 20, 30),
+                               Box2_i(0, 0, 30, 20), Box2_i(0, 0, 40, 10)};
+
+  for (DecompositionMode mode :
+       {DecompositionMode::kHorizontal, DecompositionMode::kVertical,
+        DecompositionMode::kMinimum}) {
+    std::vector<Box2_i> result = Decompose(boxes, mode);
+
+    EXPECT_EQ(result.size(), 4);
+    EXPECT_TRUE(IsDisjointSet(result));
+    EXPECT_TRUE(Equivalence(result, boxes));
+  }
+}
+
+TEST(Decompose, RandomSets) {
+  std::mt19937 gen(27);
+  std::uniform_int_distribution<int> pos(0, 100);
+  std::uniform_int_distribution<int> size(1, 40);
+  for (int t = 0; t < 100; ++t) {
+    std::vector<Box2_i> boxes;
+    for (int i = 0; i < 10; ++i) {
+      int x = pos(gen), y = pos(gen);
+      boxes.push_back(Box2_i(x, y, x + size(gen), y + size(gen)));
+    }
+    std::vector<Box2_i> h = Decompose(boxes, DecompositionMode::kHorizontal);
+    std::vector<Box2_i> v = Decompose(boxes, DecompositionMode::kVertical);
+    std::vector<Box2_i> m = Decompose(boxes, DecompositionMode::kMinimum);
+
+    EXPECT_TRUE(IsDisjointSet(h));
+    EXPECT_TRUE(IsDisjointSet(v));
+    EXPECT_TRUE(IsDisjointSet(m));
+    EXPECT_TRUE(Equivalence(h, boxes));
+    EXPECT_TRUE(Equivalence(v, boxes));
+    EXPECT_TRUE(Equivalence(m, boxes));
+    EXPECT_LE(m.size(), h.size());
+    EXPECT_LE(m.size(), v.size());
+  }
+}
+
+TEST(Decompose, RingSet) {
+  // Two L-shapes in opposite orientations, overlapping in [20, 30) x [0, 20).
+  std::vector<Ring2_i> rings = {
+      Ring2_i({Point2_i(0, 0), Point2_i(30, 0), Point2_i(30, 20),
+               Point2_i(10, 20), Point2_i(10, 40), Point2_i(0, 40),
+               Point2_i(0, 0)}),
+      Ring2_i({Point2_i(20, 0), Point2_i(20, 20), Point2_i(50, 20),
+               Point2_i(50, 0), Point2_i(20, 0)})};
+
+  EXPECT_THAT(Decompose(rings, DecompositionMode::kHorizontal),
+              UnorderedElementsAre(Box2_i(0, 0, 50, 20),
+                                   Box2_i(0, 20, 10, 40)));
+  EXPECT_THAT(Decompose(rings, DecompositionMode::kVertical),
+              UnorderedElementsAre(Box2_i(0, 0, 10, 40),
+                                   Box2_i(10, 0, 50, 20)));
+  for (DecompositionMode mode :
+       {DecompositionMode::kHorizontal, DecompositionMode::kVertical,
+        DecompositionMode::kMinimum}) {
+    std::vector<Box2_i> result = Decompose(rings, mode);
+
+    EXPECT_EQ(result.size(), 2);
+    EXPECT_TRUE(IsDisjointSet(result));
+    EXPECT_TRUE(Equivalence(result, rings));
+  }
+}
+
+TEST(Decompose, PolygonSet) {
+  // A 30 x 30 square with a 10 x 10 hole, and a box next to it.
+  std::vector<Polygon2_i> polygons = {
+      Polygon2_i(Ring2_i(Box2_i(0, 0, 30, 30)),
+                 {Ring2_i({Point2_i(10, 10), Point2_i(10, 20), Point2_i(20, 20),
+                           Point2_i(20, 10), Point2_i(10, 10)})}),
+      Polygon2_i(Box2_i(40, 0, 50, 10))};
+
+  EXPECT_THAT(Decompose(polygons, DecompositionMode::kHorizontal),
+              UnorderedElementsAre(Box2_i(0, 0, 30, 10), Box2_i(40, 0, 50, 10),
+                                   Box2_i(0, 10, 10, 20),
+                                   Box2_i(20, 10, 30, 20),
+                                   Box2_i(0, 20, 30, 30)));
+  for (DecompositionMode mode :
+       {DecompositionMode::kHorizontal, DecompositionMode::kVertical,
+        DecompositionMode::kMinimum}) {
+    std::vector<Box2_i> result = Decompose(polygons, mode);
+
+    EXPECT_EQ(result.size(), 5);
+    EXPECT_TRUE(IsDisjointSet(result));
+    EXPECT_TRUE(Equivalence(result, polygons));
+  }
+}
+
+TEST(Decompose, ManyComponents) {
+  // Diagonal boxes have a distinct x and y each. A grid over the whole set
+  // would hold n^2 cells.
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < 20000; ++i) {
+    boxes.push_back(Box2_i(i * 10, i * 10, i * 10 + 15, i * 10 + 5));
+  }
+
+  for (DecompositionMode mode :
+       {DecompositionMode::kHorizontal, DecompositionMode::kVertical,
+        DecompositionMode::kMinimum}) {
+    std::vector<Box2_i> result = Decompose(boxes, mode);
+
+    int64_t area = 0;
+    for (const Box2_i& b : result) area += b.Area();
+    EXPECT_EQ(area, int64_t{20000} * 75);
+  }
+  EXPECT_EQ(Decompose(boxes, DecompositionMode::kMinimum).size(), 20000);
+}
+
+TEST(DecomposeAll, MatchesDecompose) {
+  std::vector<Ring2_i> rings = {SidewaysH(), Ring2_i(Box2_i(0, 0, 5, 5)),
+                                SidewaysH(), Ring2_i()};
+  std::vector<std::vector<Box2_i>> result =
+      DecomposeAll(rings, DecompositionMode::kMinimum, 4);
+
+  ASSERT_EQ(result.size(), 4);
+  EXPECT_EQ(result[0].size(), 3);
+  EXPECT_THAT(result[1], UnorderedElementsAre(Box2_i(0, 0, 5, 5)));
+  EXPECT_EQ(result[2].size(), 3);
+  EXPECT_THAT(result[3], UnorderedElementsAre());
+}
+
+}  // namespace moab
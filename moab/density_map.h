@@ -0,0 +1,277 @@
+#ifndef MOAB_DENSITY_MAP_H_
+#define MOAB_DENSITY_MAP_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/point2.h"
+#include "moab/rectilinear_grid.h"
+#include "moab/rtree.h"
+
+namespace moab {
+
+// A summed-area table of the covered area of a rectilinear region over a
+// uniform grid of square cells.
+//
+// After an O(n + cells) build, the covered area of a window whose corners lie
+// on grid lines is an O(1) lookup. Other windows are split into the largest
+// grid-aligned window inside them, which is looked up, and a border thinner
+// than a cell on each side, which is measured exactly against the input
+// boxes. Areas are accumulated in 64 bits.
+template <typename T>
+class DensityMap {
+  static_assert(std::is_integral_v<T>, "Coordinates must be integral.");
+
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+  using area_type = int64_t;
+
+  // Constructors.
+  DensityMap() = default;
+  // Builds the map from non-overlapping boxes (use FromGeometry for
+  // overlapping inputs). The grid starts at the multiple of cell_size at or
+  // below the lower left corner of the boxes and covers all of them.
+  explicit DensityMap(const std::vector<Box2<T>>& boxes, T cell_size,
+                      std::size_t num_threads = 0);
+  DensityMap(const DensityMap&) = default;
+  DensityMap(DensityMap&&) = default;
+  ~DensityMap() = default;
+
+  // Assignment operators.
+  DensityMap& operator=(const DensityMap&) = default;
+  DensityMap& operator=(DensityMap&&) = default;
+
+  // Builds the map from a Box2, a rectilinear ring or polygon, or a polygon
+  // set. Overlapping shapes are merged first.
+  template <typename Geometry>
+  static DensityMap FromGeometry(const Geometry& g, T cell_size,
+                                 std::size_t num_threads = 0) {
+    return DensityMap(ToBoxes<T>(g), cell_size, num_threads);
+  }
+
+  // Accessors.
+  T CellSize() const { return cell_size_; }
+  const Point2<T>& Origin() const { return origin_; }
+  std::size_t NumCols() const { return cols_; }
+  std::size_t NumRows() const { return rows_; }
+  bool Empty() const { return cols_ == 0 || rows_ == 0; }
+  // Returns the area spanned by the grid.
+  Box2<T> Extent() const {
+    return Box2<T>(origin_.x(), origin_.y(), GridX(cols_), GridY(rows_));
+  }
+  // Returns the box of cell (col, row).
+  Box2<T> CellBox(std::size_t col, std::size_t row) const {
+    return Box2<T>(GridX(col), GridY(row), GridX(col + 1), GridY(row + 1));
+  }
+
+  // Returns the covered area of cells [col0, col1) x [row0, row1) in O(1).
+  area_type CellsArea(std::size_t col0, std::size_t row0, std::size_t col1,
+                      std::size_t row1) const {
+    DCHECK(col0 <= col1 && col1 <= cols_ && row0 <= row1 && row1 <= rows_);
+    return Prefix(col1, row1) - Prefix(col0, row1) - Prefix(col1, row0) +
+           Prefix(col0, row0);
+  }
+  // Returns the covered area inside the window. Windows aligned to the grid
+  // take O(1); others also pay for the input boxes that cross their border.
+  area_type CoveredArea(const Box2<T>& window) const;
+  // Returns the covered fraction of the window, or 0 for an empty window.
+  double Density(const Box2<T>& window) const {
+    const area_type area = static_cast<area_type>(window.Width()) *
+                           static_cast<area_type>(window.Height());
+    if (area == 0) return 0.0;
+    return static_cast<double>(CoveredArea(window)) / static_cast<double>(area);
+  }
+
+ private:
+  static int64_t FloorDiv(int64_t a, int64_t b) {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+  }
+
+  T GridX(std::size_t col) const {
+    return static_cast<T>(origin_.x() + static_cast<int64_t>(col) * cell_size_);
+  }
+  T GridY(std::size_t row) const {
+    return static_cast<T>(origin_.y() + static_cast<int64_t>(row) * cell_size_);
+  }
+  // Returns the covered area of cells [0, col) x [0, row).
+  area_type Prefix(std::size_t col, std::size_t row) const {
+    if (col == 0 || row == 0) return 0;
+    return table_[(row - 1) * (cols_ + 1) + (col - 1)];
+  }
+  // Returns the covered area inside the window by summing the intersections
+  // with the input boxes.
+  area_type ExactArea(const Box2<T>& window) const;
+
+  T cell_size_ = 1;
+  Point2<T> origin_;
+  std::size_t cols_ = 0;
+  std::size_t rows_ = 0;
+  // Row-major, (rows_ + 1) x (cols_ + 1). Entry (r, c) holds the covered area
+  // of cells [0, c] x [0, r]; the last row and column are scratch space.
+  std::vector<area_type> table_;
+  Rtree<Box2<T>> boxes_;
+};
+
+template <typename T>
+DensityMap<T>::DensityMap(const std::vector<Box2<T>>& boxes, T cell_size,
+                          std::size_t num_threads)
+    : cell_size_(cell_size), boxes_(boxes) {
+  CHECK(cell_size > 0) << "Cell size must be positive. cell_size: "
+                       << cell_size;
+  if (boxes.empty()) return;
+  int64_t xl = boxes[0].xl(), yl = boxes[0].yl();
+  int64_t xh = boxes[0].xh(), yh = boxes[0].yh();
+  for (const Box2<T>& b : boxes) {
+    xl = std::min<int64_t>(xl, b.xl());
+    yl = std::min<int64_t>(yl, b.yl());
+    xh = std::max<int64_t>(xh, b.xh());
+    yh = std::max<int64_t>(yh, b.yh());
+  }
+  const int64_t ox = FloorDiv(xl, cell_size) * cell_size;
+  const int64_t oy = FloorDiv(yl, cell_size) * cell_size;
+  origin_ = Point2<T>(static_cast<T>(ox), static_cast<T>(oy));
+  cols_ = static_cast<std::size_t>(FloorDiv(xh - ox - 1, cell_size) + 1);
+  rows_ = static_cast<std::size_t>(FloorDiv(yh - oy - 1, cell_size) + 1);
+  const std::size_t stride = cols_ + 1;
+  table_.assign((rows_ + 1) * stride, 0);
+
+  // The area a box covers in cell (c, r) is the product of its overlap with
+  // column c and with row r. Its first, middle and last columns (rows) each
+  // have a constant overlap, so the box adds a constant to each of up to 3 x 3
+  // cell ranges. The ranges go into a 2D difference table, which prefix sums
+  // turn into per-cell areas and then into the summed-area table.
+  struct Span {
+    std::size_t first;
+    std::size_t last;  // Inclusive.
+    int64_t length;
+  };
+  auto spans = [cell_size](int64_t lo, int64_t hi, int64_t origin,
+                           Span* out) -> int {
+    if (lo >= hi) return 0;
+    const std::size_t first = FloorDiv(lo - origin, cell_size);
+    const std::size_t last = FloorDiv(hi - origin - 1, cell_size);
+    if (first == last) {
+      out[0] = {first, last, hi - lo};
+      return 1;
+    }
+    int n = 0;
+    out[n++] = {first, first,
+                origin + static_cast<int64_t>(first + 1) * cell_size - lo};
+    if (first + 1 < last) out[n++] = {first + 1, last - 1, cell_size};
+    out[n++] = {last, last,
+                hi - origin - static_cast<int64_t>(last) * cell_size};
+    return n;
+  };
+
+  // Each block owns a range of table rows and applies only the updates that
+  // land in them, so blocks never write the same entry.
+  constexpr std::size_t kMinRowsPerBlock = 64;
+  ParallelForBlocks(
+      rows_ + 1, num_threads,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        auto add = [&](std::size_t row, std::size_t col, area_type v) {
+          if (row >= begin && row < end) table_[row * stride + col] += v;
+        };
+        Span xs[3], ys[3];
+        for (const Box2<T>& b : boxes) {
+          const int nx = spans(b.xl(), b.xh(), ox, xs);
+          const int ny = spans(b.yl(), b.yh(), oy, ys);
+          for (int j = 0; j < ny; ++j) {
+            if (ys[j].last + 1 < begin || ys[j].first >= end) continue;
+            for (int i = 0; i < nx; ++i) {
+              const area_type v = xs[i].length * ys[j].length;
+              add(ys[j].first, xs[i].first, v);
+              add(ys[j].first, xs[i].last + 1, -v);
+              add(ys[j].last + 1, xs[i].first, -v);
+              add(ys[j].last + 1, xs[i].last + 1, v);
+            }
+          }
+        }
+      },
+      kMinRowsPerBlock);
+
+  // Two rounds of 2D prefix sums: differences to cell areas, then cell areas
+  // to the summed-area table.
+  constexpr std::size_t kMinColsPerBlock = 64;
+  for (int round = 0; round < 2; ++round) {
+    ParallelForBlocks(
+        rows_ + 1, num_threads,
+        [&](std::size_t, std::size_t begin, std::size_t end) {
+          for (std::size_t r = begin; r < end; ++r) {
+            area_type* row = &table_[r * stride];
+            for (std::size_t c = 1; c < stride; ++c) row[c] += row[c - 1];
+          }
+        },
+        kMinRowsPerBlock);
+    ParallelForBlocks(
+        stride, num_threads,
+        [&](std::size_t, std::size_t begin, std::size_t end) {
+          for (std::size_t r = 1; r <= rows_; ++r) {
+            const area_type* prev = &table_[(r - 1) * stride];
+            area_type* row = &table_[r * stride];
+            for (std::size_t c = begin; c < end; ++c) row[c] += prev[c];
+          }
+        },
+        kMinColsPerBlock);
+  }
+}
+
+template <typename T>
+typename DensityMap<T>::area_type DensityMap<T>::ExactArea(
+    const Box2<T>& window) const {
+  if (window.Width() <= 0 || window.Height() <= 0) return 0;
+  area_type area = 0;
+  for (const Box2<T>& b : boxes_.QueryIntersects(window)) {
+    const int64_t w = static_cast<int64_t>(std::min(b.xh(), window.xh())) -
+                      std::max(b.xl(), window.xl());
+    const int64_t h = static_cast<int64_t>(std::min(b.yh(), window.yh())) -
+                      std::max(b.yl(), window.yl());
+    if (w > 0 && h > 0) area += w * h;
+  }
+  return area;
+}
+
+template <typename T>
+typename DensityMap<T>::area_type DensityMap<T>::CoveredArea(
+    const Box2<T>& window) const {
+  if (Empty()) return 0;
+  // Nothing is covered outside the grid.
+  const Box2<T> extent = Extent();
+  const T xl = std::max(window.xl(), extent.xl());
+  const T yl = std::max(window.yl(), extent.yl());
+  const T xh = std::min(window.xh(), extent.xh());
+  const T yh = std::min(window.yh(), extent.yh());
+  if (xl >= xh || yl >= yh) return 0;
+
+  // Grid lines of the largest aligned window inside.
+  const int64_t c = cell_size_;
+  const int64_t col0 = FloorDiv(xl - origin_.x() + c - 1, c);
+  const int64_t row0 = FloorDiv(yl - origin_.y() + c - 1, c);
+  const int64_t col1 = FloorDiv(xh - origin_.x(), c);
+  const int64_t row1 = FloorDiv(yh - origin_.y(), c);
+  if (col0 >= col1 || row0 >= row1) {
+    return ExactArea(Box2<T>(xl, yl, xh, yh));
+  }
+  const T ixl = GridX(col0), iyl = GridY(row0);
+  const T ixh = GridX(col1), iyh = GridY(row1);
+  return CellsArea(col0, row0, col1, row1) +
+         ExactArea(Box2<T>(xl, yl, xh, iyl)) +
+         ExactArea(Box2<T>(xl, iyh, xh, yh)) +
+         ExactArea(Box2<T>(xl, iyl, ixl, iyh)) +
+         ExactArea(Box2<T>(ixh, iyl, xh, iyh));
+}
+
+// Aliases.
+using DensityMap_i = DensityMap<int>;
+using DensityMap_i32 = DensityMap<int32_t>;
+using DensityMap_i64 = DensityMap<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_DENSITY_MAP_H_
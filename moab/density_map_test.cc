@@ -0,0 +1,114 @@
+#include "density_map.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+// Returns the covered area inside the window by a boolean.
+int64_t BruteForceArea(const std::vector<Box2_i>& boxes,
+                       const Box2_i& window) {
+  std::vector<Box2_i> clipped = {window};
+  IntersectionSet(clipped, boxes);
+  return Area(clipped);
+}
+
+TEST(DensityMap, Empty) {
+  DensityMap_i map(std::vector<Box2_i>{}, 10);
+
+  EXPECT_TRUE(map.Empty());
+  EXPECT_EQ(map.CoveredArea(Box2_i(0, 0, 100, 100)), 0);
+  EXPECT_EQ(map.Density(Box2_i(0, 0, 100, 100)), 0.0);
+}
+
+TEST(DensityMap, Grid) {
+  DensityMap_i map({Box2_i(-5, 3, 12, 20)}, 10);
+
+  EXPECT_EQ(map.Origin(), Point2_i(-10, 0));
+  EXPECT_EQ(map.NumCols(), 3);
+  EXPECT_EQ(map.NumRows(), 2);
+  EXPECT_EQ(map.Extent(), Box2_i(-10, 0, 20, 20));
+  EXPECT_EQ(map.CellBox(1, 1), Box2_i(0, 10, 10, 20));
+}
+
+TEST(DensityMap, CellsArea) {
+  DensityMap_i map({Box2_i(-5, 3, 12, 20)}, 10);
+
+  EXPECT_EQ(map.CellsArea(0, 0, 1, 1), 5 * 7);
+  EXPECT_EQ(map.CellsArea(1, 0, 2, 2), 10 * 17);
+  EXPECT_EQ(map.CellsArea(2, 1, 3, 2), 2 * 10);
+  EXPECT_EQ(map.CellsArea(0, 0, 3, 2), 17 * 17);
+  EXPECT_EQ(map.CellsArea(1, 1, 1, 2), 0);
+}
+
+TEST(DensityMap, Density) {
+  DensityMap_i map({Box2_i(0, 0, 10, 5)}, 10);
+
+  EXPECT_DOUBLE_EQ(map.Density(Box2_i(0, 0, 10, 10)), 0.5);
+  EXPECT_DOUBLE_EQ(map.Density(Box2_i(0, 0, 20, 20)), 0.125);
+  EXPECT_DOUBLE_EQ(map.Density(Box2_i(2, 1, 4, 3)), 1.0);
+  EXPECT_DOUBLE_EQ(map.Density(Box2_i(2, 1, 2, 3)), 0.0);
+}
+
+TEST(DensityMap, FromGeometryMergesOverlaps) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 10, 10), Box2_i(5, 5, 15, 15)};
+  DensityMap_i map = DensityMap_i::FromGeometry(boxes, 4);
+
+  EXPECT_EQ(map.CoveredArea(Box2_i(-100, -100, 100, 100)), 175);
+  EXPECT_EQ(map.CoveredArea(Box2_i(0, 0, 8, 8)), 64);
+  EXPECT_EQ(map.CoveredArea(Box2_i(6, 6, 9, 9)), 9);
+}
+
+TEST(DensityMap, Ring) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(30, 0), Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(0, 10),
+               Point2_i(0, 0)};
+  DensityMap_i map = DensityMap_i::FromGeometry(r, 7);
+
+  EXPECT_EQ(map.CoveredArea(map.Extent()), r.Area());
+  EXPECT_EQ(map.CoveredArea(Box2_i(15, 5, 25, 15)), 5 * 5 + 5 * 10);
+}
+
+// Compares aligned, off-grid and out-of-range windows with a boolean.
+void CheckRandomWindows(int cell, std::size_t num_threads) {
+  std::mt19937 gen(33);
+  std::uniform_int_distribution<int> pos(-200, 200);
+  std::uniform_int_distribution<int> size(1, 60);
+  std::vector<Box2_i> shapes;
+  for (int i = 0; i < 200; ++i) {
+    int x = pos(gen), y = pos(gen);
+    shapes.emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+  std::vector<Box2_i> boxes;
+  Assign(boxes, shapes);
+  DensityMap_i map(boxes, cell, num_threads);
+
+  for (int i = 0; i < 300; ++i) {
+    int x = pos(gen), y = pos(gen);
+    Box2_i window(x, y, x + 2 * size(gen), y + 2 * size(gen));
+    if (i % 3 == 0) {
+      // Aligned to the grid.
+      const int ax = map.Origin().x() + (x + 200) / cell * cell;
+      const int ay = map.Origin().y() + (y + 200) / cell * cell;
+      window = Box2_i(ax, ay, ax + cell * (1 + i % 5), ay + cell * (1 + i % 7));
+    }
+    EXPECT_EQ(map.CoveredArea(window), BruteForceArea(boxes, window))
+        << "window: " << window;
+  }
+  EXPECT_EQ(map.CoveredArea(map.Extent()), Area(boxes));
+}
+
+TEST(DensityMap, RandomWindows) { CheckRandomWindows(16, 1); }
+
+// Small cells give enough rows for several blocks.
+TEST(DensityMap, RandomWindowsParallel) { CheckRandomWindows(2, 4); }
+
+}  // namespace moab
@@ -0,0 +1,216 @@
+#ifndef MOAB_GEOMETRY_POOL_H_
+#define MOAB_GEOMETRY_POOL_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/hash/hash.h"
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+#include "moab/transform.h"
+
+namespace moab {
+
+namespace geometry_pool_internal {
+
+// Returns the bounding box of a shape.
+template <typename T>
+const Box2<T>& Bounds(const Box2<T>& b) {
+  return b;
+}
+template <typename T>
+Box2<T> Bounds(const Ring2<T>& r) {
+  CHECK(!r.Empty()) << "Ring is empty.";
+  return r.BoundingBox();
+}
+
+}  // namespace geometry_pool_internal
+
+// A pool of distinct shapes, each stored once relative to its origin: the
+// lower left corner of its bounding box. Interning a shape returns a Handle,
+// a 32-bit shape id plus the offset of the shape, so a layer with millions of
+// identical vias holds one shape and millions of handles, e.g., as the values
+// of an RtreeMapBox2 keyed by BoundingBox(handle). Shapes are resolved from
+// their handle only when needed.
+//
+// Shapes are compared with operator== and hashed with AbslHashValue. Rings
+// that are equal under IsEqual share the id of the first one interned, so
+// Get may return a ring with another start point than the one interned. Each
+// shape is stored once, with its hash: the lookup set holds only ids, so it
+// never hashes a pooled shape again when it grows.
+//
+// G is Box2<T> or Ring2<T>.
+//
+// Usage:
+//   GeometryPoolRing2_i pool;
+//   RtreeMapBox2_i<GeometryPoolRing2_i::Handle> vias;
+//   for (const Ring2_i& via : layer) {
+//     const GeometryPoolRing2_i::Handle h = pool.Intern(via);
+//     vias.Insert({pool.BoundingBox(h), h});
+//   }
+template <typename G>
+class GeometryPool {
+ public:
+  // Type aliases.
+  using geometry_type = G;
+  using coordinate_type = typename G::coordinate_type;
+  using point_type = Point2<coordinate_type>;
+  using box_type = Box2<coordinate_type>;
+  using id_type = uint32_t;
+
+  // A pooled shape moved by offset.
+  struct Handle {
+    id_type id = 0;
+    point_type offset;
+
+    bool operator==(const Handle& h) const {
+      return id == h.id && offset == h.offset;
+    }
+    bool operator!=(const Handle& h) const { return !(*this == h); }
+    template <typename H>
+    friend H AbslHashValue(H h, const Handle& handle) {
+      return H::combine(std::move(h), handle.id, handle.offset);
+    }
+  };
+
+  // Constructors.
+  // The lookup set refers to the pool that owns it, so copies and moves
+  // rebuild it from the stored hashes.
+  GeometryPool() = default;
+  GeometryPool(const GeometryPool& p)
+      : shapes_(p.shapes_), bounds_(p.bounds_), hashes_(p.hashes_) {
+    Reindex();
+  }
+  GeometryPool(GeometryPool&& p)
+      : shapes_(std::move(p.shapes_)),
+        bounds_(std::move(p.bounds_)),
+        hashes_(std::move(p.hashes_)) {
+    Reindex();
+    p.Clear();
+  }
+  ~GeometryPool() = default;
+
+  // Assignment operators.
+  GeometryPool& operator=(const GeometryPool& p) {
+    if (this != &p) {
+      shapes_ = p.shapes_;
+      bounds_ = p.bounds_;
+      hashes_ = p.hashes_;
+      Reindex();
+    }
+    return *this;
+  }
+  GeometryPool& operator=(GeometryPool&& p) {
+    if (this != &p) {
+      shapes_ = std::move(p.shapes_);
+      bounds_ = std::move(p.bounds_);
+      hashes_ = std::move(p.hashes_);
+      Reindex();
+      p.Clear();
+    }
+    return *this;
+  }
+
+  // Accessors.
+  // Returns the number of distinct shapes.
+  std::size_t Size() const { return shapes_.size(); }
+  bool Empty() const { return shapes_.empty(); }
+  // Returns the shape with the given id, relative to its origin.
+  const G& Shape(id_type id) const {
+    CHECK(id < shapes_.size()) << "No such shape. id: " << id;
+    return shapes_[id];
+  }
+  // Returns the placed shape of a handle.
+  G Get(const Handle& h) const {
+    const Transform2<coordinate_type> t(Orientation::kR0, h.offset);
+    return t.Apply(Shape(h.id));
+  }
+  // Returns the bounding box of the placed shape of a handle, without
+  // building the shape.
+  box_type BoundingBox(const Handle& h) const {
+    CHECK(h.id < bounds_.size()) << "No such shape. id: " << h.id;
+    const box_type& b = bounds_[h.id];
+    return box_type(b.xl() + h.offset.x(), b.yl() + h.offset.y(),
+                    b.xh() + h.offset.x(), b.yh() + h.offset.y());
+  }
+
+  // Mutators.
+  // Returns the handle of g, adding its shape to the pool if it is new.
+  Handle Intern(const G& g) {
+    const point_type origin = geometry_pool_internal::Bounds(g).ll();
+    const Transform2<coordinate_type> to_origin(Orientation::kR0, -origin);
+    G shape = to_origin.Apply(g);
+    if (auto it = ids_.find(shape); it != ids_.end()) {
+      return Handle{*it, origin};
+    }
+    CHECK(shapes_.size() < std::numeric_limits<id_type>::max())
+        << "Too many distinct shapes.";
+    const id_type id = static_cast<id_type>(shapes_.size());
+    hashes_.push_back(absl::Hash<G>()(shape));
+    bounds_.push_back(geometry_pool_internal::Bounds(shape));
+    shapes_.push_back(std::move(shape));
+    ids_.insert(id);
+    return Handle{id, origin};
+  }
+  void Clear() {
+    shapes_.clear();
+    bounds_.clear();
+    hashes_.clear();
+    ids_.clear();
+  }
+
+ private:
+  // Hash and equality of pooled shapes, given by id, and of shapes to look
+  // up, given as is.
+  struct IdHash {
+    using is_transparent = void;
+    std::size_t operator()(id_type id) const { return pool->hashes_[id]; }
+    std::size_t operator()(const G& g) const { return absl::Hash<G>()(g); }
+    const GeometryPool* pool;
+  };
+  struct IdEq {
+    using is_transparent = void;
+    bool operator()(id_type a, id_type b) const {
+      return a == b || pool->shapes_[a] == pool->shapes_[b];
+    }
+    bool operator()(id_type a, const G& g) const {
+      return pool->shapes_[a] == g;
+    }
+    bool operator()(const G& g, id_type a) const {
+      return pool->shapes_[a] == g;
+    }
+    const GeometryPool* pool;
+  };
+  using IdSet = absl::flat_hash_set<id_type, IdHash, IdEq>;
+
+  void Reindex() {
+    ids_ = IdSet(shapes_.size(), IdHash{this}, IdEq{this});
+    for (std::size_t id = 0; id < shapes_.size(); ++id) {
+      ids_.insert(static_cast<id_type>(id));
+    }
+  }
+
+  std::vector<G> shapes_;
+  std::vector<box_type> bounds_;
+  std::vector<std::size_t> hashes_;
+  // Ids of the distinct shapes.
+  IdSet ids_{0, IdHash{this}, IdEq{this}};
+};
+
+// Aliases.
+using GeometryPoolBox2_i = GeometryPool<Box2<int>>;
+using GeometryPoolBox2_i32 = GeometryPool<Box2<int32_t>>;
+using GeometryPoolBox2_i64 = GeometryPool<Box2<int64_t>>;
+using GeometryPoolRing2_i = GeometryPool<Ring2<int>>;
+using GeometryPoolRing2_i32 = GeometryPool<Ring2<int32_t>>;
+using GeometryPoolRing2_i64 = GeometryPool<Ring2<int64_t>>;
+
+}  // namespace moab
+
+#endif  // MOAB_GEOMETRY_POOL_H_
@@ -0,0 +1,123 @@
+#include "geometry_pool.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash_testing.h"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+#include "moab/rtree.h"
+
+namespace moab {
+
+using ::testing::UnorderedElementsAre;
+
+TEST(GeometryPool, Boxes) {
+  GeometryPoolBox2_i pool;
+  const GeometryPoolBox2_i::Handle a = pool.Intern(Box2_i(10, 20, 14, 24));
+  const GeometryPoolBox2_i::Handle b = pool.Intern(Box2_i(-5, 0, -1, 4));
+  const GeometryPoolBox2_i::Handle c = pool.Intern(Box2_i(0, 0, 8, 4));
+
+  EXPECT_EQ(pool.Size(), 2);
+  EXPECT_EQ(a.id, b.id);
+  EXPECT_NE(a.id, c.id);
+  EXPECT_EQ(a.offset, Point2_i(10, 20));
+  EXPECT_EQ(b.offset, Point2_i(-5, 0));
+  EXPECT_EQ(pool.Shape(a.id), Box2_i(0, 0, 4, 4));
+  EXPECT_EQ(pool.Get(a), Box2_i(10, 20, 14, 24));
+  EXPECT_EQ(pool.Get(b), Box2_i(-5, 0, -1, 4));
+  EXPECT_EQ(pool.BoundingBox(c), Box2_i(0, 0, 8, 4));
+  EXPECT_DEATH(pool.Shape(2), "No such shape");
+}
+
+TEST(GeometryPool, Rings) {
+  GeometryPoolRing2_i pool;
+  const Ring2_i l = {Point2_i(0, 0), Point2_i(4, 0), Point2_i(4, 2),
+                     Point2_i(2, 2), Point2_i(2, 4), Point2_i(0, 4),
+                     Point2_i(0, 0)};
+  // The same L shape, moved and starting at another point.
+  const Ring2_i moved = {Point2_i(104, 50), Point2_i(104, 52),
+                         Point2_i(102, 52), Point2_i(102, 54),
+                         Point2_i(100, 54), Point2_i(100, 50),
+                         Point2_i(104, 50)};
+  const GeometryPoolRing2_i::Handle a = pool.Intern(l);
+  const GeometryPoolRing2_i::Handle b = pool.Intern(moved);
+  const GeometryPoolRing2_i::Handle c =
+      pool.Intern(Ring2_i(Box2_i(1, 1, 3, 3)));
+
+  EXPECT_EQ(pool.Size(), 2);
+  EXPECT_EQ(a.id, b.id);
+  EXPECT_EQ(b.offset, Point2_i(100, 50));
+  EXPECT_TRUE(IsEqual(pool.Get(b), moved));
+  EXPECT_EQ(pool.Get(a), l);
+  EXPECT_EQ(pool.Get(c), Ring2_i(Box2_i(1, 1, 3, 3)));
+  EXPECT_EQ(pool.BoundingBox(b), Box2_i(100, 50, 104, 54));
+  EXPECT_DEATH(pool.Intern(Ring2_i()), "Ring is empty");
+}
+
+TEST(GeometryPool, CopyAndMove) {
+  GeometryPoolRing2_i pool;
+  const Ring2_i square(Box2_i(0, 0, 4, 4));
+  const Ring2_i bar(Box2_i(0, 0, 8, 2));
+  pool.Intern(square);
+  pool.Intern(bar);
+  GeometryPoolRing2_i copy = pool;
+  GeometryPoolRing2_i moved = std::move(pool);
+
+  EXPECT_EQ(copy.Intern(Ring2_i(Box2_i(10, 10, 18, 12))).id, 1);
+  EXPECT_EQ(moved.Intern(Ring2_i(Box2_i(10, 10, 14, 14))).id, 0);
+  EXPECT_EQ(copy.Size(), 2);
+  EXPECT_EQ(moved.Size(), 2);
+
+  copy = moved;
+  moved = GeometryPoolRing2_i();
+
+  EXPECT_EQ(copy.Intern(bar).id, 1);
+  EXPECT_TRUE(moved.Empty());
+  EXPECT_EQ(moved.Intern(bar).id, 0);
+}
+
+TEST(GeometryPool, ManyShapes) {
+  // Enough distinct shapes to grow the lookup set many times.
+  GeometryPoolRing2_i pool;
+  for (int i = 1; i <= 10000; ++i) pool.Intern(Ring2_i(Box2_i(0, 0, i, 1)));
+  for (int i = 1; i <= 10000; ++i) {
+    EXPECT_EQ(pool.Intern(Ring2_i(Box2_i(i, i, 2 * i, i + 1))).id, i - 1);
+  }
+
+  EXPECT_EQ(pool.Size(), 10000);
+}
+
+TEST(GeometryPool, Rtree) {
+  GeometryPoolBox2_i pool;
+  RtreeMapBox2_i<GeometryPoolBox2_i::Handle> rtree;
+  for (int i = 0; i < 100; ++i) {
+    const GeometryPoolBox2_i::Handle h =
+        pool.Intern(Box2_i(i * 10, 0, i * 10 + 2, 2));
+    rtree.Insert(pool.BoundingBox(h), h);
+  }
+
+  EXPECT_EQ(pool.Size(), 1);
+  std::vector<Box2_i> hits;
+  for (const auto& [box, h] : rtree.QueryIntersects(Box2_i(15, 0, 35, 1))) {
+    hits.push_back(pool.Get(h));
+  }
+  EXPECT_THAT(hits, UnorderedElementsAre(Box2_i(20, 0, 22, 2),
+                                         Box2_i(30, 0, 32, 2)));
+}
+
+TEST(GeometryPool, HandleHash) {
+  using Handle = GeometryPoolBox2_i::Handle;
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      Handle{0, Point2_i(0, 0)},
+      Handle{1, Point2_i(0, 0)},
+      Handle{0, Point2_i(1, 2)},
+  }));
+}
+
+}  // namespace moab
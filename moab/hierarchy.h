@@ -0,0 +1,215 @@
+#ifndef MOAB_HIERARCHY_H_
+#define MOAB_HIERARCHY_H_
+
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/rtree.h"
+#include "moab/transform.h"
+
+namespace moab {
+
+// A cell hierarchy: every cell holds its own boxes and instances of other
+// cells, each placed by a Transform2. Every master is stored once, with its
+// own R-tree, however many times it is instantiated, so memory grows with the
+// unique geometry instead of the flattened shape count.
+//
+// Cells are built bottom-up: a cell can only instantiate cells created before
+// it, which also rules out cycles. Edits mark cells dirty; Update() recomputes
+// the bounds and the instance index of the dirty cells and their ancestors.
+//
+// Usage:
+//   Hierarchy_i64 h;
+//   const std::size_t inv = h.AddCell();
+//   h.AddShape(inv, Box2_i64(0, 0, 10, 20));
+//   const std::size_t top = h.AddCell();
+//   h.AddInstance(top, inv, Transform2_i64(Orientation::kR90, 100, 0));
+//   h.Update();
+//   std::vector<Box2_i64> hits = h.QueryIntersects(top, window);
+template <typename T>
+class Hierarchy {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // An instance of master placed by transform in its parent cell.
+  struct Instance {
+    std::size_t master;
+    Transform2<T> transform;
+  };
+
+  // Constructors.
+  Hierarchy() = default;
+  Hierarchy(const Hierarchy&) = default;
+  Hierarchy(Hierarchy&&) = default;
+  ~Hierarchy() = default;
+
+  // Assignment operators.
+  Hierarchy& operator=(const Hierarchy&) = default;
+  Hierarchy& operator=(Hierarchy&&) = default;
+
+  // Accessors.
+  std::size_t NumCells() const { return cells_.size(); }
+  // Returns the number of boxes of the cell itself, without its instances.
+  std::size_t NumShapes(std::size_t cell) const {
+    return Get(cell).shapes.Size();
+  }
+  const std::vector<Instance>& Instances(std::size_t cell) const {
+    return Get(cell).instances;
+  }
+  // Returns the number of boxes of all cells, each master counted once.
+  std::size_t NumUniqueShapes() const {
+    std::size_t n = 0;
+    for (const Cell& c : cells_) n += c.shapes.Size();
+    return n;
+  }
+  // Returns the number of boxes of the cell once flattened. Update() must
+  // have been called after the last edit.
+  std::size_t NumFlatShapes(std::size_t cell) const {
+    CHECK(dirty_.empty()) << "Call Update() after editing the hierarchy.";
+    return Get(cell).flat_shapes;
+  }
+  // Returns the bounds of the cell and its instances, or false if it has no
+  // shapes. Update() must have been called after the last edit.
+  bool Bounds(std::size_t cell, Box2<T>& bounds) const {
+    CHECK(dirty_.empty()) << "Call Update() after editing the hierarchy.";
+    bounds = Get(cell).bounds;
+    return Get(cell).flat_shapes > 0;
+  }
+
+  // Mutators.
+  // Adds an empty cell. Returns its id.
+  std::size_t AddCell() {
+    cells_.emplace_back();
+    dirty_.push_back(cells_.size() - 1);
+    return cells_.size() - 1;
+  }
+  void AddShape(std::size_t cell, const Box2<T>& b) {
+    Get(cell).shapes.Insert(b);
+    dirty_.push_back(cell);
+  }
+  // Places master in cell. master must have been created before cell.
+  void AddInstance(std::size_t cell, std::size_t master,
+                   const Transform2<T>& transform) {
+    CHECK(master < cell) << "A cell can only instantiate earlier cells. cell: "
+                         << cell << ", master: " << master;
+    Get(cell).instances.push_back({master, transform});
+    dirty_.push_back(cell);
+  }
+  // Recomputes the dirty cells and the cells that instantiate them.
+  void Update();
+
+  // Queries.
+  // Calls fn(const Box2<T>&) for every box of the flattened cell that
+  // intersects window, in the coordinates of cell. Only instances whose
+  // placed bounds intersect window are visited; their hits are transformed on
+  // the fly. Update() must have been called after the last edit.
+  template <typename Fn>
+  void QueryIntersects(std::size_t cell, const Box2<T>& window, Fn&& fn) const {
+    CHECK(dirty_.empty()) << "Call Update() after editing the hierarchy.";
+    Visit(cell, window, Transform2<T>(), fn);
+  }
+  std::vector<Box2<T>> QueryIntersects(std::size_t cell,
+                                       const Box2<T>& window) const {
+    std::vector<Box2<T>> boxes;
+    QueryIntersects(cell, window,
+                    [&boxes](const Box2<T>& b) { boxes.push_back(b); });
+    return boxes;
+  }
+  // Returns all boxes of the flattened cell, in the coordinates of cell.
+  std::vector<Box2<T>> Flatten(std::size_t cell) const {
+    Box2<T> bounds;
+    if (!Bounds(cell, bounds)) return {};
+    return QueryIntersects(cell, bounds);
+  }
+
+ private:
+  struct Cell {
+    Rtree<Box2<T>> shapes;
+    std::vector<Instance> instances;
+    // Placed bounds of the instances with shapes, keyed to their index.
+    Rtree<std::pair<Box2<T>, std::size_t>> instance_index;
+    Box2<T> bounds;
+    std::size_t flat_shapes = 0;
+  };
+
+  const Cell& Get(std::size_t cell) const {
+    CHECK(cell < cells_.size()) << "No such cell. cell: " << cell;
+    return cells_[cell];
+  }
+  Cell& Get(std::size_t cell) {
+    CHECK(cell < cells_.size()) << "No such cell. cell: " << cell;
+    return cells_[cell];
+  }
+  template <typename Fn>
+  void Visit(std::size_t cell, const Box2<T>& window,
+             const Transform2<T>& to_top, Fn& fn) const;
+
+  std::vector<Cell> cells_;
+  // Cells edited since the last Update(), possibly repeated.
+  std::vector<std::size_t> dirty_;
+};
+
+template <typename T>
+void Hierarchy<T>::Update() {
+  if (dirty_.empty()) return;
+  std::vector<bool> changed(cells_.size(), false);
+  for (std::size_t cell : dirty_) changed[cell] = true;
+  dirty_.clear();
+  // Masters come before the cells that instantiate them.
+  for (std::size_t id = 0; id < cells_.size(); ++id) {
+    Cell& c = cells_[id];
+    for (const Instance& inst : c.instances) {
+      changed[id] = changed[id] || changed[inst.master];
+    }
+    if (!changed[id]) continue;
+    std::vector<std::pair<Box2<T>, std::size_t>> placed;
+    c.flat_shapes = c.shapes.Size();
+    bool has_bounds = false;
+    auto encompass = [&](const Box2<T>& b) {
+      if (!has_bounds) c.bounds = b;
+      c.bounds.Encompass(b);
+      has_bounds = true;
+    };
+    for (const Box2<T>& b : c.shapes) encompass(b);
+    for (std::size_t i = 0; i < c.instances.size(); ++i) {
+      const Cell& master = cells_[c.instances[i].master];
+      if (master.flat_shapes == 0) continue;
+      placed.emplace_back(c.instances[i].transform.Apply(master.bounds), i);
+      encompass(placed.back().first);
+      c.flat_shapes += master.flat_shapes;
+    }
+    if (!has_bounds) c.bounds = Box2<T>();
+    // Bulk loading packs the tree better than inserting one by one.
+    c.instance_index = Rtree<std::pair<Box2<T>, std::size_t>>(placed);
+  }
+}
+
+template <typename T>
+template <typename Fn>
+void Hierarchy<T>::Visit(std::size_t cell, const Box2<T>& window,
+                         const Transform2<T>& to_top, Fn& fn) const {
+  const Cell& c = cells_[cell];
+  for (const Box2<T>& b : c.shapes.QueryIntersects(window)) {
+    fn(to_top.Apply(b));
+  }
+  for (std::size_t i : c.instance_index.template QueryIntersects<1>(window)) {
+    const Instance& inst = c.instances[i];
+    // Manhattan transforms map boxes to boxes, so the window can be moved
+    // into the master instead of moving the master's shapes out.
+    Visit(inst.master, inst.transform.Inverse().Apply(window),
+          to_top * inst.transform, fn);
+  }
+}
+
+// Aliases.
+using Hierarchy_i = Hierarchy<int>;
+using Hierarchy_i32 = Hierarchy<int32_t>;
+using Hierarchy_i64 = Hierarchy<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_HIERARCHY_H_
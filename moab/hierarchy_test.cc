@@ -0,0 +1,114 @@
+#include "hierarchy.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/transform.h"
+
+namespace moab {
+
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+TEST(Hierarchy, Instances) {
+  Hierarchy_i h;
+  const std::size_t leaf = h.AddCell();
+  h.AddShape(leaf, Box2_i(0, 0, 10, 20));
+  h.AddShape(leaf, Box2_i(10, 0, 20, 5));
+  const std::size_t top = h.AddCell();
+  h.AddShape(top, Box2_i(-5, -5, 0, 0));
+  h.AddInstance(top, leaf, Transform2_i(Orientation::kR0, 100, 0));
+  h.AddInstance(top, leaf, Transform2_i(Orientation::kR90, 0, 100));
+  h.Update();
+
+  Box2_i bounds;
+  ASSERT_TRUE(h.Bounds(top, bounds));
+  EXPECT_EQ(bounds, Box2_i(-20, -5, 120, 120));
+  EXPECT_EQ(h.NumUniqueShapes(), 3);
+  EXPECT_EQ(h.NumFlatShapes(top), 5);
+  EXPECT_THAT(h.QueryIntersects(top, Box2_i(100, 0, 105, 3)),
+              UnorderedElementsAre(Box2_i(100, 0, 110, 20)));
+  EXPECT_THAT(h.QueryIntersects(top, Box2_i(-30, 90, -1, 150)),
+              UnorderedElementsAre(Box2_i(-20, 100, 0, 110),
+                                   Box2_i(-5, 110, 0, 120)));
+  EXPECT_THAT(h.Flatten(top),
+              UnorderedElementsAre(Box2_i(-5, -5, 0, 0),
+                                   Box2_i(100, 0, 110, 20),
+                                   Box2_i(110, 0, 120, 5),
+                                   Box2_i(-20, 100, 0, 110),
+                                   Box2_i(-5, 110, 0, 120)));
+}
+
+TEST(Hierarchy, EditsPropagate) {
+  Hierarchy_i h;
+  const std::size_t leaf = h.AddCell();
+  const std::size_t mid = h.AddCell();
+  h.AddInstance(mid, leaf, Transform2_i(Orientation::kMX, 0, 0));
+  const std::size_t top = h.AddCell();
+  h.AddInstance(top, mid, Transform2_i(Orientation::kR0, 50, 50));
+  h.Update();
+
+  Box2_i bounds;
+  EXPECT_FALSE(h.Bounds(top, bounds));
+  EXPECT_TRUE(h.Flatten(top).empty());
+
+  h.AddShape(leaf, Box2_i(0, 0, 10, 10));
+  h.Update();
+
+  EXPECT_THAT(h.Flatten(top), UnorderedElementsAre(Box2_i(50, 40, 60, 50)));
+  EXPECT_DEATH(h.AddInstance(leaf, top, Transform2_i()),
+               "only instantiate earlier cells");
+}
+
+TEST(Hierarchy, MatchesFlattened) {
+  std::mt19937 gen(43);
+  std::uniform_int_distribution<int> pos(0, 100);
+  std::uniform_int_distribution<int> size(1, 20);
+  std::uniform_int_distribution<int> orientation(0, 7);
+  std::uniform_int_distribution<int> offset(-1000, 1000);
+  Hierarchy_i h;
+  std::vector<std::vector<Box2_i>> flat;
+  for (int cell = 0; cell < 6; ++cell) {
+    const std::size_t id = h.AddCell();
+    flat.emplace_back();
+    for (int i = 0; i < 10; ++i) {
+      const int x = pos(gen), y = pos(gen);
+      const Box2_i b(x, y, x + size(gen), y + size(gen));
+      h.AddShape(id, b);
+      flat[id].push_back(b);
+    }
+    for (std::size_t master = 0; master < id; ++master) {
+      for (int i = 0; i < 3; ++i) {
+        const Transform2_i t(static_cast<Orientation>(orientation(gen)),
+                             offset(gen), offset(gen));
+        h.AddInstance(id, master, t);
+        for (const Box2_i& b : flat[master]) flat[id].push_back(t.Apply(b));
+      }
+    }
+  }
+  h.Update();
+  const std::size_t top = h.NumCells() - 1;
+
+  EXPECT_EQ(h.NumUniqueShapes(), 60);
+  EXPECT_EQ(h.NumFlatShapes(top), flat[top].size());
+  EXPECT_THAT(h.Flatten(top), UnorderedElementsAreArray(flat[top]));
+  for (int i = 0; i < 20; ++i) {
+    const int x = offset(gen), y = offset(gen);
+    const Box2_i window(x, y, x + 300, y + 300);
+    std::vector<Box2_i> expected;
+    for (const Box2_i& b : flat[top]) {
+      if (IsIntersect(b, window)) expected.push_back(b);
+    }
+
+    EXPECT_THAT(h.QueryIntersects(top, window),
+                UnorderedElementsAreArray(expected));
+  }
+}
+
+}  // namespace moab
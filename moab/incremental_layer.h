@@ -0,0 +1,205 @@
+#ifndef MOAB_INCREMENTAL_LAYER_H_
+#define MOAB_INCREMENTAL_LAYER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
+#include "absl/log/check.h"
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/parallel.h"
+#include "moab/rectilinear_grid.h"
+#include "moab/rtree.h"
+
+namespace moab {
+
+namespace gtl = boost::polygon;
+
+// A derived layer, result = a op b, that is kept up to date under edits of
+// its input layers a and b.
+//
+// The plane is cut into square tiles of tile_size. The result is stored per
+// tile, clipped to the tile. Inserting or removing an input shape only marks
+// the tiles it covers as dirty; Update() recomputes the boolean for the dirty
+// tiles alone, from the input shapes that intersect them, and keeps every
+// other tile as is. An edit therefore costs time proportional to the area it
+// touches rather than to the layer size.
+template <typename T>
+class IncrementalLayer {
+  static_assert(std::is_integral_v<T>, "Coordinates must be integral.");
+
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+  using tile_type = std::pair<int64_t, int64_t>;
+
+  // Input layers.
+  enum class Operand { kA, kB };
+
+  // Constructors.
+  explicit IncrementalLayer(BooleanOp op, T tile_size,
+                            std::size_t num_threads = 0)
+      : op_(op), tile_size_(tile_size), num_threads_(num_threads) {
+    CHECK(tile_size > 0) << "Tile size must be positive. tile_size: "
+                         << tile_size;
+  }
+  IncrementalLayer(const IncrementalLayer&) = default;
+  IncrementalLayer(IncrementalLayer&&) = default;
+  ~IncrementalLayer() = default;
+
+  // Assignment operators.
+  IncrementalLayer& operator=(const IncrementalLayer&) = default;
+  IncrementalLayer& operator=(IncrementalLayer&&) = default;
+
+  // Accessors.
+  BooleanOp Op() const { return op_; }
+  T TileSize() const { return tile_size_; }
+  std::size_t NumShapes() const { return shapes_.size(); }
+  std::size_t NumDirtyTiles() const { return dirty_.size(); }
+  // Returns the box of a tile.
+  Box2<T> TileBox(const tile_type& tile) const {
+    return Box2<T>(static_cast<T>(tile.first * tile_size_),
+                   static_cast<T>(tile.second * tile_size_),
+                   static_cast<T>((tile.first + 1) * tile_size_),
+                   static_cast<T>((tile.second + 1) * tile_size_));
+  }
+  // Returns the result as non-overlapping boxes, split at tile borders.
+  // Update() must have been called after the last edit.
+  std::vector<Box2<T>> Result() const;
+
+  // Mutators.
+  // Inserts a Box2, a rectilinear ring, or a polygon set into an input layer.
+  // Returns the id of the new shape.
+  template <typename Geometry>
+  std::size_t Insert(Operand operand, const Geometry& g);
+  // Removes a shape by id. Returns false if there is no such shape.
+  bool Remove(std::size_t id);
+  // Recomputes the dirty tiles.
+  void Update();
+
+ private:
+  struct Shape {
+    Operand operand;
+    std::vector<Box2<T>> boxes;
+  };
+  using rtree_type = Rtree<std::pair<Box2<T>, std::size_t>>;
+
+  static int64_t FloorDiv(int64_t a, int64_t b) {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+  }
+  // Marks the tiles covered by b as dirty.
+  void MarkDirty(const Box2<T>& b);
+  // Computes the result of one tile.
+  std::vector<Box2<T>> ComputeTile(const tile_type& tile) const;
+
+  BooleanOp op_;
+  T tile_size_;
+  std::size_t num_threads_;
+  std::size_t next_id_ = 0;
+  absl::flat_hash_map<std::size_t, Shape> shapes_;
+  rtree_type inputs_[2];
+  absl::flat_hash_map<tile_type, std::vector<Box2<T>>> tiles_;
+  absl::flat_hash_set<tile_type> dirty_;
+};
+
+template <typename T>
+template <typename Geometry>
+std::size_t IncrementalLayer<T>::Insert(Operand operand, const Geometry& g) {
+  const std::size_t id = next_id_++;
+  Shape& shape = shapes_[id];
+  shape.operand = operand;
+  shape.boxes = ToBoxes<T>(g);
+  rtree_type& input = inputs_[static_cast<int>(operand)];
+  for (const Box2<T>& b : shape.boxes) {
+    input.Insert(b, id);
+    MarkDirty(b);
+  }
+  return id;
+}
+
+template <typename T>
+bool IncrementalLayer<T>::Remove(std::size_t id) {
+  auto it = shapes_.find(id);
+  if (it == shapes_.end()) return false;
+  rtree_type& input = inputs_[static_cast<int>(it->second.operand)];
+  for (const Box2<T>& b : it->second.boxes) {
+    input.Remove(std::make_pair(b, id));
+    MarkDirty(b);
+  }
+  shapes_.erase(it);
+  return true;
+}
+
+template <typename T>
+void IncrementalLayer<T>::MarkDirty(const Box2<T>& b) {
+  if (b.Width() == 0 || b.Height() == 0) return;
+  const int64_t x0 = FloorDiv(b.xl(), tile_size_);
+  const int64_t x1 = FloorDiv(static_cast<int64_t>(b.xh()) - 1, tile_size_);
+  const int64_t y0 = FloorDiv(b.yl(), tile_size_);
+  const int64_t y1 = FloorDiv(static_cast<int64_t>(b.yh()) - 1, tile_size_);
+  for (int64_t x = x0; x <= x1; ++x) {
+    for (int64_t y = y0; y <= y1; ++y) dirty_.emplace(x, y);
+  }
+}
+
+template <typename T>
+std::vector<Box2<T>> IncrementalLayer<T>::ComputeTile(
+    const tile_type& tile) const {
+  const Box2<T> window = TileBox(tile);
+  gtl::polygon_90_set_data<T> sets[2];
+  for (int i = 0; i < 2; ++i) {
+    for (const auto& [b, id] : inputs_[i].QueryIntersects(window)) {
+      const Box2<T> clipped(std::max(b.xl(), window.xl()),
+                            std::max(b.yl(), window.yl()),
+                            std::min(b.xh(), window.xh()),
+                            std::min(b.yh(), window.yh()));
+      if (clipped.Width() > 0 && clipped.Height() > 0) sets[i].insert(clipped);
+    }
+  }
+  BooleanSet(sets[0], sets[1], op_);
+  std::vector<Box2<T>> boxes;
+  Assign(boxes, sets[0]);
+  return boxes;
+}
+
+template <typename T>
+void IncrementalLayer<T>::Update() {
+  if (dirty_.empty()) return;
+  const std::vector<tile_type> dirty(dirty_.begin(), dirty_.end());
+  std::vector<std::vector<Box2<T>>> results(dirty.size());
+  ParallelFor(dirty.size(), num_threads_,
+              [&](std::size_t i) { results[i] = ComputeTile(dirty[i]); });
+  for (std::size_t i = 0; i < dirty.size(); ++i) {
+    if (results[i].empty()) {
+      tiles_.erase(dirty[i]);
+    } else {
+      tiles_[dirty[i]] = std::move(results[i]);
+    }
+  }
+  dirty_.clear();
+}
+
+template <typename T>
+std::vector<Box2<T>> IncrementalLayer<T>::Result() const {
+  CHECK(dirty_.empty()) << "Call Update() after editing the inputs.";
+  std::vector<Box2<T>> boxes;
+  for (const auto& [tile, tile_boxes] : tiles_) {
+    boxes.insert(boxes.end(), tile_boxes.begin(), tile_boxes.end());
+  }
+  return boxes;
+}
+
+// Aliases.
+using IncrementalLayer_i = IncrementalLayer<int>;
+using IncrementalLayer_i32 = IncrementalLayer<int32_t>;
+using IncrementalLayer_i64 = IncrementalLayer<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_INCREMENTAL_LAYER_H_
@@ -0,0 +1,130 @@
+#include "incremental_layer.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::UnorderedElementsAre;
+
+TEST(IncrementalLayer, Empty) {
+  IncrementalLayer_i layer(BooleanOp::kUnion, 100);
+  layer.Update();
+
+  EXPECT_THAT(layer.Result(), UnorderedElementsAre());
+}
+
+TEST(IncrementalLayer, TileBox) {
+  IncrementalLayer_i layer(BooleanOp::kUnion, 100);
+
+  EXPECT_EQ(layer.TileBox({0, 0}), Box2_i(0, 0, 100, 100));
+  EXPECT_EQ(layer.TileBox({-1, 2}), Box2_i(-100, 200, 0, 300));
+}
+
+TEST(IncrementalLayer, MarksCoveredTilesDirty) {
+  IncrementalLayer_i layer(BooleanOp::kSubtract, 100);
+  layer.Insert(IncrementalLayer_i::Operand::kA, Box2_i(10, 10, 20, 20));
+
+  EXPECT_EQ(layer.NumDirtyTiles(), 1);
+
+  // Ends exactly at the tile border, so it covers tiles x = -1 and x = 0.
+  layer.Insert(IncrementalLayer_i::Operand::kB, Box2_i(-5, 10, 100, 20));
+
+  EXPECT_EQ(layer.NumDirtyTiles(), 2);
+
+  layer.Update();
+
+  EXPECT_EQ(layer.NumDirtyTiles(), 0);
+  EXPECT_THAT(layer.Result(), UnorderedElementsAre());
+}
+
+TEST(IncrementalLayer, Subtract) {
+  IncrementalLayer_i layer(BooleanOp::kSubtract, 100);
+  layer.Insert(IncrementalLayer_i::Operand::kA, Box2_i(0, 0, 50, 50));
+  const std::size_t hole =
+      layer.Insert(IncrementalLayer_i::Operand::kB, Box2_i(0, 0, 50, 25));
+  layer.Update();
+
+  EXPECT_THAT(layer.Result(), UnorderedElementsAre(Box2_i(0, 25, 50, 50)));
+
+  EXPECT_TRUE(layer.Remove(hole));
+  EXPECT_FALSE(layer.Remove(hole));
+  layer.Update();
+
+  EXPECT_THAT(layer.Result(), UnorderedElementsAre(Box2_i(0, 0, 50, 50)));
+}
+
+TEST(IncrementalLayer, Ring) {
+  Ring2_i r = {Point2_i(0, 0),     Point2_i(150, 0), Point2_i(150, 150),
+               Point2_i(100, 150), Point2_i(100, 50), Point2_i(0, 50),
+               Point2_i(0, 0)};
+  IncrementalLayer_i layer(BooleanOp::kUnion, 100);
+  layer.Insert(IncrementalLayer_i::Operand::kA, r);
+  layer.Update();
+
+  EXPECT_TRUE(Equivalence(layer.Result(), std::vector<Ring2_i>{r}));
+  EXPECT_EQ(Area(layer.Result()), r.Area());
+}
+
+// Edits both inputs at random and compares with a boolean from scratch.
+void CheckRandomEdits(BooleanOp op, std::size_t num_threads) {
+  std::mt19937 gen(31);
+  std::uniform_int_distribution<int> pos(-300, 300);
+  std::uniform_int_distribution<int> size(1, 120);
+  std::uniform_int_distribution<int> coin(0, 2);
+  IncrementalLayer_i layer(op, 64, num_threads);
+  std::vector<std::pair<std::size_t, Box2_i>> shapes[2];
+  for (int step = 0; step < 20; ++step) {
+    for (int e = 0; e < 5; ++e) {
+      const int operand = coin(gen) % 2;
+      if (coin(gen) == 0 && !shapes[operand].empty()) {
+        layer.Remove(shapes[operand].back().first);
+        shapes[operand].pop_back();
+      } else {
+        int x = pos(gen), y = pos(gen);
+        Box2_i b(x, y, x + size(gen), y + size(gen));
+        std::size_t id = layer.Insert(
+            static_cast<IncrementalLayer_i::Operand>(operand), b);
+        shapes[operand].emplace_back(id, b);
+      }
+    }
+    layer.Update();
+
+    std::vector<Box2_i> a, b;
+    for (const auto& [id, box] : shapes[0]) a.push_back(box);
+    for (const auto& [id, box] : shapes[1]) b.push_back(box);
+    std::vector<Box2_i> expected;
+    Assign(expected, a);
+    BooleanSet(expected, b, op);
+    std::vector<Box2_i> result = layer.Result();
+
+    EXPECT_TRUE(Equivalence(result, expected)) << "step: " << step;
+    EXPECT_EQ(Area(result), Area(expected)) << "step: " << step;
+  }
+}
+
+TEST(IncrementalLayer, RandomUnion) {
+  CheckRandomEdits(BooleanOp::kUnion, 1);
+}
+
+TEST(IncrementalLayer, RandomIntersection) {
+  CheckRandomEdits(BooleanOp::kIntersection, 1);
+}
+
+TEST(IncrementalLayer, RandomDisjointUnion) {
+  CheckRandomEdits(BooleanOp::kDisjointUnion, 4);
+}
+
+TEST(IncrementalLayer, RandomSubtract) {
+  CheckRandomEdits(BooleanOp::kSubtract, 4);
+}
+
+}  // namespace moab
@@ -3,6 +3,7 @@
 
 #include <array>
 #include <cstdint>
+#include <type_traits>
 
 #include "absl/log/check.h"
 #include "absl/strings/str_cat.h"
@@ -19,8 +20,8 @@ class Interval {
   using coordinate_type = T;
 
   // Constructors.
-  Interval() : d_({0, 0}) {}
-  explicit Interval(T lo, T hi) : d_() { Set(lo, hi); }
+  constexpr Interval() noexcept : d_({0, 0}) {}
+  constexpr explicit Interval(T lo, T hi) noexcept : d_() { Set(lo, hi); }
   Interval(const Interval& i) = default;
   Interval(Interval&& i) = default;
   ~Interval() = default;
@@ -29,73 +30,81 @@ class Interval {
   Interval& operator=(const Interval&) = default;
   Interval& operator=(Interval&&) = default;
   // Accessors.
-  T lo() const { return d_[0]; }
-  T hi() const { return d_[1]; }
-  T* data() { return d_.data(); }
-  const T* data() const { return d_.data(); }
+  constexpr T lo() const noexcept { return d_[0]; }
+  constexpr T hi() const noexcept { return d_[1]; }
+  constexpr T* data() noexcept { return d_.data(); }
+  constexpr const T* data() const noexcept { return d_.data(); }
 
-  T Min() const { return d_[0]; }
-  T Max() const { return d_[1]; }
+  constexpr T Min() const noexcept { return d_[0]; }
+  constexpr T Max() const noexcept { return d_[1]; }
 
-  T Length() const { return d_[1] - d_[0]; }
-  T Size() const { return d_[1] - d_[0]; }
+  constexpr T Length() const noexcept { return d_[1] - d_[0]; }
+  constexpr T Size() const noexcept { return d_[1] - d_[0]; }
 
   // Mutators.
-  void Set(T lo, T hi) {
+  constexpr void Set(T lo, T hi) noexcept {
     // Ensure the interval is valid. Automatically swap if lo > hi.
     d_[0] = lo < hi ? lo : hi;
     d_[1] = lo < hi ? hi : lo;
   }
 
-  void set_lo(T v) { Set(v, hi()); }
-  void set_hi(T v) { Set(lo(), v); }
+  constexpr void set_lo(T v) noexcept { Set(v, hi()); }
+  constexpr void set_hi(T v) noexcept { Set(lo(), v); }
 
-  void SetMin(T v) { Set(v, hi()); }
-  void SetMax(T v) { Set(lo(), v); }
+  constexpr void SetMin(T v) noexcept { Set(v, hi()); }
+  constexpr void SetMax(T v) noexcept { Set(lo(), v); }
 
   // Queries.
-  bool Contains(T v) const { return lo() <= v && v <= hi(); }
-  bool Contains(const Interval& i) const {
+  constexpr bool Contains(T v) const noexcept { return lo() <= v && v <= hi(); }
+  constexpr bool Contains(const Interval& i) const noexcept {
     return lo() <= i.lo() && i.hi() <= hi();
   }
 
   // Operations.
-  void Shift(T d) {
+  constexpr void Shift(T d) noexcept {
     d_[0] += d;
     d_[1] += d;
   }
 
   // Operators.
   // Operators - Subscript.
-  T& operator[](std::size_t i) { return d_[i]; }
-  const T& operator[](std::size_t i) const { return d_.at(i); }
+  constexpr T& operator[](std::size_t i) noexcept { return d_[i]; }
+  constexpr const T& operator[](std::size_t i) const noexcept { return d_[i]; }
   // Operators - Equality.
-  bool operator==(const Interval& i) const {
+  constexpr bool operator==(const Interval& i) const noexcept {
     return d_[0] == i.d_[0] && d_[1] == i.d_[1];
   }
-  bool operator!=(const Interval& i) const { return !(*this == i); }
+  constexpr bool operator!=(const Interval& i) const noexcept {
+    return !(*this == i);
+  }
   // Operators - Inequality.
-  bool operator<(const Interval& i) const {
+  constexpr bool operator<(const Interval& i) const noexcept {
     return d_[0] != i.d_[0] ? d_[0] < i.d_[0] : d_[1] < i.d_[1];
   }
-  bool operator>(const Interval& i) const { return i < *this; }
-  bool operator<=(const Interval& i) const { return !(*this > i); }
-  bool operator>=(const Interval& i) const { return !(*this < i); }
+  constexpr bool operator>(const Interval& i) const noexcept {
+    return i < *this;
+  }
+  constexpr bool operator<=(const Interval& i) const noexcept {
+    return !(*this > i);
+  }
+  constexpr bool operator>=(const Interval& i) const noexcept {
+    return !(*this < i);
+  }
   // Operators - Arithmetic.
-  Interval& operator+=(T d) {
+  constexpr Interval& operator+=(T d) noexcept {
     Shift(d);
     return *this;
   }
-  Interval& operator-=(T d) {
+  constexpr Interval& operator-=(T d) noexcept {
     Shift(-d);
     return *this;
   }
-  Interval operator+(T d) const {
+  constexpr Interval operator+(T d) const noexcept {
     Interval i(*this);
     i += d;
     return i;
   }
-  Interval operator-(T d) const {
+  constexpr Interval operator-(T d) const noexcept {
     Interval i(*this);
     i -= d;
     return i;
@@ -126,6 +135,10 @@ using Interval_i = Interval<int>;
 using Interval_i32 = Interval<int32_t>;
 using Interval_i64 = Interval<int64_t>;
 
+static_assert(std::is_trivially_copyable_v<Interval_i>);
+static_assert(std::is_nothrow_default_constructible_v<Interval_i>);
+static_assert(Interval_i(1, 3).Contains(2));
+
 }  // namespace moab
 
 // Boost polygon traits.
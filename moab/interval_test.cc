@@ -90,6 +90,7 @@ TEST(Accessors, Length) {
   Interval_i i(1, 5);
 
   EXPECT_EQ(i.Length(), 4);
+  static_assert(Interval_i(1, 5).Length() == 4);
 }
 
 TEST(Accessors, Size) {
@@ -0,0 +1,427 @@
+#ifndef MOAB_MAX_RECTANGLES_H_
+#define MOAB_MAX_RECTANGLES_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/interval.h"
+#include "moab/point2.h"
+#include "moab/rectilinear_grid.h"
+
+namespace moab {
+
+namespace max_rectangles_internal {
+
+// The x spans covered by a band of a rectilinear region, sorted, disjoint and
+// not touching.
+template <typename T>
+using Spans = std::vector<Interval<T>>;
+
+// Returns the first span of l that ends at or after x.
+template <typename T>
+typename Spans<T>::const_iterator FirstEndingAfter(const Spans<T>& l, T x) {
+  return std::lower_bound(
+      l.begin(), l.end(), x,
+      [](const Interval<T>& s, T v) { return s.hi() < v; });
+}
+
+// Returns true if [x0, x1] lies inside one span of l.
+template <typename T>
+bool Covers(const Spans<T>& l, T x0, T x1) {
+  auto it = FirstEndingAfter(l, x1);
+  return it != l.end() && it->lo() <= x0;
+}
+
+// Appends the components of [x0, x1] ∩ l that have positive length.
+template <typename T>
+void AppendIntersection(const Spans<T>& l, T x0, T x1, Spans<T>& out) {
+  for (auto it = FirstEndingAfter(l, x0); it != l.end() && it->lo() < x1;
+       ++it) {
+    const T lo = std::max(it->lo(), x0);
+    const T hi = std::min(it->hi(), x1);
+    if (lo < hi) out.push_back(Interval<T>(lo, hi));
+  }
+}
+
+// Adds [x0, x1] to l, merging the spans it touches.
+template <typename T>
+void AddSpan(Spans<T>& l, T x0, T x1) {
+  auto first = std::lower_bound(
+      l.begin(), l.end(), x0,
+      [](const Interval<T>& s, T v) { return s.hi() < v; });
+  auto last = std::upper_bound(
+      first, l.end(), x1, [](T v, const Interval<T>& s) { return v < s.lo(); });
+  if (first != last) {
+    x0 = std::min(x0, first->lo());
+    x1 = std::max(x1, std::prev(last)->hi());
+  }
+  l.insert(l.erase(first, last), Interval<T>(x0, x1));
+}
+
+// Removes the open span (x0, x1) from l.
+template <typename T>
+void SubtractSpan(Spans<T>& l, T x0, T x1) {
+  auto first = std::upper_bound(
+      l.begin(), l.end(), x0,
+      [](T v, const Interval<T>& s) { return v < s.hi(); });
+  auto last = std::lower_bound(
+      first, l.end(), x1,
+      [](const Interval<T>& s, T v) { return s.lo() < v; });
+  if (first == last) return;
+  Spans<T> rest;
+  if (first->lo() < x0) rest.push_back(Interval<T>(first->lo(), x0));
+  if (x1 < std::prev(last)->hi()) {
+    rest.push_back(Interval<T>(x1, std::prev(last)->hi()));
+  }
+  l.insert(l.erase(first, last), rest.begin(), rest.end());
+}
+
+}  // namespace max_rectangles_internal
+
+// Enumerates the maximal rectangles of a rectilinear region, i.e., the boxes
+// inside the region that cannot be extended in any direction.
+//
+// The region is held as bands: the y coordinates where the region changes,
+// each with the x spans covered up to the next one. Memory is the total number
+// of spans over the bands, so it does not depend on the number of distinct x
+// (it grows quadratically only for staggered shapes such as a comb whose
+// teeth all end at different y). Enumeration descends from each band through
+// the bands below it, following only the spans that can still bound a
+// maximal rectangle, so each visited span belongs to the column of a reported
+// rectangle and costs O(log n), instead of a pass over every grid cell.
+//
+// The engine supports incremental updates: Add(), Subtract() and MoveEdge()
+// rewrite only the bands that the changed box spans, and only the rectangles
+// that touch it are recomputed. Rectangles that do not touch it are still
+// maximal and are kept as is.
+//
+// In bounded mode (min_width / min_height > 0), only rectangles at least
+// min_width wide and min_height tall are reported.
+template <typename T>
+class MaxRectangleEngine {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // Constructors.
+  MaxRectangleEngine() = default;
+  // Builds the engine from boxes. Overlapping boxes are allowed.
+  explicit MaxRectangleEngine(const std::vector<Box2<T>>& boxes,
+                              T min_width = 0, T min_height = 0)
+      : min_width_(min_width), min_height_(min_height) {
+    Build(ToBoxes<T>(boxes));
+  }
+  MaxRectangleEngine(const MaxRectangleEngine&) = default;
+  MaxRectangleEngine(MaxRectangleEngine&&) = default;
+  ~MaxRectangleEngine() = default;
+
+  // Assignment operators.
+  MaxRectangleEngine& operator=(const MaxRectangleEngine&) = default;
+  MaxRectangleEngine& operator=(MaxRectangleEngine&&) = default;
+
+  // Builds the engine from a Box2, a rectilinear ring or polygon with holes,
+  // or a polygon set (e.g., a std::vector of Box2, Ring2 or Polygon2).
+  template <typename Geometry>
+  static MaxRectangleEngine FromGeometry(const Geometry& g, T min_width = 0,
+                                         T min_height = 0) {
+    MaxRectangleEngine engine;
+    engine.min_width_ = min_width;
+    engine.min_height_ = min_height;
+    engine.Build(ToBoxes<T>(g));
+    return engine;
+  }
+
+  // Accessors.
+  // Returns the current maximal rectangles (in no particular order).
+  const std::vector<Box2<T>>& Rectangles() const { return rects_; }
+  T MinWidth() const { return min_width_; }
+  T MinHeight() const { return min_height_; }
+
+  // Mutators.
+  // Adds (subtracts) b to (from) the region and updates the rectangles.
+  void Add(const Box2<T>& b) { Update(b, true); }
+  void Subtract(const Box2<T>& b) { Update(b, false); }
+  // Moves edge i (from ring[i] to ring[i + 1]) of a closed rectilinear ring to
+  // the given coordinate, i.e., to y = coord for a horizontal edge and x =
+  // coord for a vertical edge. The ring is updated in place and must be the
+  // ring this engine was built from. The moved edge must not sweep over any
+  // other part of the ring.
+  template <typename Ring>
+  void MoveEdge(Ring& ring, std::size_t i, T coord);
+
+ private:
+  using Spans = max_rectangles_internal::Spans<T>;
+  // Band bottom y -> spans covered up to the next key. The last band is
+  // always empty and only marks the top of the region.
+  using Bands = std::map<T, Spans>;
+  using BandIterator = typename Bands::const_iterator;
+
+  // Builds the bands from the horizontal slabs of the region (see
+  // HorizontalSlabs) and enumerates the rectangles.
+  void Build(const std::vector<Box2<T>>& slabs);
+  void Update(const Box2<T>& b, bool add);
+  // Makes y a band boundary.
+  void Split(T y);
+  // Merges equal neighboring bands from first up to and including last, and
+  // drops empty bands at the bottom.
+  void Coalesce(T first, T last);
+  // Appends the maximal rectangles to out. If window is not null, only the
+  // rectangles intersecting the (closed) window are appended.
+  void Enumerate(const Box2<T>* window, std::vector<Box2<T>>& out) const;
+  // Appends the maximal rectangles whose top is the top of band `top`,
+  // descending from the spans of roots, which are the components of the
+  // intersection of the bands from `level` up to `top`.
+  void Descend(BandIterator top, BandIterator level, const Spans& roots,
+               const Box2<T>* window, std::vector<Box2<T>>& out) const;
+
+  Bands bands_;
+  T min_width_ = 0;
+  T min_height_ = 0;
+  std::vector<Box2<T>> rects_;
+};
+
+template <typename T>
+void MaxRectangleEngine<T>::Build(const std::vector<Box2<T>>& slabs) {
+  namespace internal = max_rectangles_internal;
+  // Sweeps the slab bottoms and tops upward, taking a snapshot of the covered
+  // spans at each y. Slabs that end at y are removed before those that start
+  // there are added, as they may touch.
+  std::vector<std::pair<T, const Box2<T>*>> events;
+  for (const Box2<T>& b : slabs) {
+    events.emplace_back(b.yl(), &b);
+    events.emplace_back(b.yh(), &b);
+  }
+  std::sort(events.begin(), events.end(),
+            [](const auto& a, const auto& b) { return a.first < b.first; });
+  Spans spans;
+  for (std::size_t first = 0, e = 0; first < events.size(); first = e) {
+    const T y = events[first].first;
+    for (e = first; e < events.size() && events[e].first == y; ++e) {
+      const Box2<T>& b = *events[e].second;
+      if (b.yh() == y) internal::SubtractSpan(spans, b.xl(), b.xh());
+    }
+    for (std::size_t k = first; k < e; ++k) {
+      const Box2<T>& b = *events[k].second;
+      if (b.yl() == y) internal::AddSpan(spans, b.xl(), b.xh());
+    }
+    if (bands_.empty() || bands_.rbegin()->second != spans) {
+      bands_.emplace_hint(bands_.end(), y, spans);
+    }
+  }
+  Enumerate(nullptr, rects_);
+}
+
+template <typename T>
+void MaxRectangleEngine<T>::Split(T y) {
+  auto it = bands_.upper_bound(y);
+  if (it == bands_.begin()) {
+    bands_.emplace_hint(it, y, Spans());
+  } else if (std::prev(it)->first != y) {
+    bands_.emplace_hint(it, y, std::prev(it)->second);
+  }
+}
+
+template <typename T>
+void MaxRectangleEngine<T>::Coalesce(T first, T last) {
+  auto it = bands_.lower_bound(first);
+  if (it != bands_.begin()) --it;
+  const auto end = bands_.upper_bound(last);
+  while (it != end && std::next(it) != end) {
+    auto next = std::next(it);
+    if (next->second == it->second) {
+      bands_.erase(next);
+    } else {
+      it = next;
+    }
+  }
+  while (!bands_.empty() && bands_.begin()->second.empty()) {
+    bands_.erase(bands_.begin());
+  }
+}
+
+template <typename T>
+void MaxRectangleEngine<T>::Descend(BandIterator top, BandIterator level,
+                                    const Spans& roots, const Box2<T>* window,
+                                    std::vector<Box2<T>>& out) const {
+  // A node is a component [x0, x1] of the intersection of the bands from
+  // `band` up to `top`, so its rectangle is left and right maximal. It is
+  // maximal if it can grow neither up into the band above `top` nor down
+  // into the band below `band`. Its children are the components of its
+  // intersection with the band below, which are narrower or the same, so
+  // nodes that can grow up, are too narrow or miss the window are dropped
+  // with their subtrees.
+  struct Node {
+    Interval<T> span;
+    BandIterator band;
+  };
+  const T yh = std::next(top)->first;
+  const Spans& above = std::next(top)->second;
+  std::vector<Node> stack;
+  for (const Interval<T>& s : roots) stack.push_back({s, level});
+  Spans below;
+  while (!stack.empty()) {
+    const Node node = stack.back();
+    stack.pop_back();
+    const T x0 = node.span.lo(), x1 = node.span.hi();
+    if (x1 - x0 < min_width_) continue;
+    if (max_rectangles_internal::Covers(above, x0, x1)) continue;
+    if (window != nullptr && (x1 < window->xl() || x0 > window->xh())) {
+      continue;
+    }
+    if (node.band == bands_.begin()) {
+      if (yh - node.band->first >= min_height_) {
+        out.push_back(Box2<T>(x0, node.band->first, x1, yh));
+      }
+      continue;
+    }
+    const BandIterator next = std::prev(node.band);
+    if (!max_rectangles_internal::Covers(next->second, x0, x1) &&
+        yh - node.band->first >= min_height_) {
+      out.push_back(Box2<T>(x0, node.band->first, x1, yh));
+    }
+    below.clear();
+    max_rectangles_internal::AppendIntersection(next->second, x0, x1, below);
+    for (const Interval<T>& s : below) stack.push_back({s, next});
+  }
+}
+
+template <typename T>
+void MaxRectangleEngine<T>::Enumerate(const Box2<T>* window,
+                                      std::vector<Box2<T>>& out) const {
+  namespace internal = max_rectangles_internal;
+  if (bands_.empty()) return;
+  const BandIterator last = std::prev(bands_.end());
+  if (window == nullptr) {
+    for (BandIterator t = bands_.begin(); t != last; ++t) {
+      Descend(t, t, t->second, nullptr, out);
+    }
+    return;
+  }
+  if (window->yh() < bands_.begin()->first || window->yl() > last->first) {
+    return;
+  }
+  // Bands whose top is at or above the window bottom, up to the band that
+  // holds the window top: every maximal rectangle with such a top and a span
+  // touching the window touches it.
+  BandIterator t = bands_.lower_bound(window->yl());
+  if (t != bands_.begin()) --t;
+  BandIterator k0 = std::prev(bands_.upper_bound(window->yh()));
+  if (k0 == last) --k0;
+  for (;; ++t) {
+    Descend(t, t, t->second, window, out);
+    if (t == k0) break;
+  }
+  // Higher tops only touch the window through the spans that stay covered
+  // from band k0 up, which are tracked band by band while any is left.
+  Spans columns;
+  for (const Interval<T>& s : k0->second) {
+    if (s.hi() >= window->xl() && s.lo() <= window->xh()) columns.push_back(s);
+  }
+  Spans next;
+  for (t = std::next(k0); t != last && !columns.empty(); ++t) {
+    next.clear();
+    for (const Interval<T>& s : columns) {
+      internal::AppendIntersection(t->second, s.lo(), s.hi(), next);
+    }
+    columns.clear();
+    for (const Interval<T>& s : next) {
+      if (s.hi() >= window->xl() && s.lo() <= window->xh()) {
+        columns.push_back(s);
+      }
+    }
+    Descend(t, k0, columns, window, out);
+  }
+}
+
+template <typename T>
+void MaxRectangleEngine<T>::Update(const Box2<T>& b, bool add) {
+  namespace internal = max_rectangles_internal;
+  if (b.Width() == 0 || b.Height() == 0) return;
+  Split(b.yl());
+  Split(b.yh());
+  for (auto it = bands_.find(b.yl()); it->first != b.yh(); ++it) {
+    if (add) {
+      internal::AddSpan(it->second, b.xl(), b.xh());
+    } else {
+      internal::SubtractSpan(it->second, b.xl(), b.xh());
+    }
+  }
+  Coalesce(b.yl(), b.yh());
+  // A rectangle that does not touch b has the same neighborhood before and
+  // after the update, so it is maximal in the old region iff it is maximal in
+  // the new one.
+  auto touches = [&b](const Box2<T>& r) {
+    return !(r.xh() < b.xl() || r.xl() > b.xh() || r.yh() < b.yl() ||
+             r.yl() > b.yh());
+  };
+  rects_.erase(std::remove_if(rects_.begin(), rects_.end(), touches),
+               rects_.end());
+  Enumerate(&b, rects_);
+}
+
+template <typename T>
+template <typename Ring>
+void MaxRectangleEngine<T>::MoveEdge(Ring& ring, std::size_t i, T coord) {
+  const std::size_t n = ring.Size();
+  CHECK(n >= 5 && ring[0] == ring[n - 1]) << "Ring must be closed.";
+  CHECK(i + 1 < n) << "Invalid edge index. i: " << i;
+  // Orientation from the signed area (twice the area, shoelace formula).
+  int64_t area2 = 0;
+  for (std::size_t k = 0; k + 1 < n; ++k) {
+    area2 += static_cast<int64_t>(ring[k].x()) * ring[k + 1].y() -
+             static_cast<int64_t>(ring[k + 1].x()) * ring[k].y();
+  }
+  const int ccw = area2 > 0 ? 1 : -1;
+  Point2<T> p0 = ring[i];
+  Point2<T> p1 = ring[i + 1];
+  const bool horizontal = p0.y() == p1.y();
+  CHECK(horizontal || p0.x() == p1.x()) << "Edge must be axis-parallel.";
+  // The interior lies to the left of the edge for a counterclockwise ring.
+  int interior_side;
+  T old_coord;
+  Box2<T> swept;
+  if (horizontal) {
+    interior_side = (p1.x() > p0.x() ? 1 : -1) * ccw;
+    old_coord = p0.y();
+    swept = Box2<T>(p0.x(), old_coord, p1.x(), coord);
+    p0.SetY(coord);
+    p1.SetY(coord);
+  } else {
+    interior_side = (p1.y() > p0.y() ? -1 : 1) * ccw;
+    old_coord = p0.x();
+    swept = Box2<T>(old_coord, p0.y(), coord, p1.y());
+    p0.SetX(coord);
+    p1.SetX(coord);
+  }
+  ring.SetPoint(i, p0);
+  ring.SetPoint(i + 1, p1);
+  // Keep the closing point in sync.
+  if (i == 0) ring.SetPoint(n - 1, p0);
+  if (i + 1 == n - 1) ring.SetPoint(0, p1);
+  if (coord == old_coord) return;
+  const int direction = coord > old_coord ? 1 : -1;
+  Update(swept, direction != interior_side);
+}
+
+// Returns the maximal rectangles of a Box2, a rectilinear ring, or a polygon
+// set. Only rectangles at least min_width wide and min_height tall are
+// returned.
+template <typename Geometry>
+std::vector<Box2<coordinate_of_t<Geometry>>> MaxRectangles(
+    const Geometry& g, coordinate_of_t<Geometry> min_width = 0,
+    coordinate_of_t<Geometry> min_height = 0) {
+  using T = coordinate_of_t<Geometry>;
+  return MaxRectangleEngine<T>::FromGeometry(g, min_width, min_height)
+      .Rectangles();
+}
+
+}  // namespace moab
+
+#endif  // MOAB_MAX_RECTANGLES_H_
@@ -0,0 +1,246 @@
+#include "max_rectangles.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/polygon2.h"
+#include "moab/rectilinear_grid.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+// Reference result from Boost.
+std::vector<Box2_i> ReferenceMaxRectangles(const std::vector<Box2_i>& boxes) {
+  std::vector<Box2_i> result;
+  boost::polygon::polygon_90_set_data<int> ps;
+  ps.insert(boxes.begin(), boxes.end());
+  boost::polygon::get_max_rectangles(result, ps);
+  return result;
+}
+
+std::vector<Box2_i> RandomBoxes(std::mt19937& gen, int n, int range,
+                                int max_size) {
+  std::uniform_int_distribution<int> pos(0, range);
+  std::uniform_int_distribution<int> size(1, max_size);
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < n; ++i) {
+    int x = pos(gen), y = pos(gen);
+    boxes.push_back(Box2_i(x, y, x + size(gen), y + size(gen)));
+  }
+  return boxes;
+}
+
+TEST(MaxRectangles, Empty) {
+  EXPECT_THAT(MaxRectangles(std::vector<Box2_i>()), UnorderedElementsAre());
+}
+
+TEST(MaxRectangles, Box) {
+  EXPECT_THAT(MaxRectangles(Box2_i(0, 0, 10, 20)),
+              UnorderedElementsAre(Box2_i(0, 0, 10, 20)));
+}
+
+TEST(MaxRectangles, LShape) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+
+  EXPECT_THAT(MaxRectangles(r), UnorderedElementsAre(Box2_i(20, 0, 40, 40),
+                                                     Box2_i(0, 0, 40, 20)));
+}
+
+TEST(MaxRectangles, Cross) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 10, 30, 20), Box2_i(10, 0, 20, 30)};
+
+  EXPECT_THAT(MaxRectangles(boxes), UnorderedElementsAre(Box2_i(0, 10, 30, 20),
+                                                         Box2_i(10, 0, 20, 30)));
+}
+
+TEST(MaxRectangles, Hole) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 30, 10), Box2_i(0, 20, 30, 30),
+                               Box2_i(0, 0, 10, 30), Box2_i(20, 0, 30, 30)};
+
+  EXPECT_THAT(MaxRectangles(boxes),
+              UnorderedElementsAreArray(ReferenceMaxRectangles(boxes)));
+  EXPECT_EQ(MaxRectangles(boxes).size(), 4);
+}
+
+TEST(MaxRectangles, RingSet) {
+  // A clockwise L-shape next to a box.
+  std::vector<Ring2_i> rings = {
+      Ring2_i({Point2_i(0, 0), Point2_i(0, 20), Point2_i(20, 20),
+               Point2_i(20, 40), Point2_i(40, 40), Point2_i(40, 0),
+               Point2_i(0, 0)}),
+      Ring2_i(Box2_i(40, 10, 60, 30))};
+
+  EXPECT_THAT(MaxRectangles(rings),
+              UnorderedElementsAre(Box2_i(0, 0, 40, 20), Box2_i(20, 0, 40, 40),
+                                   Box2_i(20, 10, 60, 30),
+                                   Box2_i(0, 10, 60, 20)));
+}
+
+TEST(MaxRectangles, PolygonSet) {
+  std::vector<Polygon2_i> polygons = {
+      Polygon2_i(Ring2_i(Box2_i(0, 0, 30, 30)),
+                 {Ring2_i(Box2_i(10, 10, 20, 20))})};
+
+  EXPECT_THAT(MaxRectangles(polygons),
+              UnorderedElementsAre(Box2_i(0, 0, 30, 10), Box2_i(0, 20, 30, 30),
+                                   Box2_i(0, 0, 10, 30),
+                                   Box2_i(20, 0, 30, 30)));
+}
+
+TEST(MaxRectangles, ManyBoxes) {
+  // Diagonal boxes have a distinct x and y each, the worst case for a grid.
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < 100000; ++i) {
+    boxes.push_back(Box2_i(i * 10, i * 10, i * 10 + 15, i * 10 + 15));
+  }
+
+  std::vector<Box2_i> rects = MaxRectangles(boxes);
+
+  // Every box, plus the overlap of each pair of neighbors extended across
+  // both boxes, horizontally and vertically.
+  EXPECT_EQ(rects.size(), 3 * boxes.size() - 2);
+}
+
+TEST(MaxRectangles, Bounded) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(30, 40), Point2_i(30, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+
+  EXPECT_THAT(MaxRectangles(r, 15, 0),
+              UnorderedElementsAre(Box2_i(0, 0, 40, 20)));
+  EXPECT_THAT(MaxRectangles(r, 0, 30),
+              UnorderedElementsAre(Box2_i(30, 0, 40, 40)));
+  EXPECT_THAT(MaxRectangles(r, 15, 30), UnorderedElementsAre());
+}
+
+TEST(MaxRectangles, MatchesBoost) {
+  std::mt19937 gen(26);
+  for (int t = 0; t < 50; ++t) {
+    std::vector<Box2_i> boxes = RandomBoxes(gen, 12, 100, 40);
+
+    EXPECT_THAT(MaxRectangles(boxes),
+                UnorderedElementsAreArray(ReferenceMaxRectangles(boxes)));
+  }
+}
+
+TEST(MaxRectangleEngine, AddSubtract) {
+  std::mt19937 gen(126);
+  for (int t = 0; t < 30; ++t) {
+    std::vector<Box2_i> boxes = RandomBoxes(gen, 8, 100, 40);
+    MaxRectangleEngine<int> engine =
+        MaxRectangleEngine<int>::FromGeometry(boxes);
+    RectilinearGrid<int> grid(boxes);
+    for (const Box2_i& b : RandomBoxes(gen, 6, 100, 30)) {
+      if (std::uniform_int_distribution<int>(0, 1)(gen)) {
+        engine.Add(b);
+        grid.Add(b);
+      } else {
+        engine.Subtract(b);
+        grid.Subtract(b);
+      }
+
+      EXPECT_THAT(engine.Rectangles(),
+                  UnorderedElementsAreArray(MaxRectangles(grid.RowRuns())));
+    }
+  }
+}
+
+TEST(MaxRectangleEngine, BoundedAddSubtract) {
+  std::mt19937 gen(226);
+  for (int t = 0; t < 30; ++t) {
+    std::vector<Box2_i> boxes = RandomBoxes(gen, 8, 100, 40);
+    MaxRectangleEngine<int> engine(boxes, 10, 15);
+    RectilinearGrid<int> grid(boxes);
+    for (const Box2_i& b : RandomBoxes(gen, 6, 100, 30)) {
+      if (std::uniform_int_distribution<int>(0, 1)(gen)) {
+        engine.Add(b);
+        grid.Add(b);
+      } else {
+        engine.Subtract(b);
+        grid.Subtract(b);
+      }
+
+      EXPECT_THAT(engine.Rectangles(),
+                  UnorderedElementsAreArray(MaxRectangles(grid.RowRuns(), 10,
+                                                          15)));
+    }
+  }
+}
+
+TEST(MaxRectangleEngine, SubtractAll) {
+  MaxRectangleEngine<int> engine(
+      std::vector<Box2_i>{Box2_i(0, 0, 10, 10), Box2_i(20, 0, 30, 10)});
+  engine.Subtract(Box2_i(-5, -5, 35, 15));
+
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAre());
+
+  engine.Add(Box2_i(0, 0, 10, 10));
+
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAre(Box2_i(0, 0, 10, 10)));
+}
+
+TEST(MaxRectangleEngine, BoundedAdd) {
+  MaxRectangleEngine<int> engine = MaxRectangleEngine<int>::FromGeometry(
+      std::vector<Box2_i>{Box2_i(0, 0, 10, 10)}, 0, 15);
+
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAre());
+
+  engine.Add(Box2_i(0, 10, 5, 20));
+
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAre(Box2_i(0, 0, 5, 20)));
+}
+
+TEST(MaxRectangleEngine, MoveEdgeOutward) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  MaxRectangleEngine<int> engine = MaxRectangleEngine<int>::FromGeometry(r);
+  // Moves the edge (20, 20)-(0, 20) up to y = 30.
+  engine.MoveEdge(r, 4, 30);
+
+  EXPECT_EQ(r[4], Point2_i(20, 30));
+  EXPECT_EQ(r[5], Point2_i(0, 30));
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAreArray(MaxRectangles(r)));
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAre(Box2_i(20, 0, 40, 40),
+                                                        Box2_i(0, 0, 40, 30)));
+}
+
+TEST(MaxRectangleEngine, MoveEdgeInward) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  MaxRectangleEngine<int> engine = MaxRectangleEngine<int>::FromGeometry(r);
+  // Moves the first edge (0, 0)-(40, 0) up to y = 10.
+  engine.MoveEdge(r, 0, 10);
+
+  EXPECT_EQ(r[0], Point2_i(0, 10));
+  EXPECT_EQ(r[6], Point2_i(0, 10));
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAreArray(MaxRectangles(r)));
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAre(Box2_i(20, 10, 40, 40),
+                                                        Box2_i(0, 10, 40, 20)));
+}
+
+TEST(MaxRectangleEngine, MoveEdgeClockwise) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(0, 20),  Point2_i(20, 20),
+               Point2_i(20, 40), Point2_i(40, 40), Point2_i(40, 0),
+               Point2_i(0, 0)};
+  MaxRectangleEngine<int> engine = MaxRectangleEngine<int>::FromGeometry(r);
+  // Moves the vertical edge (40, 40)-(40, 0) right to x = 50.
+  engine.MoveEdge(r, 4, 50);
+
+  EXPECT_THAT(engine.Rectangles(), UnorderedElementsAre(Box2_i(20, 0, 50, 40),
+                                                        Box2_i(0, 0, 50, 20)));
+}
+
+}  // namespace moab
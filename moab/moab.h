@@ -1,14 +1,39 @@
 #ifndef MOAB_MOAB_H_
 #define MOAB_MOAB_H_
 
+#include "moab/boolean_sink.h"
+#include "moab/bounding_box.h"
 #include "moab/box2.h"
+#include "moab/box_array.h"
+#include "moab/canonical.h"
+#include "moab/clip.h"
+#include "moab/compact_ring2.h"
+#include "moab/connected_components.h"
+#include "moab/decomposition.h"
+#include "moab/density_map.h"
+#include "moab/geometry_pool.h"
+#include "moab/hierarchy.h"
+#include "moab/incremental_layer.h"
 #include "moab/interval.h"
+#include "moab/max_rectangles.h"
 #include "moab/operation.h"
+#include "moab/parallel.h"
 #include "moab/point2.h"
 #include "moab/point3.h"
+#include "moab/polygon2.h"
+#include "moab/prepared_ring2.h"
+#include "moab/property_merge.h"
+#include "moab/raster.h"
+#include "moab/rectilinear_grid.h"
 #include "moab/ring2.h"
 #include "moab/rtree.h"
+#include "moab/rule_check.h"
 #include "moab/segment2.h"
 #include "moab/segment3.h"
+#include "moab/spatial_sort.h"
+#include "moab/sweep_frontier.h"
+#include "moab/tiled_storage.h"
+#include "moab/transform.h"
+#include "moab/union_all.h"
 
 #endif  // MOAB_MOAB_H_
\ No newline at end of file
@@ -1,6 +1,12 @@
 #ifndef MOAB_OPERATION_H_
 #define MOAB_OPERATION_H_
 
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include "boost/geometry.hpp"
 #include "boost/polygon/polygon.hpp"
 
@@ -15,51 +21,223 @@ class Interval;
 template <typename T>
 class Box2;
 
-template <typename T>
+// The number of points Ring2 stores without a heap allocation.
+inline constexpr std::size_t kRing2InlinePoints = 9;
+
+template <typename T, std::size_t N = kRing2InlinePoints>
 class Ring2;
 
+template <typename T>
+class Polygon2;
+
 // Please refer to
 //   https://www.boost.org/doc/libs/1_85_0/libs/polygon/doc/gtl_polygon_set_concept.htm
 // for more information.
 
+// Boolean operation types.
+enum class BooleanOp {
+  kUnion,          // lhs | rhs
+  kIntersection,   // lhs & rhs
+  kDisjointUnion,  // lhs ^ rhs
+  kSubtract,       // lhs - rhs
+};
+
+namespace operation_internal {
+
+template <typename G>
+struct is_ring2 : std::false_type {};
+template <typename T, std::size_t N>
+struct is_ring2<Ring2<T, N>> : std::true_type {};
+
+template <typename G>
+struct is_ring2_vector : std::false_type {};
+template <typename T, std::size_t N>
+struct is_ring2_vector<std::vector<Ring2<T, N>>> : std::true_type {};
+
+// Returns false if g holds a ring with a non-rectilinear edge. Other
+// geometries taken by the fast path below are rectilinear by type.
+template <typename T, std::size_t N>
+bool AllRectilinear(const Ring2<T, N>& r) {
+  return r.IsRectilinear();
+}
+template <typename T, std::size_t N>
+bool AllRectilinear(const std::vector<Ring2<T, N>>& rings) {
+  for (const Ring2<T, N>& r : rings) {
+    if (!r.IsRectilinear()) return false;
+  }
+  return true;
+}
+template <typename G>
+bool AllRectilinear(const G&) {
+  return true;
+}
+
+// Inserts the vertical edges of a rectilinear ring with their known winding,
+// so that polygon_90_set_data needs neither the polygon_concept conversion
+// nor a winding pass. Rings without area add nothing.
+template <typename T, std::size_t N>
+void InsertManhattan(boost::polygon::polygon_90_set_data<T>& data,
+                     const Ring2<T, N>& r) {
+  const boost::polygon::winding_direction winding = r.Winding();
+  if (winding == boost::polygon::unknown_winding) return;
+  const int sign = winding == boost::polygon::counterclockwise_winding ? 1 : -1;
+  const std::size_t n = r.Size();
+  for (std::size_t i = 0; i < n; ++i) {
+    const Point2<T>& p = r[i];
+    const Point2<T>& q = r[(i + 1) % n];
+    if (p.x() != q.x() || p.y() == q.y()) continue;
+    const int count = (q.y() < p.y() ? 1 : -1) * sign;
+    data.insert(std::make_pair(p.x(), std::make_pair(std::min(p.y(), q.y()),
+                                                     count)),
+                false, boost::polygon::VERTICAL);
+    data.insert(std::make_pair(p.x(), std::make_pair(std::max(p.y(), q.y()),
+                                                     -count)),
+                false, boost::polygon::VERTICAL);
+  }
+}
+template <typename T, std::size_t N>
+void InsertManhattan(boost::polygon::polygon_90_set_data<T>& data,
+                     const std::vector<Ring2<T, N>>& rings) {
+  for (const Ring2<T, N>& r : rings) InsertManhattan(data, r);
+}
+template <typename T, typename G>
+void InsertManhattan(boost::polygon::polygon_90_set_data<T>& data,
+                     const G& g) {
+  using concept_type = typename boost::polygon::geometry_concept<G>::type;
+  if constexpr (std::is_same_v<concept_type,
+                               boost::polygon::undefined_concept>) {
+    data.insert(g.begin(), g.end());
+  } else {
+    data.insert(g);
+  }
+}
+
+// Runs lhs = lhs op rhs through polygon_90_set_data when lhs is a std::vector
+// of Ring2 and every ring of lhs and rhs is rectilinear. Returns false, with
+// lhs unchanged, if the general path must be taken instead.
+template <typename Lhs, typename Rhs>
+bool ManhattanBooleanSet(Lhs& lhs, const Rhs& rhs, BooleanOp op) {
+  if constexpr (!is_ring2_vector<Lhs>::value) {
+    return false;
+  } else {
+    using T = typename Lhs::value_type::coordinate_type;
+    if constexpr (!is_ring2<Rhs>::value && !is_ring2_vector<Rhs>::value &&
+                  !std::is_same_v<
+                      typename boost::polygon::is_polygon_90_set_type<
+                          Rhs>::type,
+                      boost::polygon::gtl_yes>) {
+      return false;
+    } else {
+      if (!AllRectilinear(lhs) || !AllRectilinear(rhs)) return false;
+      boost::polygon::polygon_90_set_data<T> a, b;
+      InsertManhattan(a, lhs);
+      InsertManhattan(b, rhs);
+      switch (op) {
+        case BooleanOp::kUnion:
+          boost::polygon::operators::operator|=(a, b);
+          break;
+        case BooleanOp::kIntersection:
+          boost::polygon::operators::operator&=(a, b);
+          break;
+        case BooleanOp::kDisjointUnion:
+          boost::polygon::operators::operator^=(a, b);
+          break;
+        case BooleanOp::kSubtract:
+          boost::polygon::operators::operator-=(a, b);
+          break;
+      }
+      lhs.clear();
+      boost::polygon::assign(lhs, a);
+      return true;
+    }
+  }
+}
+
+}  // namespace operation_internal
+
 // ==================================
 // Boost polygon set operators
 // ==================================
+// Booleans on a std::vector of rectilinear Ring2 run on the Manhattan
+// (polygon_90) machinery with the cached winding of each ring; other inputs
+// take the general path. Both give the same result.
+
 // Polygon set union.
 // lhs |= rhs; lhs += rhs;
 constexpr auto UnionSet = [](auto& lhs, const auto& rhs) constexpr {
+  if (operation_internal::ManhattanBooleanSet(lhs, rhs, BooleanOp::kUnion)) {
+    return lhs;
+  }
   return boost::polygon::operators::operator|=(lhs, rhs);
 };
 
 // Polygon set intersection.
 // lhs &= rhs; lhs *= rhs;
 constexpr auto IntersectionSet = [](auto& lhs, const auto& rhs) constexpr {
+  if (operation_internal::ManhattanBooleanSet(lhs, rhs,
+                                              BooleanOp::kIntersection)) {
+    return lhs;
+  }
   return boost::polygon::operators::operator&=(lhs, rhs);
 };
 
 // Polygon set disjoint union (xor).
 // lhs ^= rhs;
 constexpr auto DisjointUnionSet = [](auto& lhs, const auto& rhs) constexpr {
+  if (operation_internal::ManhattanBooleanSet(lhs, rhs,
+                                              BooleanOp::kDisjointUnion)) {
+    return lhs;
+  }
   return boost::polygon::operators::operator^=(lhs, rhs);
 };
 
 // Polygon set subtraction.
 // lhs -= rhs;
 constexpr auto SubtractSet = [](auto& lhs, const auto& rhs) constexpr {
+  if (operation_internal::ManhattanBooleanSet(lhs, rhs, BooleanOp::kSubtract)) {
+    return lhs;
+  }
   return boost::polygon::operators::operator-=(lhs, rhs);
 };
 
+// Polygon set boolean selected at run time.
+// lhs = lhs op rhs;
+constexpr auto BooleanSet = [](auto& lhs, const auto& rhs,
+                               BooleanOp op) constexpr -> auto& {
+  if (operation_internal::ManhattanBooleanSet(lhs, rhs, op)) return lhs;
+  switch (op) {
+    case BooleanOp::kUnion:
+      boost::polygon::operators::operator|=(lhs, rhs);
+      break;
+    case BooleanOp::kIntersection:
+      boost::polygon::operators::operator&=(lhs, rhs);
+      break;
+    case BooleanOp::kDisjointUnion:
+      boost::polygon::operators::operator^=(lhs, rhs);
+      break;
+    case BooleanOp::kSubtract:
+      boost::polygon::operators::operator-=(lhs, rhs);
+      break;
+  }
+  return lhs;
+};
+
 // ==================================
 // Boost polygon set functions
 // ==================================
 // Polygon set assignment (refinement).
 // Removes overlaps in geometry of rhs and copies rhs to lhs.
+// Assigning to a std::vector of Polygon2 keeps holes as separate rings, while
+// a std::vector of Ring2 receives keyholed rings (holes cut open to the outer
+// boundary).
 constexpr auto Assign = [](auto& lhs, const auto& rhs) constexpr {
   return boost::polygon::assign(lhs, rhs);
 };
 
 // Polygon set equivalence.
-// Returns true if lhs and rhs are equivalent.
+// Returns true if lhs and rhs are equivalent. For rectilinear sets,
+// CanonicalEquivalence in canonical.h compares canonical forms instead of
+// running the boolean.
 constexpr auto Equivalence =
     [](const auto& lhs, const auto& rhs) constexpr -> bool {
   return boost::polygon::equivalence(lhs, rhs);
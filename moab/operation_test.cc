@@ -3,6 +3,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <random>
 #include <string>
 #include <vector>
 
@@ -214,6 +216,161 @@ TEST(PolygonOperators, SubtractBoxBox4) {
               UnorderedElementsAre(Box2_i(2, 0, 4, 2), Box2_i(10, 10, 20, 20)));
 }
 
+TEST(PolygonOperators, BooleanSet) {
+  const std::vector<Box2_i> a = {Box2_i(0, 0, 2, 2)};
+  const std::vector<Box2_i> b = {Box2_i(1, 0, 3, 2)};
+  std::vector<Box2_i> lhs;
+
+  lhs = a;
+  BooleanSet(lhs, b, BooleanOp::kUnion);
+  EXPECT_THAT(lhs, UnorderedElementsAre(Box2_i(0, 0, 3, 2)));
+
+  lhs = a;
+  BooleanSet(lhs, b, BooleanOp::kIntersection);
+  EXPECT_THAT(lhs, UnorderedElementsAre(Box2_i(1, 0, 2, 2)));
+
+  lhs = a;
+  BooleanSet(lhs, b, BooleanOp::kDisjointUnion);
+  EXPECT_THAT(lhs,
+              UnorderedElementsAre(Box2_i(0, 0, 1, 2), Box2_i(2, 0, 3, 2)));
+
+  lhs = a;
+  BooleanSet(lhs, b, BooleanOp::kSubtract);
+  EXPECT_THAT(lhs, UnorderedElementsAre(Box2_i(0, 0, 1, 2)));
+}
+
+TEST(PolygonOperators, ManhattanRings) {
+  std::mt19937 gen(39);
+  std::uniform_int_distribution<int> pos(0, 100);
+  std::uniform_int_distribution<int> size(1, 40);
+  for (int t = 0; t < 20; ++t) {
+    std::vector<Box2_i> ba, bb;
+    for (int i = 0; i < 6; ++i) {
+      int x = pos(gen), y = pos(gen);
+      ba.emplace_back(x, y, x + size(gen), y + size(gen));
+      x = pos(gen), y = pos(gen);
+      bb.emplace_back(x, y, x + size(gen), y + size(gen));
+    }
+    std::vector<Ring2_i> a, b;
+    Assign(a, ba);
+    Assign(b, bb);
+    // Clockwise rings take the fast path too.
+    b.push_back(Ring2_i({Point2_i(50, 50), Point2_i(50, 70), Point2_i(70, 70),
+                         Point2_i(70, 50), Point2_i(50, 50)}));
+    for (BooleanOp op : {BooleanOp::kUnion, BooleanOp::kIntersection,
+                         BooleanOp::kDisjointUnion, BooleanOp::kSubtract}) {
+      std::vector<Ring2_i> fast = a, general = a;
+      BooleanSet(fast, b, op);
+      switch (op) {
+        case BooleanOp::kUnion:
+          boost::polygon::operators::operator|=(general, b);
+          break;
+        case BooleanOp::kIntersection:
+          boost::polygon::operators::operator&=(general, b);
+          break;
+        case BooleanOp::kDisjointUnion:
+          boost::polygon::operators::operator^=(general, b);
+          break;
+        case BooleanOp::kSubtract:
+          boost::polygon::operators::operator-=(general, b);
+          break;
+      }
+
+      EXPECT_EQ(fast, general);
+    }
+  }
+}
+
+TEST(PolygonOperators, ManhattanRingBox) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  std::vector<Ring2_i> fast = {r}, general = {r};
+  SubtractSet(fast, Box2_i(10, 10, 30, 30));
+  boost::polygon::operators::operator-=(general, Box2_i(10, 10, 30, 30));
+
+  EXPECT_EQ(fast, general);
+  EXPECT_EQ(Area(fast), 900);
+}
+
+// Runs the same rectilinear inputs through the Manhattan fast path and the
+// general Boost path, which must give the same rings.
+template <typename Rhs>
+void CheckManhattanMatchesGeneral(const std::vector<Ring2_i>& a,
+                                  const Rhs& b) {
+  for (BooleanOp op : {BooleanOp::kUnion, BooleanOp::kIntersection,
+                       BooleanOp::kDisjointUnion, BooleanOp::kSubtract}) {
+    std::vector<Ring2_i> fast = a, general = a;
+    ASSERT_TRUE(operation_internal::ManhattanBooleanSet(fast, b, op));
+    switch (op) {
+      case BooleanOp::kUnion:
+        boost::polygon::operators::operator|=(general, b);
+        break;
+      case BooleanOp::kIntersection:
+        boost::polygon::operators::operator&=(general, b);
+        break;
+      case BooleanOp::kDisjointUnion:
+        boost::polygon::operators::operator^=(general, b);
+        break;
+      case BooleanOp::kSubtract:
+        boost::polygon::operators::operator-=(general, b);
+        break;
+    }
+
+    EXPECT_EQ(fast, general);
+    EXPECT_EQ(Area(fast), Area(general));
+  }
+}
+
+TEST(PolygonOperators, ManhattanMatchesGeneralPath) {
+  std::mt19937 gen(390);
+  std::uniform_int_distribution<int> pos(0, 100);
+  std::uniform_int_distribution<int> size(2, 40);
+  // An L-shaped ring, counterclockwise or clockwise.
+  auto l_shape = [&](bool ccw) {
+    const int x = pos(gen), y = pos(gen), w = size(gen), h = size(gen);
+    const int w2 = w / 2, h2 = h / 2;
+    std::vector<Point2_i> p = {
+        Point2_i(x, y),           Point2_i(x + w, y),
+        Point2_i(x + w, y + h2),  Point2_i(x + w2, y + h2),
+        Point2_i(x + w2, y + h),  Point2_i(x, y + h),
+        Point2_i(x, y)};
+    if (!ccw) std::reverse(p.begin(), p.end());
+    return Ring2_i(p);
+  };
+  for (int t = 0; t < 20; ++t) {
+    std::vector<Ring2_i> a, b;
+    std::vector<Box2_i> boxes;
+    for (int i = 0; i < 5; ++i) {
+      a.push_back(l_shape(i % 2 == 0));
+      b.push_back(l_shape(i % 2 == 1));
+      const int x = pos(gen), y = pos(gen);
+      boxes.emplace_back(x, y, x + size(gen), y + size(gen));
+    }
+    // A ring without area adds nothing on either path.
+    a.push_back(Ring2_i({Point2_i(0, 0), Point2_i(10, 0), Point2_i(0, 0)}));
+
+    CheckManhattanMatchesGeneral(a, b);
+    CheckManhattanMatchesGeneral(a, b[0]);
+    CheckManhattanMatchesGeneral(a, boxes);
+  }
+}
+
+TEST(PolygonOperators, GeneralAngleRings) {
+  std::vector<Ring2_i> lhs = {Ring2_i(Box2_i(0, 0, 20, 20))};
+  const Ring2_i triangle = {Point2_i(0, 0), Point2_i(20, 0), Point2_i(0, 20),
+                            Point2_i(0, 0)};
+  ASSERT_FALSE(triangle.IsRectilinear());
+  std::vector<Ring2_i> general = lhs;
+  UnionSet(lhs, triangle);
+  IntersectionSet(lhs, Box2_i(0, 0, 10, 10));
+  boost::polygon::operators::operator|=(general, triangle);
+  boost::polygon::operators::operator&=(general, Box2_i(0, 0, 10, 10));
+
+  EXPECT_EQ(lhs, general);
+  EXPECT_EQ(Area(lhs), 100);
+}
+
 TEST(PolygonFunctions, AssignBoxBox1) {
   std::vector<Box2_i> lhs;
   std::vector<Box2_i> rhs = {Box2_i(0, 0, 1, 1)};
@@ -0,0 +1,74 @@
+#ifndef MOAB_PARALLEL_H_
+#define MOAB_PARALLEL_H_
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+namespace moab {
+
+// Returns the number of threads to use. 0 means one thread per hardware
+// thread.
+inline std::size_t NumThreads(std::size_t num_threads) {
+  if (num_threads > 0) return num_threads;
+  return std::max<std::size_t>(1, std::thread::hardware_concurrency());
+}
+
+// Calls fn(i) for every i in [0, n) on up to num_threads threads (0 means one
+// thread per hardware thread). Iterations are handed out one at a time, so
+// this suits loops with uneven per-iteration cost, e.g., one ring per
+// iteration. fn must be safe to call concurrently for different i.
+template <typename Fn>
+void ParallelFor(std::size_t n, std::size_t num_threads, const Fn& fn) {
+  const std::size_t threads = std::min(NumThreads(num_threads), n);
+  if (threads <= 1) {
+    for (std::size_t i = 0; i < n; ++i) fn(i);
+    return;
+  }
+  std::atomic<std::size_t> next(0);
+  auto worker = [&]() {
+    for (std::size_t i = next++; i < n; i = next++) fn(i);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  for (std::size_t t = 1; t < threads; ++t) pool.emplace_back(worker);
+  worker();
+  for (std::thread& t : pool) t.join();
+}
+
+// Returns the number of blocks ParallelForBlocks uses for n iterations.
+// Blocks are at least min_block iterations long, so small inputs run on the
+// calling thread only.
+inline std::size_t NumBlocks(std::size_t n, std::size_t num_threads,
+                             std::size_t min_block = 4096) {
+  const std::size_t blocks = std::max<std::size_t>(1, n / min_block);
+  return std::min(NumThreads(num_threads), blocks);
+}
+
+// Splits [0, n) into NumBlocks(n, num_threads, min_block) contiguous blocks
+// and calls fn(block, begin, end) for each block on its own thread. This suits
+// cheap, uniform iterations, e.g., one point per iteration. Callers that need
+// per-block partial results can size them with NumBlocks() up front.
+template <typename Fn>
+void ParallelForBlocks(std::size_t n, std::size_t num_threads, const Fn& fn,
+                       std::size_t min_block = 4096) {
+  const std::size_t blocks = NumBlocks(n, num_threads, min_block);
+  if (blocks <= 1) {
+    fn(0, 0, n);
+    return;
+  }
+  auto run = [&](std::size_t b) {
+    fn(b, n * b / blocks, n * (b + 1) / blocks);
+  };
+  std::vector<std::thread> pool;
+  pool.reserve(blocks - 1);
+  for (std::size_t b = 1; b < blocks; ++b) pool.emplace_back(run, b);
+  run(0);
+  for (std::thread& t : pool) t.join();
+}
+
+}  // namespace moab
+
+#endif  // MOAB_PARALLEL_H_
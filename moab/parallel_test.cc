@@ -0,0 +1,56 @@
+#include "parallel.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <vector>
+
+namespace moab {
+
+TEST(NumThreads, Explicit) { EXPECT_EQ(NumThreads(3), 3); }
+
+TEST(NumThreads, Default) { EXPECT_GE(NumThreads(0), 1); }
+
+TEST(NumBlocks, SmallInputUsesOneBlock) {
+  EXPECT_EQ(NumBlocks(0, 8), 1);
+  EXPECT_EQ(NumBlocks(100, 8), 1);
+  EXPECT_EQ(NumBlocks(100, 8, 10), 8);
+  EXPECT_EQ(NumBlocks(100, 8, 30), 3);
+}
+
+TEST(ParallelFor, VisitsEveryIndexOnce) {
+  std::vector<std::atomic<int>> visits(1000);
+  ParallelFor(visits.size(), 4, [&](std::size_t i) { ++visits[i]; });
+
+  for (const std::atomic<int>& v : visits) EXPECT_EQ(v.load(), 1);
+}
+
+TEST(ParallelFor, Empty) {
+  int calls = 0;
+  ParallelFor(0, 4, [&](std::size_t) { ++calls; });
+
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(ParallelForBlocks, CoversRange) {
+  const std::size_t n = 100000;
+  const std::size_t blocks = NumBlocks(n, 4);
+  std::vector<std::size_t> sums(blocks, 0);
+  std::vector<int> seen(n, 0);
+  ParallelForBlocks(n, 4, [&](std::size_t b, std::size_t begin,
+                              std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      ++seen[i];
+      sums[b] += i;
+    }
+  });
+
+  std::size_t total = 0;
+  for (std::size_t s : sums) total += s;
+  EXPECT_EQ(blocks, 4);
+  EXPECT_EQ(total, n * (n - 1) / 2);
+  for (int s : seen) EXPECT_EQ(s, 1);
+}
+
+}  // namespace moab
@@ -2,10 +2,10 @@
 #define MOAB_POINT2_H_
 
 #include <array>
-#include <cmath>
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "absl/hash/hash.h"
@@ -30,8 +30,8 @@ class Point2 {
   using coordinate_type = T;
 
   // Constructors.
-  Point2() : d_({0, 0}) {}
-  explicit Point2(T x, T y) : d_({x, y}) {}
+  constexpr Point2() noexcept : d_({0, 0}) {}
+  constexpr explicit Point2(T x, T y) noexcept : d_({x, y}) {}
   explicit Point2(const Point2Proto& proto) { SetFromProto(proto); }
   Point2(const Point2&) = default;
   Point2(Point2&&) = default;
@@ -42,36 +42,36 @@ class Point2 {
   Point2& operator=(Point2&&) = default;
 
   // Accessors.
-  T x() const { return d_[0]; }
-  T y() const { return d_[1]; }
-  T* data() { return d_.data(); }
-  const T* data() const { return d_.data(); }
-  constexpr std::size_t Size() const { return d_.size(); }
-  std::pair<T, T> ToPair() const { return {d_[0], d_[1]}; }
+  constexpr T x() const noexcept { return d_[0]; }
+  constexpr T y() const noexcept { return d_[1]; }
+  constexpr T* data() noexcept { return d_.data(); }
+  constexpr const T* data() const noexcept { return d_.data(); }
+  constexpr std::size_t Size() const noexcept { return d_.size(); }
+  constexpr std::pair<T, T> ToPair() const noexcept { return {d_[0], d_[1]}; }
 
   // Mutators.
-  void Set(T x, T y) {
+  constexpr void Set(T x, T y) noexcept {
     d_[0] = x;
     d_[1] = y;
   }
-  void SetX(T x) { d_[0] = x; }
-  void SetY(T y) { d_[1] = y; }
-  void SetDim(std::size_t i, T v) { d_[i] = v; }
+  constexpr void SetX(T x) noexcept { d_[0] = x; }
+  constexpr void SetY(T y) noexcept { d_[1] = y; }
+  constexpr void SetDim(std::size_t i, T v) noexcept { d_[i] = v; }
 
   // Operations.
-  void Shift(T dx, T dy) {
+  constexpr void Shift(T dx, T dy) noexcept {
     d_[0] += dx;
     d_[1] += dy;
   }
-  void ShiftX(T dx) { d_[0] += dx; }
-  void ShiftY(T dy) { d_[1] += dy; }
-  void Rotate90() {
+  constexpr void ShiftX(T dx) noexcept { d_[0] += dx; }
+  constexpr void ShiftY(T dy) noexcept { d_[1] += dy; }
+  constexpr void Rotate90() noexcept {
     // Counterclockwise rotation by 90 degrees.
     T x = d_[0];
     d_[0] = -d_[1];
     d_[1] = x;
   }
-  void Rotate180() {
+  constexpr void Rotate180() noexcept {
     // Rotation by 180 degrees.
     d_[0] = -d_[0];
     d_[1] = -d_[1];
@@ -79,68 +79,84 @@ class Point2 {
 
   // Operators.
   // Operators - Subscript
-  T& operator[](std::size_t i) { return d_[i]; }
-  const T& operator[](std::size_t i) const { return d_.at(i); }
+  constexpr T& operator[](std::size_t i) noexcept { return d_[i]; }
+  constexpr const T& operator[](std::size_t i) const noexcept { return d_[i]; }
   // Operators - Equality
-  bool operator==(const Point2& p) const {
+  constexpr bool operator==(const Point2& p) const noexcept {
     return d_[0] == p.d_[0] && d_[1] == p.d_[1];
   }
-  bool operator!=(const Point2& p) const { return !(*this == p); }
+  constexpr bool operator!=(const Point2& p) const noexcept {
+    return !(*this == p);
+  }
   // Operators - Inequality
-  bool operator<(const Point2& p) const {
+  constexpr bool operator<(const Point2& p) const noexcept {
     return d_[0] != p.d_[0] ? d_[0] < p.d_[0] : d_[1] < p.d_[1];
   }
-  bool operator>(const Point2& p) const { return p < *this; }
-  bool operator<=(const Point2& p) const { return !(*this > p); }
-  bool operator>=(const Point2& p) const { return !(*this < p); }
+  constexpr bool operator>(const Point2& p) const noexcept { return p < *this; }
+  constexpr bool operator<=(const Point2& p) const noexcept {
+    return !(*this > p);
+  }
+  constexpr bool operator>=(const Point2& p) const noexcept {
+    return !(*this < p);
+  }
   // Operators - Arithmetic
-  Point2& operator+=(const Point2& p) {
+  constexpr Point2& operator+=(const Point2& p) noexcept {
     d_[0] += p.d_[0];
     d_[1] += p.d_[1];
     return *this;
   }
-  Point2& operator-=(const Point2& p) {
+  constexpr Point2& operator-=(const Point2& p) noexcept {
     d_[0] -= p.d_[0];
     d_[1] -= p.d_[1];
     return *this;
   }
-  Point2 operator+(const Point2& p) {
+  constexpr Point2 operator+(const Point2& p) noexcept {
     return Point2(d_[0] + p.d_[0], d_[1] + p.d_[1]);
   }
-  Point2 operator-(const Point2& p) {
+  constexpr Point2 operator-(const Point2& p) noexcept {
     return Point2(d_[0] - p.d_[0], d_[1] - p.d_[1]);
   }
-  Point2 operator+() const { return Point2(d_[0], d_[1]); }
-  Point2 operator-() const { return Point2(-d_[0], -d_[1]); }
+  constexpr Point2 operator+() const noexcept { return Point2(d_[0], d_[1]); }
+  constexpr Point2 operator-() const noexcept { return Point2(-d_[0], -d_[1]); }
 
-  Point2& operator+=(T v) {
+  constexpr Point2& operator+=(T v) noexcept {
     d_[0] += v;
     d_[1] += v;
     return *this;
   }
-  Point2& operator-=(T v) {
+  constexpr Point2& operator-=(T v) noexcept {
     d_[0] -= v;
     d_[1] -= v;
     return *this;
   }
-  Point2& operator*=(T v) {
+  constexpr Point2& operator*=(T v) noexcept {
     d_[0] *= v;
     d_[1] *= v;
     return *this;
   }
-  Point2& operator/=(T v) {
+  constexpr Point2& operator/=(T v) noexcept {
     d_[0] /= v;
     d_[1] /= v;
     return *this;
   }
-  Point2 operator+(T v) const { return Point2(d_[0] + v, d_[1] + v); }
-  Point2 operator-(T v) const { return Point2(d_[0] - v, d_[1] - v); }
-  Point2 operator*(T v) const { return Point2(d_[0] * v, d_[1] * v); }
-  Point2 operator/(T v) const { return Point2(d_[0] / v, d_[1] / v); }
+  constexpr Point2 operator+(T v) const noexcept {
+    return Point2(d_[0] + v, d_[1] + v);
+  }
+  constexpr Point2 operator-(T v) const noexcept {
+    return Point2(d_[0] - v, d_[1] - v);
+  }
+  constexpr Point2 operator*(T v) const noexcept {
+    return Point2(d_[0] * v, d_[1] * v);
+  }
+  constexpr Point2 operator/(T v) const noexcept {
+    return Point2(d_[0] / v, d_[1] / v);
+  }
 
-  // Distance.
-  T Distance(const Point2& p) const {
-    return std::abs(d_[0] - p.d_[0]) + std::abs(d_[1] - p.d_[1]);
+  // Distance. Manhattan, without std::abs so that it stays constexpr.
+  constexpr T Distance(const Point2& p) const noexcept {
+    const T dx = d_[0] - p.d_[0];
+    const T dy = d_[1] - p.d_[1];
+    return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy);
   }
 
   // String conversion.
@@ -216,6 +232,12 @@ using Point2_i = Point2<int>;
 using Point2_i32 = Point2<int32_t>;
 using Point2_i64 = Point2<int64_t>;
 
+// Points are plain values: copied with memcpy in containers and usable in
+// constant expressions.
+static_assert(std::is_trivially_copyable_v<Point2_i>);
+static_assert(std::is_nothrow_default_constructible_v<Point2_i>);
+static_assert(Point2_i(1, 2).Distance(Point2_i(4, 0)) == 5);
+
 }  // namespace moab
 
 // Boost geometry traits.
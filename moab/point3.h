@@ -2,11 +2,11 @@
 #define MOAB_POINT3_H_
 
 #include <array>
-#include <cmath>
 #include <cstdint>
 #include <ostream>
 #include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "absl/hash/hash.h"
@@ -31,8 +31,8 @@ class Point3 {
   using coordinate_type = T;
 
   // Constructors.
-  Point3() : d_({0, 0, 0}) {}
-  explicit Point3(T x, T y, T z) : d_({x, y, z}) {}
+  constexpr Point3() noexcept : d_({0, 0, 0}) {}
+  constexpr explicit Point3(T x, T y, T z) noexcept : d_({x, y, z}) {}
   explicit Point3(const Point3Proto& proto) { SetFromProto(proto); }
   Point3(const Point3&) = default;
   Point3(Point3&&) = default;
@@ -43,52 +43,52 @@ class Point3 {
   Point3& operator=(Point3&&) = default;
 
   // Accessors.
-  T x() const { return d_[0]; }
-  T y() const { return d_[1]; }
-  T z() const { return d_[2]; }
-  T* data() { return d_.data(); }
-  const T* data() const { return d_.data(); }
-  constexpr std::size_t Size() const { return d_.size(); }
+  constexpr T x() const noexcept { return d_[0]; }
+  constexpr T y() const noexcept { return d_[1]; }
+  constexpr T z() const noexcept { return d_[2]; }
+  constexpr T* data() noexcept { return d_.data(); }
+  constexpr const T* data() const noexcept { return d_.data(); }
+  constexpr std::size_t Size() const noexcept { return d_.size(); }
 
-  Point2<T> To2D() const { return Point2<T>(d_[0], d_[1]); }
+  constexpr Point2<T> To2D() const noexcept { return Point2<T>(d_[0], d_[1]); }
 
-  std::tuple<T, T, T> ToTuple() const {
+  constexpr std::tuple<T, T, T> ToTuple() const noexcept {
     return std::make_tuple(d_[0], d_[1], d_[2]);
   }
 
   // Mutators.
-  void Set(T x, T y, T z) {
+  constexpr void Set(T x, T y, T z) noexcept {
     d_[0] = x;
     d_[1] = y;
     d_[2] = z;
   }
-  void SetX(T x) { d_[0] = x; }
-  void SetY(T y) { d_[1] = y; }
-  void SetZ(T z) { d_[2] = z; }
-  void SetDim(std::size_t i, T v) { d_[i] = v; }
+  constexpr void SetX(T x) noexcept { d_[0] = x; }
+  constexpr void SetY(T y) noexcept { d_[1] = y; }
+  constexpr void SetZ(T z) noexcept { d_[2] = z; }
+  constexpr void SetDim(std::size_t i, T v) noexcept { d_[i] = v; }
 
   // Operations.
-  void Shift(T dx, T dy, T dz) {
+  constexpr void Shift(T dx, T dy, T dz) noexcept {
     d_[0] += dx;
     d_[1] += dy;
     d_[2] += dz;
   }
-  void ShiftX(T dx) { d_[0] += dx; }
-  void ShiftY(T dy) { d_[1] += dy; }
-  void ShiftZ(T dz) { d_[2] += dz; }
+  constexpr void ShiftX(T dx) noexcept { d_[0] += dx; }
+  constexpr void ShiftY(T dy) noexcept { d_[1] += dy; }
+  constexpr void ShiftZ(T dz) noexcept { d_[2] += dz; }
 
-  void Rotate90(size_t axis1, size_t axis2) {
+  constexpr void Rotate90(size_t axis1, size_t axis2) noexcept {
     // Counterclockwise rotation by 90 degrees on (axis1, axis2) plane.
     T x = d_[axis1];
     d_[axis1] = -d_[axis2];
     d_[axis2] = x;
   }
-  void Rotate180(size_t axis1, size_t axis2) {
+  constexpr void Rotate180(size_t axis1, size_t axis2) noexcept {
     // Rotation by 180 degrees on (axis1, axis2) plane.
     d_[axis1] = -d_[axis1];
     d_[axis2] = -d_[axis2];
   }
-  void Rotate270(size_t axis1, size_t axis2) {
+  constexpr void Rotate270(size_t axis1, size_t axis2) noexcept {
     // Counterclockwise rotation by 270 degrees on (axis1, axis2) plane.
     Rotate90(axis1, axis2);
     Rotate180(axis1, axis2);
@@ -96,86 +96,98 @@ class Point3 {
 
   // Operators.
   // Operators - Subscript
-  T& operator[](std::size_t i) { return d_[i]; }
-  const T& operator[](std::size_t i) const { return d_.at(i); }
+  constexpr T& operator[](std::size_t i) noexcept { return d_[i]; }
+  constexpr const T& operator[](std::size_t i) const noexcept { return d_[i]; }
   // Operators - Equality
-  bool operator==(const Point3& p) const {
+  constexpr bool operator==(const Point3& p) const noexcept {
     return d_[0] == p.d_[0] && d_[1] == p.d_[1] && d_[2] == p.d_[2];
   }
-  bool operator!=(const Point3& p) const { return !(*this == p); }
+  constexpr bool operator!=(const Point3& p) const noexcept {
+    return !(*this == p);
+  }
   // Operators - Inequality
-  bool operator<(const Point3& p) const {
+  constexpr bool operator<(const Point3& p) const noexcept {
     return d_[0] != p.d_[0]
                ? d_[0] < p.d_[0]
                : d_[1] != p.d_[1] ? d_[1] < p.d_[1] : d_[2] < p.d_[2];
   }
-  bool operator>(const Point3& p) const { return p < *this; }
-  bool operator<=(const Point3& p) const { return !(*this > p); }
-  bool operator>=(const Point3& p) const { return !(*this < p); }
+  constexpr bool operator>(const Point3& p) const noexcept { return p < *this; }
+  constexpr bool operator<=(const Point3& p) const noexcept {
+    return !(*this > p);
+  }
+  constexpr bool operator>=(const Point3& p) const noexcept {
+    return !(*this < p);
+  }
 
   // Operators - Arithmetic
-  Point3& operator+=(const Point3& p) {
+  constexpr Point3& operator+=(const Point3& p) noexcept {
     d_[0] += p.d_[0];
     d_[1] += p.d_[1];
     d_[2] += p.d_[2];
     return *this;
   }
-  Point3& operator-=(const Point3& p) {
+  constexpr Point3& operator-=(const Point3& p) noexcept {
     d_[0] -= p.d_[0];
     d_[1] -= p.d_[1];
     d_[2] -= p.d_[2];
     return *this;
   }
-  Point3 operator+(const Point3& p) {
+  constexpr Point3 operator+(const Point3& p) noexcept {
     return Point3(d_[0] + p.d_[0], d_[1] + p.d_[1], d_[2] + p.d_[2]);
   }
-  Point3 operator-(const Point3& p) {
+  constexpr Point3 operator-(const Point3& p) noexcept {
     return Point3(d_[0] - p.d_[0], d_[1] - p.d_[1], d_[2] - p.d_[2]);
   }
-  Point3 operator+() const { return Point3(d_[0], d_[1], d_[2]); }
-  Point3 operator-() const { return Point3(-d_[0], -d_[1], -d_[2]); }
+  constexpr Point3 operator+() const noexcept {
+    return Point3(d_[0], d_[1], d_[2]);
+  }
+  constexpr Point3 operator-() const noexcept {
+    return Point3(-d_[0], -d_[1], -d_[2]);
+  }
 
-  Point3& operator+=(T v) {
+  constexpr Point3& operator+=(T v) noexcept {
     d_[0] += v;
     d_[1] += v;
     d_[2] += v;
     return *this;
   }
-  Point3& operator-=(T v) {
+  constexpr Point3& operator-=(T v) noexcept {
     d_[0] -= v;
     d_[1] -= v;
     d_[2] -= v;
     return *this;
   }
-  Point3& operator*=(T v) {
+  constexpr Point3& operator*=(T v) noexcept {
     d_[0] *= v;
     d_[1] *= v;
     d_[2] *= v;
     return *this;
   }
-  Point3& operator/=(T v) {
+  constexpr Point3& operator/=(T v) noexcept {
     d_[0] /= v;
     d_[1] /= v;
     d_[2] /= v;
     return *this;
   }
-  Point3 operator+(T v) const {
+  constexpr Point3 operator+(T v) const noexcept {
     return Point3(d_[0] + v, d_[1] + v, d_[2] + v);
   }
-  Point3 operator-(T v) const {
+  constexpr Point3 operator-(T v) const noexcept {
     return Point3(d_[0] - v, d_[1] - v, d_[2] - v);
   }
-  Point3 operator*(T v) const {
+  constexpr Point3 operator*(T v) const noexcept {
     return Point3(d_[0] * v, d_[1] * v, d_[2] * v);
   }
-  Point3 operator/(T v) const {
+  constexpr Point3 operator/(T v) const noexcept {
     return Point3(d_[0] / v, d_[1] / v, d_[2] / v);
   }
 
   // Distance.
-  T Distance(const Point3& p) const {
-    return std::abs(d_[0] - p.d_[0]) + std::abs(d_[1] - p.d_[1]) +
-           std::abs(d_[2] - p.d_[2]);
+  constexpr T Distance(const Point3& p) const noexcept {
+    const T dx = d_[0] - p.d_[0];
+    const T dy = d_[1] - p.d_[1];
+    const T dz = d_[2] - p.d_[2];
+    return (dx < 0 ? -dx : dx) + (dy < 0 ? -dy : dy) + (dz < 0 ? -dz : dz);
   }
 
   // String conversion.
@@ -259,6 +271,10 @@ using Point3_i = Point3<int>;
 using Point3_i32 = Point3<int32_t>;
 using Point3_i64 = Point3<int64_t>;
 
+static_assert(std::is_trivially_copyable_v<Point3_i>);
+static_assert(std::is_nothrow_default_constructible_v<Point3_i>);
+static_assert(Point3_i(1, 2, 3).Distance(Point3_i(0, 0, 0)) == 6);
+
 }  // namespace moab
 
 // Boost geometry traits.
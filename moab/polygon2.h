@@ -0,0 +1,243 @@
+#ifndef MOAB_POLYGON2_H_
+#define MOAB_POLYGON2_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "absl/strings/str_format.h"
+#include "absl/strings/str_join.h"
+#include "boost/geometry.hpp"
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+namespace bg = boost::geometry;
+namespace gtl = boost::polygon;
+
+// A polygon with holes: an outer ring and zero or more hole rings. Rings are
+// closed; the outer ring is counterclockwise and holes are clockwise, which
+// is what the Boost polygon set operations produce.
+template <typename T>
+class Polygon2 {
+ public:
+  // Type aliases. (Required by Boost geometry/polygon traits.)
+  using coordinate_type = T;
+  using point_type = Point2<T>;
+  using ring_type = Ring2<T>;
+  using hole_type = Ring2<T>;
+  using iterator_type = typename Ring2<T>::const_iterator_type;
+  using iterator_holes_type = typename std::vector<Ring2<T>>::const_iterator;
+
+  // Constructors.
+  Polygon2() = default;
+  explicit Polygon2(const Ring2<T>& outer) : outer_(outer) {}
+  explicit Polygon2(Ring2<T>&& outer) : outer_(std::move(outer)) {}
+  explicit Polygon2(const Ring2<T>& outer, const std::vector<Ring2<T>>& holes)
+      : outer_(outer), holes_(holes) {}
+  explicit Polygon2(Ring2<T>&& outer, std::vector<Ring2<T>>&& holes)
+      : outer_(std::move(outer)), holes_(std::move(holes)) {}
+  explicit Polygon2(const Box2<T>& b) : outer_(b) {}
+  Polygon2(std::initializer_list<Point2<T>> il) : outer_(il) {}
+  Polygon2(const Polygon2&) = default;
+  Polygon2(Polygon2&&) = default;
+  ~Polygon2() = default;
+
+  // Assignment operators.
+  Polygon2& operator=(const Polygon2&) = default;
+  Polygon2& operator=(Polygon2&&) = default;
+
+  // Accessors.
+  Ring2<T>& Outer() { return outer_; }
+  const Ring2<T>& Outer() const { return outer_; }
+  std::vector<Ring2<T>>& Holes() { return holes_; }
+  const std::vector<Ring2<T>>& Holes() const { return holes_; }
+  std::size_t NumHoles() const { return holes_.size(); }
+  // Returns the number of points of all rings.
+  std::size_t NumPoints() const {
+    std::size_t n = outer_.Size();
+    for (const Ring2<T>& h : holes_) n += h.Size();
+    return n;
+  }
+  bool Empty() const { return outer_.Empty(); }
+
+  // Returns the area of the outer ring minus the area of the holes.
+  T Area() const { return gtl::area(*this); }
+  Box2<T> BoundingBox() const { return outer_.BoundingBox(); }
+
+  // Mutators.
+  void Clear() {
+    outer_.Clear();
+    holes_.clear();
+  }
+  void SetOuter(const Ring2<T>& r) { outer_ = r; }
+  void AddHole(const Ring2<T>& r) { holes_.push_back(r); }
+  void ClearHoles() { holes_.clear(); }
+
+  // Iterators.
+  // Iterate over the points of the outer ring. (Boost polygon reads the outer
+  // ring through these and size().)
+  iterator_type begin() const { return outer_.begin(); }
+  iterator_type end() const { return outer_.end(); }
+  std::size_t size() const { return outer_.Size(); }
+  // Iterate over the holes.
+  iterator_holes_type begin_holes() const { return holes_.cbegin(); }
+  iterator_holes_type end_holes() const { return holes_.cend(); }
+
+  // Operators.
+  // Operator - Equality
+  bool operator==(const Polygon2& p) const { return moab::IsEqual(*this, p); }
+  bool operator!=(const Polygon2& p) const { return !(*this == p); }
+
+  // String conversion.
+  template <typename Sink>
+  friend void AbslStringify(Sink& sink, const Polygon2& p) {
+    absl::Format(&sink, "(%v [%s])", p.outer_, absl::StrJoin(p.holes_, " "));
+  }
+  std::string ToString() const { return absl::StrCat(*this); }
+  friend std::ostream& operator<<(std::ostream& os, const Polygon2& p) {
+    os << p.ToString();
+    return os;
+  }
+
+  // Hash.
+  // operator== ignores the order of the holes, so the holes are combined as
+  // their sorted hash values.
+  template <typename H>
+  friend H AbslHashValue(H h, const Polygon2& p) {
+    std::vector<std::size_t> holes;
+    holes.reserve(p.holes_.size());
+    for (const Ring2<T>& hole : p.holes_) {
+      holes.push_back(absl::Hash<Ring2<T>>{}(hole));
+    }
+    std::sort(holes.begin(), holes.end());
+    h = H::combine(std::move(h), p.outer_, holes);
+    return h;
+  }
+
+ private:
+  Ring2<T> outer_;
+  std::vector<Ring2<T>> holes_;
+};
+
+// Aliases.
+using Polygon2_i = Polygon2<int>;
+using Polygon2_i32 = Polygon2<int32_t>;
+using Polygon2_i64 = Polygon2<int64_t>;
+
+}  // namespace moab
+
+// Boost geometry traits.
+namespace boost::geometry::traits {
+
+template <typename T>
+struct tag<moab::Polygon2<T>> {
+  using type = polygon_tag;
+};
+
+template <typename T>
+struct ring_const_type<moab::Polygon2<T>> {
+  using type = const moab::Ring2<T>&;
+};
+
+template <typename T>
+struct ring_mutable_type<moab::Polygon2<T>> {
+  using type = moab::Ring2<T>&;
+};
+
+template <typename T>
+struct interior_const_type<moab::Polygon2<T>> {
+  using type = const std::vector<moab::Ring2<T>>&;
+};
+
+template <typename T>
+struct interior_mutable_type<moab::Polygon2<T>> {
+  using type = std::vector<moab::Ring2<T>>&;
+};
+
+template <typename T>
+struct exterior_ring<moab::Polygon2<T>> {
+  static inline moab::Ring2<T>& get(moab::Polygon2<T>& p) {
+    return p.Outer();
+  }
+  static inline const moab::Ring2<T>& get(const moab::Polygon2<T>& p) {
+    return p.Outer();
+  }
+};
+
+template <typename T>
+struct interior_rings<moab::Polygon2<T>> {
+  static inline std::vector<moab::Ring2<T>>& get(moab::Polygon2<T>& p) {
+    return p.Holes();
+  }
+  static inline const std::vector<moab::Ring2<T>>& get(
+      const moab::Polygon2<T>& p) {
+    return p.Holes();
+  }
+};
+
+}  // namespace boost::geometry::traits
+
+// Boost polygon traits.
+namespace boost::polygon {
+
+template <typename T>
+struct geometry_concept<moab::Polygon2<T>> {
+  using type = polygon_with_holes_concept;
+};
+
+template <typename T>
+struct polygon_with_holes_traits<moab::Polygon2<T>> {
+  using hole_type = moab::Ring2<T>;
+  using iterator_holes_type = typename moab::Polygon2<T>::iterator_holes_type;
+
+  static inline iterator_holes_type begin_holes(const moab::Polygon2<T>& p) {
+    return p.begin_holes();
+  }
+  static inline iterator_holes_type end_holes(const moab::Polygon2<T>& p) {
+    return p.end_holes();
+  }
+  static inline std::size_t size_holes(const moab::Polygon2<T>& p) {
+    return p.NumHoles();
+  }
+};
+
+template <typename T>
+struct polygon_mutable_traits<moab::Polygon2<T>> {
+  template <typename iT>
+  static inline moab::Polygon2<T>& set_points(moab::Polygon2<T>& p,
+                                              iT input_begin, iT input_end) {
+    polygon_mutable_traits<moab::Ring2<T>>::set_points(p.Outer(), input_begin,
+                                                        input_end);
+    return p;
+  }
+};
+
+template <typename T>
+struct polygon_with_holes_mutable_traits<moab::Polygon2<T>> {
+  template <typename iT>
+  static inline moab::Polygon2<T>& set_holes(moab::Polygon2<T>& p,
+                                             iT input_begin, iT input_end) {
+    p.ClearHoles();
+    for (; input_begin != input_end; ++input_begin) {
+      moab::Ring2<T> hole;
+      polygon_mutable_traits<moab::Ring2<T>>::set_points(
+          hole, begin_points(*input_begin), end_points(*input_begin));
+      p.AddHole(hole);
+    }
+    return p;
+  }
+};
+
+}  // namespace boost::polygon
+
+#endif  // MOAB_POLYGON2_H_
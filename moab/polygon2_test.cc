@@ -0,0 +1,170 @@
+#include "polygon2.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "absl/hash/hash.h"
+#include "absl/hash/hash_testing.h"
+#include "moab/box2.h"
+#include "moab/decomposition.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+// A 30x30 square with a 10x10 hole in the middle.
+std::vector<Box2_i> Frame() {
+  return {Box2_i(0, 0, 30, 10), Box2_i(0, 20, 30, 30), Box2_i(0, 10, 10, 20),
+          Box2_i(20, 10, 30, 20)};
+}
+
+TEST(Constructor, Default) {
+  Polygon2_i p;
+
+  EXPECT_TRUE(p.Empty());
+  EXPECT_EQ(p.NumHoles(), 0);
+  EXPECT_EQ(p.NumPoints(), 0);
+}
+
+TEST(Constructor, Box) {
+  Polygon2_i p(Box2_i(0, 0, 2, 3));
+
+  EXPECT_EQ(p.Outer(), Ring2_i(Box2_i(0, 0, 2, 3)));
+  EXPECT_EQ(p.NumHoles(), 0);
+  EXPECT_EQ(p.Area(), 6);
+  EXPECT_EQ(p.BoundingBox(), Box2_i(0, 0, 2, 3));
+}
+
+TEST(Constructor, OuterAndHoles) {
+  Ring2_i outer(Box2_i(0, 0, 30, 30));
+  Ring2_i hole = {Point2_i(10, 10), Point2_i(10, 20), Point2_i(20, 20),
+                  Point2_i(20, 10), Point2_i(10, 10)};
+  Polygon2_i p(outer, {hole});
+
+  EXPECT_EQ(p.Outer(), outer);
+  EXPECT_THAT(p.Holes(), ElementsAre(hole));
+  EXPECT_EQ(p.NumPoints(), 10);
+  EXPECT_EQ(p.Area(), 800);
+  EXPECT_EQ(p.BoundingBox(), Box2_i(0, 0, 30, 30));
+}
+
+TEST(Mutators, SetOuterAddHoleClear) {
+  Polygon2_i p;
+  p.SetOuter(Ring2_i(Box2_i(0, 0, 4, 4)));
+  p.AddHole({Point2_i(1, 1), Point2_i(1, 2), Point2_i(2, 2), Point2_i(2, 1),
+             Point2_i(1, 1)});
+
+  EXPECT_EQ(p.NumHoles(), 1);
+  EXPECT_EQ(p.Area(), 15);
+
+  p.ClearHoles();
+
+  EXPECT_EQ(p.NumHoles(), 0);
+  EXPECT_EQ(p.Area(), 16);
+
+  p.Clear();
+
+  EXPECT_TRUE(p.Empty());
+}
+
+TEST(Boost, AssignKeepsHoles) {
+  std::vector<Polygon2_i> polygons;
+  Assign(polygons, Frame());
+
+  ASSERT_EQ(polygons.size(), 1);
+  const Polygon2_i& p = polygons[0];
+  EXPECT_EQ(p.BoundingBox(), Box2_i(0, 0, 30, 30));
+  ASSERT_EQ(p.NumHoles(), 1);
+  EXPECT_EQ(p.Holes()[0].BoundingBox(), Box2_i(10, 10, 20, 20));
+  EXPECT_EQ(p.Area(), 800);
+  // Counterclockwise outer ring and clockwise hole.
+  EXPECT_GT(p.Outer().Area(), 0);
+  EXPECT_GT(bg::area(p.Outer()), 0);
+  EXPECT_LT(bg::area(p.Holes()[0]), 0);
+}
+
+TEST(Boost, BooleanOutputs) {
+  std::vector<Polygon2_i> polygons = {Polygon2_i(Box2_i(0, 0, 30, 30))};
+  SubtractSet(polygons, Box2_i(10, 10, 20, 20));
+
+  ASSERT_EQ(polygons.size(), 1);
+  EXPECT_EQ(polygons[0].NumHoles(), 1);
+  EXPECT_TRUE(Equivalence(polygons, Frame()));
+
+  UnionSet(polygons, Box2_i(10, 10, 20, 20));
+
+  ASSERT_EQ(polygons.size(), 1);
+  EXPECT_EQ(polygons[0].NumHoles(), 0);
+  EXPECT_EQ(Area(polygons), 900);
+}
+
+TEST(Boost, Geometry) {
+  std::vector<Polygon2_i> polygons;
+  Assign(polygons, Frame());
+  const Polygon2_i& p = polygons[0];
+
+  EXPECT_EQ(bg::area(p), 800);
+  EXPECT_TRUE(bg::within(Point2_i(5, 5), p));
+  EXPECT_FALSE(bg::within(Point2_i(15, 15), p));
+  EXPECT_TRUE(bg::is_valid(p));
+}
+
+TEST(Boost, Decompose) {
+  std::vector<Polygon2_i> polygons;
+  Assign(polygons, Frame());
+
+  EXPECT_EQ(Decompose(polygons[0]).size(), 4);
+}
+
+TEST(Operators, Equality) {
+  Polygon2_i p1(Ring2_i(Box2_i(0, 0, 4, 4)),
+                {Ring2_i({Point2_i(1, 1), Point2_i(1, 2), Point2_i(2, 2),
+                          Point2_i(2, 1), Point2_i(1, 1)})});
+  Polygon2_i p2 = p1;
+  Polygon2_i p3(Box2_i(0, 0, 4, 4));
+
+  EXPECT_TRUE(p1 == p2);
+  EXPECT_FALSE(p1 != p2);
+  EXPECT_FALSE(p1 == p3);
+  EXPECT_TRUE(p1 != p3);
+}
+
+TEST(StringConversion, ToString) {
+  Polygon2_i p(Box2_i(0, 0, 1, 1));
+
+  EXPECT_EQ(p.ToString(), "(((0 0) (1 0) (1 1) (0 1) (0 0)) [])");
+}
+
+TEST(Hash, AbslHash) {
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      Polygon2_i(),
+      Polygon2_i(Box2_i(0, 0, 1, 1)),
+      Polygon2_i(Box2_i(0, 0, 4, 4)),
+      Polygon2_i(Ring2_i(Box2_i(0, 0, 4, 4)),
+                 {Ring2_i({Point2_i(1, 1), Point2_i(1, 2), Point2_i(2, 2),
+                           Point2_i(2, 1), Point2_i(1, 1)})}),
+  }));
+}
+
+TEST(Hash, HoleOrder) {
+  const Ring2_i outer(Box2_i(0, 0, 10, 10));
+  const Ring2_i h1 = {Point2_i(1, 1), Point2_i(1, 2), Point2_i(2, 2),
+                      Point2_i(2, 1), Point2_i(1, 1)};
+  const Ring2_i h2 = {Point2_i(5, 5), Point2_i(5, 7), Point2_i(7, 7),
+                      Point2_i(7, 5), Point2_i(5, 5)};
+  const Polygon2_i p1(outer, {h1, h2});
+  const Polygon2_i p2(outer, {h2, h1});
+
+  ASSERT_EQ(p1, p2);
+  EXPECT_EQ(absl::HashOf(p1), absl::HashOf(p2));
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly(
+      {p1, p2, Polygon2_i(outer, {h1})}));
+}
+
+}  // namespace moab
@@ -0,0 +1,280 @@
+#ifndef MOAB_PREPARED_RING2_H_
+#define MOAB_PREPARED_RING2_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+// Where a point lies relative to a ring.
+enum class Location : uint8_t {
+  kOutside,
+  kBoundary,
+  kInside,
+};
+
+// A ring indexed for repeated point location, e.g., many pins checked against
+// the same shape. The ring is cut into horizontal slabs at the y of its
+// vertices, and a segment tree over the slabs holds every edge in the O(log n)
+// nodes that together cover the slabs it spans, sorted by x within a node.
+// Locating a point takes a binary search in each node above its slab, O(log^2
+// n), instead of a walk over all the edges.
+//
+// The index takes O(n log n) memory for any ring, including staggered shapes
+// such as a comb whose teeth end at different y, where every edge spans many
+// slabs. The ring is copied: later changes to it are not seen.
+//
+// Usage:
+//   const PreparedRing2_i prepared(ring);
+//   for (const Point2_i& pin : pins) {
+//     if (prepared.Covers(pin)) ...
+//   }
+template <typename T>
+class PreparedRing2 {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // Constructors.
+  PreparedRing2() = default;
+  template <std::size_t N>
+  explicit PreparedRing2(const Ring2<T, N>& r);
+  PreparedRing2(const PreparedRing2&) = default;
+  PreparedRing2(PreparedRing2&&) = default;
+  ~PreparedRing2() = default;
+
+  // Assignment operators.
+  PreparedRing2& operator=(const PreparedRing2&) = default;
+  PreparedRing2& operator=(PreparedRing2&&) = default;
+
+  // Accessors.
+  bool Empty() const { return ys_.empty(); }
+  T Area() const { return area_; }
+  const Box2<T>& BoundingBox() const {
+    CHECK(!Empty()) << "Ring is empty.";
+    return bounding_box_;
+  }
+
+  // Queries.
+  Location Locate(const Point2<T>& p) const;
+  // Returns true if p is inside or on the border of the ring, like
+  // IsCoveredBy(p, ring).
+  bool Covers(const Point2<T>& p) const {
+    return Locate(p) != Location::kOutside;
+  }
+  // Returns true if p is strictly inside the ring, like IsWithin(p, ring).
+  bool Contains(const Point2<T>& p) const {
+    return Locate(p) == Location::kInside;
+  }
+  // Locates every point, split into contiguous blocks on up to num_threads
+  // threads (0 means one thread per hardware thread).
+  std::vector<Location> Locate(const std::vector<Point2<T>>& points,
+                               std::size_t num_threads = 0) const {
+    std::vector<Location> locations(points.size());
+    ParallelForBlocks(points.size(), num_threads,
+                      [&](std::size_t, std::size_t begin, std::size_t end) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                          locations[i] = Locate(points[i]);
+                        }
+                      });
+    return locations;
+  }
+
+ private:
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+
+  // A non-horizontal edge, lo below hi.
+  struct Edge {
+    Point2<T> lo;
+    Point2<T> hi;
+  };
+
+  // Returns > 0 if p is left of e, 0 if p is on the line through e, and < 0 if
+  // p is right of e.
+  static W Side(const Edge& e, const Point2<T>& p) {
+    return (static_cast<W>(e.hi.x()) - e.lo.x()) *
+               (static_cast<W>(p.y()) - e.lo.y()) -
+           (static_cast<W>(p.x()) - e.lo.x()) *
+               (static_cast<W>(e.hi.y()) - e.lo.y());
+  }
+  // Returns the number of edges spanning slab k that are not left of p, with
+  // p at a y in the closed slab. Sets on_edge if p is on one of them.
+  std::size_t CountNotLeft(std::size_t k, const Point2<T>& p,
+                           bool& on_edge) const;
+  // Returns true if (x, ys_[k]) is on a horizontal edge.
+  bool OnRow(std::size_t k, T x) const;
+
+  // Distinct y of the vertices, sorted. Slab k spans [ys_[k], ys_[k + 1]).
+  std::vector<T> ys_;
+  // Segment tree over the slabs: node 1 is the root, the children of node v
+  // are 2v and 2v + 1, and slab k is leaf leaves_ + k. Edges of node v:
+  // node_edges_[node_offsets_[v], node_offsets_[v + 1]), sorted from left to
+  // right. An edge is in the fewest nodes whose slabs make up the ones it
+  // spans.
+  std::size_t leaves_ = 0;
+  std::vector<std::size_t> node_offsets_;
+  std::vector<Edge> node_edges_;
+  // Horizontal edges at ys_[k], as (xl, xh) sorted by xl:
+  // rows_[row_offsets_[k], row_offsets_[k + 1]).
+  std::vector<std::size_t> row_offsets_;
+  std::vector<std::pair<T, T>> rows_;
+  Box2<T> bounding_box_;
+  T area_ = 0;
+};
+
+template <typename T>
+template <std::size_t N>
+PreparedRing2<T>::PreparedRing2(const Ring2<T, N>& r) {
+  const std::size_t n = r.Size();
+  if (n == 0) return;
+  bounding_box_ = r.BoundingBox();
+  area_ = r.Area();
+  for (const Point2<T>& p : r) ys_.push_back(p.y());
+  std::sort(ys_.begin(), ys_.end());
+  ys_.erase(std::unique(ys_.begin(), ys_.end()), ys_.end());
+  auto row = [this](T y) {
+    return static_cast<std::size_t>(
+        std::lower_bound(ys_.begin(), ys_.end(), y) - ys_.begin());
+  };
+
+  // Every edge goes to the slabs it spans, or to its row if horizontal. The
+  // closing edge is zero length for closed rings and skipped.
+  std::vector<Edge> edges;
+  std::vector<std::pair<std::size_t, std::pair<T, T>>> horizontals;
+  for (std::size_t i = 0; i < n; ++i) {
+    const Point2<T>& p = r[i];
+    const Point2<T>& q = r[(i + 1) % n];
+    if (p == q) continue;
+    if (p.y() == q.y()) {
+      horizontals.push_back(
+          {row(p.y()), {std::min(p.x(), q.x()), std::max(p.x(), q.x())}});
+    } else {
+      edges.push_back(p.y() < q.y() ? Edge{p, q} : Edge{q, p});
+    }
+  }
+  leaves_ = 1;
+  while (leaves_ + 1 < ys_.size()) leaves_ *= 2;
+  // Calls fn(v) for the nodes that make up the slabs [lo, hi).
+  auto for_nodes = [this](std::size_t lo, std::size_t hi, const auto& fn) {
+    for (lo += leaves_, hi += leaves_; lo < hi; lo /= 2, hi /= 2) {
+      if (lo & 1) fn(lo++);
+      if (hi & 1) fn(--hi);
+    }
+  };
+  node_offsets_.assign(2 * leaves_ + 1, 0);
+  for (const Edge& e : edges) {
+    for_nodes(row(e.lo.y()), row(e.hi.y()),
+              [this](std::size_t v) { ++node_offsets_[v + 1]; });
+  }
+  for (std::size_t v = 1; v < node_offsets_.size(); ++v) {
+    node_offsets_[v] += node_offsets_[v - 1];
+  }
+  node_edges_.resize(node_offsets_.back());
+  std::vector<std::size_t> next(node_offsets_.begin(), node_offsets_.end());
+  for (const Edge& e : edges) {
+    for_nodes(row(e.lo.y()), row(e.hi.y()),
+              [&](std::size_t v) { node_edges_[next[v]++] = e; });
+  }
+  // Edges of a simple ring do not cross inside a slab, and every edge of a
+  // node spans all its slabs, so their order at the middle of the first slab
+  // holds across the node.
+  for (std::size_t v = 1; v < 2 * leaves_; ++v) {
+    if (node_offsets_[v + 1] - node_offsets_[v] < 2) continue;
+    std::size_t k = v;
+    while (k < leaves_) k *= 2;
+    k -= leaves_;
+    const double y = (static_cast<double>(ys_[k]) + ys_[k + 1]) / 2;
+    auto x_at = [y](const Edge& e) {
+      return e.lo.x() + (static_cast<double>(e.hi.x()) - e.lo.x()) *
+                            (y - e.lo.y()) /
+                            (static_cast<double>(e.hi.y()) - e.lo.y());
+    };
+    std::sort(node_edges_.begin() + node_offsets_[v],
+              node_edges_.begin() + node_offsets_[v + 1],
+              [&x_at](const Edge& a, const Edge& b) {
+                return x_at(a) < x_at(b);
+              });
+  }
+
+  std::sort(horizontals.begin(), horizontals.end());
+  row_offsets_.assign(ys_.size() + 1, 0);
+  for (const auto& [k, xs] : horizontals) {
+    ++row_offsets_[k + 1];
+    rows_.push_back(xs);
+  }
+  for (std::size_t k = 1; k < row_offsets_.size(); ++k) {
+    row_offsets_[k] += row_offsets_[k - 1];
+  }
+}
+
+template <typename T>
+bool PreparedRing2<T>::OnRow(std::size_t k, T x) const {
+  const auto first = rows_.begin() + row_offsets_[k];
+  const auto last = rows_.begin() + row_offsets_[k + 1];
+  // The last edge starting at or before x covers x if any does.
+  auto it = std::upper_bound(
+      first, last, x,
+      [](T v, const std::pair<T, T>& xs) { return v < xs.first; });
+  return it != first && x <= std::prev(it)->second;
+}
+
+template <typename T>
+std::size_t PreparedRing2<T>::CountNotLeft(std::size_t k, const Point2<T>& p,
+                                           bool& on_edge) const {
+  std::size_t count = 0;
+  for (std::size_t v = leaves_ + k; v > 0; v /= 2) {
+    const Edge* first = node_edges_.data() + node_offsets_[v];
+    const Edge* last = node_edges_.data() + node_offsets_[v + 1];
+    // The edges after the first one not left of p are not left of p either.
+    const Edge* e = std::partition_point(
+        first, last, [&p](const Edge& e) { return Side(e, p) < 0; });
+    if (e != last && Side(*e, p) == 0) on_edge = true;
+    count += last - e;
+  }
+  return count;
+}
+
+template <typename T>
+Location PreparedRing2<T>::Locate(const Point2<T>& p) const {
+  if (Empty() || p.x() < bounding_box_.xl() || p.x() > bounding_box_.xh() ||
+      p.y() < bounding_box_.yl() || p.y() > bounding_box_.yh()) {
+    return Location::kOutside;
+  }
+  // ys_[k] <= p.y() < ys_[k + 1], or p is on the top row.
+  const std::size_t k =
+      std::upper_bound(ys_.begin(), ys_.end(), p.y()) - ys_.begin() - 1;
+  if (ys_[k] == p.y()) {
+    // On a vertex row: the horizontal edges there and the edges ending there
+    // from below are not in slab k.
+    if (OnRow(k, p.x())) return Location::kBoundary;
+    bool on_edge = false;
+    if (k > 0) CountNotLeft(k - 1, p, on_edge);
+    if (on_edge) return Location::kBoundary;
+    if (k + 1 == ys_.size()) return Location::kOutside;
+  }
+  // A ray from p to the right crosses the edges of slab k not left of p.
+  bool on_edge = false;
+  const std::size_t crossings = CountNotLeft(k, p, on_edge);
+  if (on_edge) return Location::kBoundary;
+  return crossings % 2 == 1 ? Location::kInside : Location::kOutside;
+}
+
+// Aliases.
+using PreparedRing2_i = PreparedRing2<int>;
+using PreparedRing2_i32 = PreparedRing2<int32_t>;
+using PreparedRing2_i64 = PreparedRing2<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_PREPARED_RING2_H_
@@ -0,0 +1,102 @@
+#include "prepared_ring2.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+// Checks every point of a grid around the ring against Boost.Geometry.
+void ExpectSameAsBoost(const Ring2_i& r) {
+  const PreparedRing2_i prepared(r);
+  const Box2_i b = r.BoundingBox();
+  for (int x = b.xl() - 2; x <= b.xh() + 2; ++x) {
+    for (int y = b.yl() - 2; y <= b.yh() + 2; ++y) {
+      const Point2_i p(x, y);
+      EXPECT_EQ(prepared.Covers(p), IsCoveredBy(p, r)) << p;
+      EXPECT_EQ(prepared.Contains(p), IsWithin(p, r)) << p;
+    }
+  }
+}
+
+TEST(PreparedRing2, Box) {
+  const Ring2_i r(Box2_i(0, 0, 4, 3));
+  const PreparedRing2_i prepared(r);
+
+  EXPECT_EQ(prepared.Locate(Point2_i(2, 1)), Location::kInside);
+  EXPECT_EQ(prepared.Locate(Point2_i(0, 0)), Location::kBoundary);
+  EXPECT_EQ(prepared.Locate(Point2_i(2, 3)), Location::kBoundary);
+  EXPECT_EQ(prepared.Locate(Point2_i(4, 2)), Location::kBoundary);
+  EXPECT_EQ(prepared.Locate(Point2_i(5, 2)), Location::kOutside);
+  EXPECT_EQ(prepared.Area(), 12);
+  EXPECT_EQ(prepared.BoundingBox(), Box2_i(0, 0, 4, 3));
+  ExpectSameAsBoost(r);
+}
+
+TEST(PreparedRing2, Rectilinear) {
+  // A U shape, with a collinear point on its bottom edge.
+  ExpectSameAsBoost(Ring2_i{Point2_i(0, 0), Point2_i(3, 0), Point2_i(6, 0),
+                            Point2_i(6, 6), Point2_i(4, 6), Point2_i(4, 2),
+                            Point2_i(2, 2), Point2_i(2, 6), Point2_i(0, 6),
+                            Point2_i(0, 0)});
+}
+
+TEST(PreparedRing2, NonRectilinear) {
+  // A concave ring with slanted edges and vertices sharing a y.
+  ExpectSameAsBoost(Ring2_i{Point2_i(0, 0), Point2_i(8, 0), Point2_i(8, 6),
+                            Point2_i(5, 2), Point2_i(3, 6), Point2_i(1, 3),
+                            Point2_i(0, 6), Point2_i(0, 0)});
+}
+
+TEST(PreparedRing2, Clockwise) {
+  ExpectSameAsBoost(Ring2_i{Point2_i(0, 0), Point2_i(0, 4), Point2_i(4, 8),
+                            Point2_i(6, 1), Point2_i(0, 0)});
+}
+
+TEST(PreparedRing2, StaggeredComb) {
+  // Teeth of growing height: the vertical edges of the tall teeth span most
+  // slabs.
+  std::vector<Point2_i> points = {Point2_i(0, 0)};
+  for (int i = 0; i < 40; ++i) {
+    if (i > 0) points.emplace_back(2 * i, 1);
+    points.emplace_back(2 * i, 2 + i);
+    points.emplace_back(2 * i + 1, 2 + i);
+    points.emplace_back(2 * i + 1, i + 1 < 40 ? 1 : 0);
+  }
+  points.emplace_back(0, 0);
+
+  ExpectSameAsBoost(Ring2_i(points));
+}
+
+TEST(PreparedRing2, Empty) {
+  const PreparedRing2_i prepared((Ring2_i()));
+
+  EXPECT_TRUE(prepared.Empty());
+  EXPECT_EQ(prepared.Locate(Point2_i(0, 0)), Location::kOutside);
+  EXPECT_DEATH(prepared.BoundingBox(), "Ring is empty");
+}
+
+TEST(PreparedRing2, Batch) {
+  const Ring2_i r{Point2_i(0, 0),     Point2_i(1000, 0),  Point2_i(1000, 800),
+                  Point2_i(600, 300), Point2_i(300, 900), Point2_i(0, 0)};
+  const PreparedRing2_i prepared(r);
+  std::mt19937 gen(46);
+  std::uniform_int_distribution<int> pos(-10, 1010);
+  std::vector<Point2_i> points;
+  for (int i = 0; i < 20000; ++i) points.emplace_back(pos(gen), pos(gen));
+
+  const std::vector<Location> locations = prepared.Locate(points, 4);
+  ASSERT_EQ(locations.size(), points.size());
+  for (std::size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(locations[i] != Location::kOutside, IsCoveredBy(points[i], r));
+    EXPECT_EQ(locations[i] == Location::kInside, IsWithin(points[i], r));
+  }
+}
+
+}  // namespace moab
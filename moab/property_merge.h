@@ -0,0 +1,211 @@
+#ifndef MOAB_PROPERTY_MERGE_H_
+#define MOAB_PROPERTY_MERGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/rectilinear_grid.h"
+#include "moab/sweep_frontier.h"
+
+namespace moab {
+
+// A set of input labels, bit i set for input i.
+using LabelSet = uint64_t;
+
+// Selects the regions covered by all inputs of required and by none of
+// excluded, e.g., LabelFilter{a | b, c} for "covered by A and B but not C".
+struct LabelFilter {
+  LabelSet required = 0;
+  LabelSet excluded = 0;
+
+  bool operator()(LabelSet labels) const {
+    return (labels & required) == required && (labels & excluded) == 0;
+  }
+};
+
+// Classifies the plane by membership in up to 64 labeled rectilinear inputs.
+// Merge() sweeps all inputs once and returns, for every combination of
+// inputs, the region covered by exactly that combination.
+//
+// Usage:
+//   PropertyMerge_i pm;
+//   const LabelSet a = pm.Insert(layer_a);
+//   const LabelSet b = pm.Insert(layer_b);
+//   const LabelSet c = pm.Insert(layer_c);
+//   auto regions = pm.Merge(LabelFilter{a | b, c});
+//
+// Combinations rejected by the filter are dropped during the sweep, so memory
+// stays proportional to the kept regions.
+template <typename T>
+class PropertyMerge {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+  using result_type = std::map<LabelSet, std::vector<Box2<T>>>;
+
+  static constexpr std::size_t kMaxInputs = 64;
+
+  // Constructors.
+  PropertyMerge() = default;
+  PropertyMerge(const PropertyMerge&) = default;
+  PropertyMerge(PropertyMerge&&) = default;
+  ~PropertyMerge() = default;
+
+  // Assignment operators.
+  PropertyMerge& operator=(const PropertyMerge&) = default;
+  PropertyMerge& operator=(PropertyMerge&&) = default;
+
+  // Accessors.
+  std::size_t NumInputs() const { return inputs_.size(); }
+
+  // Mutators.
+  // Adds a Box2, a rectilinear ring, or a polygon set as the next input.
+  // Returns its label, a LabelSet with only its bit set.
+  template <typename Geometry>
+  LabelSet Insert(const Geometry& g) {
+    CHECK(inputs_.size() < kMaxInputs)
+        << "At most " << kMaxInputs << " inputs are supported.";
+    inputs_.push_back(ToBoxes<T>(g));
+    return LabelSet{1} << (inputs_.size() - 1);
+  }
+  void Clear() { inputs_.clear(); }
+
+  // Operations.
+  // Returns the regions covered by at least one input, keyed by the set of
+  // inputs that cover them, as non-overlapping boxes. Only label sets for which
+  // keep(labels) is true are returned. The sweep runs on up to num_threads
+  // threads (0 means one thread per hardware thread) over horizontal stripes;
+  // boxes are split at stripe borders.
+  template <typename Keep>
+  result_type Merge(const Keep& keep, std::size_t num_threads = 0) const;
+  result_type Merge(std::size_t num_threads = 0) const {
+    return Merge([](LabelSet) { return true; }, num_threads);
+  }
+
+ private:
+  // An edge of a box of an input, clipped to its stripe.
+  struct Event {
+    T y;
+    bool start;
+    std::size_t input;
+    T x0;
+    T x1;
+  };
+
+  // Sweeps the events of a stripe.
+  template <typename Keep>
+  static void SweepStripe(std::vector<Event>& events, const Keep& keep,
+                          result_type& result);
+
+  // Non-overlapping boxes of every input.
+  std::vector<std::vector<Box2<T>>> inputs_;
+};
+
+template <typename T>
+template <typename Keep>
+void PropertyMerge<T>::SweepStripe(std::vector<Event>& events,
+                                   const Keep& keep, result_type& result) {
+  // Ends before starts at the same y: the boxes of one input do not overlap,
+  // so a box that ends where another starts frees its columns first.
+  std::sort(events.begin(), events.end(), [](const Event& a, const Event& b) {
+    return std::tie(a.y, a.start) < std::tie(b.y, b.start);
+  });
+  auto classify = [&keep](LabelSet labels) {
+    return labels != 0 && keep(labels) ? labels : LabelSet{0};
+  };
+  SweepFrontier<T, LabelSet, decltype(classify)> frontier(classify);
+  auto emit = [&result](const Box2<T>& b, LabelSet labels) {
+    result[labels].push_back(b);
+  };
+  std::size_t e = 0;
+  while (e < events.size()) {
+    const T y = events[e].y;
+    for (; e < events.size() && events[e].y == y; ++e) {
+      const Event& ev = events[e];
+      const LabelSet bit = LabelSet{1} << ev.input;
+      if (ev.start) {
+        frontier.Update(ev.x0, ev.x1, [bit](LabelSet& l) { l |= bit; });
+      } else {
+        frontier.Update(ev.x0, ev.x1, [bit](LabelSet& l) { l &= ~bit; });
+      }
+    }
+    frontier.Flush(y, emit);
+  }
+}
+
+template <typename T>
+template <typename Keep>
+typename PropertyMerge<T>::result_type PropertyMerge<T>::Merge(
+    const Keep& keep, std::size_t num_threads) const {
+  std::size_t num_boxes = 0;
+  T ymin = 0, ymax = 0;
+  for (const std::vector<Box2<T>>& boxes : inputs_) {
+    for (const Box2<T>& b : boxes) {
+      if (num_boxes++ == 0) {
+        ymin = b.yl();
+        ymax = b.yh();
+      }
+      ymin = std::min(ymin, b.yl());
+      ymax = std::max(ymax, b.yh());
+    }
+  }
+  if (num_boxes == 0) return {};
+
+  constexpr std::size_t kMinBoxesPerStripe = 1024;
+  const std::size_t stripes =
+      NumBlocks(num_boxes, num_threads, kMinBoxesPerStripe);
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  std::vector<T> borders(stripes + 1, ymax);
+  for (std::size_t s = 0; s < stripes; ++s) {
+    borders[s] = static_cast<T>(ymin + static_cast<W>(ymax - ymin) *
+                                           static_cast<W>(s) /
+                                           static_cast<W>(stripes));
+  }
+  // Every box goes to the stripes it spans, split at their borders.
+  std::vector<std::vector<Event>> events(stripes);
+  for (std::size_t i = 0; i < inputs_.size(); ++i) {
+    for (const Box2<T>& b : inputs_[i]) {
+      if (b.xl() >= b.xh()) continue;
+      std::size_t s = std::upper_bound(borders.begin(),
+                                       borders.begin() + stripes, b.yl()) -
+                      borders.begin() - 1;
+      for (; s < stripes && borders[s] < b.yh(); ++s) {
+        const T lo = std::max(b.yl(), borders[s]);
+        const T hi = std::min(b.yh(), borders[s + 1]);
+        if (lo >= hi) continue;
+        events[s].push_back({lo, true, i, b.xl(), b.xh()});
+        events[s].push_back({hi, false, i, b.xl(), b.xh()});
+      }
+    }
+  }
+  std::vector<result_type> results(stripes);
+  ParallelFor(stripes, num_threads, [&](std::size_t s) {
+    SweepStripe(events[s], keep, results[s]);
+    events[s] = std::vector<Event>();
+  });
+  result_type merged = std::move(results[0]);
+  for (std::size_t s = 1; s < stripes; ++s) {
+    for (auto& [labels, boxes] : results[s]) {
+      std::vector<Box2<T>>& out = merged[labels];
+      out.insert(out.end(), boxes.begin(), boxes.end());
+    }
+  }
+  return merged;
+}
+
+// Aliases.
+using PropertyMerge_i = PropertyMerge<int>;
+using PropertyMerge_i32 = PropertyMerge<int32_t>;
+using PropertyMerge_i64 = PropertyMerge<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_PROPERTY_MERGE_H_
@@ -0,0 +1,155 @@
+#include "property_merge.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+TEST(PropertyMerge, Empty) {
+  PropertyMerge_i pm;
+
+  EXPECT_THAT(pm.Merge(), IsEmpty());
+}
+
+TEST(PropertyMerge, Labels) {
+  PropertyMerge_i pm;
+
+  EXPECT_EQ(pm.Insert(Box2_i(0, 0, 1, 1)), 1);
+  EXPECT_EQ(pm.Insert(Box2_i(0, 0, 1, 1)), 2);
+  EXPECT_EQ(pm.Insert(Box2_i(0, 0, 1, 1)), 4);
+  EXPECT_EQ(pm.NumInputs(), 3);
+}
+
+TEST(PropertyMerge, TwoBoxes) {
+  PropertyMerge_i pm;
+  const LabelSet a = pm.Insert(Box2_i(0, 0, 20, 10));
+  const LabelSet b = pm.Insert(Box2_i(10, 0, 30, 10));
+
+  EXPECT_THAT(pm.Merge(),
+              ElementsAre(Pair(a, ElementsAre(Box2_i(0, 0, 10, 10))),
+                          Pair(b, ElementsAre(Box2_i(20, 0, 30, 10))),
+                          Pair(a | b, ElementsAre(Box2_i(10, 0, 20, 10)))));
+}
+
+TEST(PropertyMerge, MergesRowsVertically) {
+  PropertyMerge_i pm;
+  const LabelSet a = pm.Insert(std::vector<Box2_i>{Box2_i(0, 0, 10, 10),
+                                                   Box2_i(0, 10, 10, 20)});
+  const LabelSet b = pm.Insert(Box2_i(5, 5, 30, 15));
+
+  EXPECT_THAT(pm.Merge(LabelFilter{a, b}),
+              ElementsAre(Pair(a, UnorderedElementsAre(
+                                      Box2_i(0, 0, 10, 5), Box2_i(0, 5, 5, 15),
+                                      Box2_i(0, 15, 10, 20)))));
+}
+
+TEST(PropertyMerge, Ring) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(30, 0), Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(0, 10),
+               Point2_i(0, 0)};
+  PropertyMerge_i pm;
+  const LabelSet a = pm.Insert(r);
+  const LabelSet b = pm.Insert(Box2_i(0, 0, 30, 30));
+
+  PropertyMerge_i::result_type regions = pm.Merge();
+
+  EXPECT_EQ(regions.size(), 2);
+  EXPECT_EQ(Area(regions[a | b]), r.Area());
+  EXPECT_EQ(Area(regions[b]), 900 - r.Area());
+}
+
+// Returns the region covered by exactly the inputs in labels, by booleans.
+std::vector<Box2_i> ExactRegion(const std::vector<std::vector<Box2_i>>& inputs,
+                                LabelSet labels) {
+  std::vector<Box2_i> region;
+  bool first = true;
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    if (!(labels >> i & 1)) continue;
+    if (first) {
+      Assign(region, inputs[i]);
+      first = false;
+    } else {
+      IntersectionSet(region, inputs[i]);
+    }
+  }
+  for (std::size_t i = 0; i < inputs.size(); ++i) {
+    if (!(labels >> i & 1)) SubtractSet(region, inputs[i]);
+  }
+  return region;
+}
+
+void CheckRandomInputs(int boxes_per_input, std::size_t num_threads) {
+  std::mt19937 gen(36);
+  std::uniform_int_distribution<int> pos(0, 1000);
+  std::uniform_int_distribution<int> size(1, 80);
+  std::vector<std::vector<Box2_i>> inputs(4);
+  PropertyMerge_i pm;
+  for (std::vector<Box2_i>& input : inputs) {
+    for (int i = 0; i < boxes_per_input; ++i) {
+      int x = pos(gen), y = pos(gen);
+      input.emplace_back(x, y, x + size(gen), y + size(gen));
+    }
+    pm.Insert(input);
+  }
+  PropertyMerge_i::result_type regions = pm.Merge(num_threads);
+
+  for (LabelSet labels = 1; labels < 16; ++labels) {
+    const std::vector<Box2_i> expected = ExactRegion(inputs, labels);
+    const std::vector<Box2_i>& region = regions[labels];
+
+    EXPECT_TRUE(Equivalence(region, expected)) << "labels: " << labels;
+    // Non-overlapping.
+    EXPECT_EQ(Area(region), Area(expected)) << "labels: " << labels;
+    int64_t sum = 0;
+    for (const Box2_i& b : region) sum += b.Area();
+    EXPECT_EQ(sum, Area(expected)) << "labels: " << labels;
+  }
+
+  // Covered by inputs 0 and 1 but not 2, whatever input 3 is.
+  const LabelFilter filter{0b0011, 0b0100};
+  PropertyMerge_i::result_type kept = pm.Merge(filter, num_threads);
+
+  EXPECT_THAT(kept, UnorderedElementsAre(Pair(0b0011, regions[0b0011]),
+                                         Pair(0b1011, regions[0b1011])));
+}
+
+TEST(PropertyMerge, RandomInputs) { CheckRandomInputs(100, 1); }
+
+TEST(PropertyMerge, RandomInputsParallel) { CheckRandomInputs(1200, 4); }
+
+// Disjoint boxes with distinct x: the sweep must not be quadratic in the
+// number of distinct x.
+TEST(PropertyMerge, ManyBoxes) {
+  constexpr int kBoxesPerInput = 50000;
+  PropertyMerge_i pm;
+  for (int k = 0; k < 4; ++k) {
+    std::vector<Box2_i> input;
+    for (int i = 0; i < kBoxesPerInput; ++i) {
+      const int x = 10 * i + 3 * k, y = 10 * (i % 1000);
+      input.emplace_back(x, y, x + 2, y + 2);
+    }
+    pm.Insert(input);
+  }
+
+  PropertyMerge_i::result_type regions = pm.Merge(std::size_t{4});
+
+  ASSERT_EQ(regions.size(), 4);
+  for (const auto& [labels, boxes] : regions) {
+    EXPECT_EQ(boxes.size(), kBoxesPerInput) << "labels: " << labels;
+  }
+}
+
+}  // namespace moab
@@ -0,0 +1,533 @@
+#ifndef MOAB_RASTER_H_
+#define MOAB_RASTER_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/numeric/bits.h"
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/point2.h"
+
+namespace moab {
+
+namespace gtl = boost::polygon;
+
+// A grid of square pixels. Pixel (x, y) covers
+// [origin.x + x * pixel_size, origin.x + (x + 1) * pixel_size) horizontally,
+// and likewise vertically. A shape covers a pixel if it contains the pixel's
+// center.
+template <typename T>
+class RasterFrame {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // Constructors.
+  RasterFrame() = default;
+  // The frame starts at the lower left corner of extent and has enough pixels
+  // to cover it.
+  explicit RasterFrame(const Box2<T>& extent, T pixel_size)
+      : origin_(extent.xl(), extent.yl()), pixel_size_(pixel_size) {
+    CHECK(pixel_size > 0) << "Pixel size must be positive. pixel_size: "
+                          << pixel_size;
+    width_ = static_cast<std::size_t>(std::ceil(
+        static_cast<double>(extent.Width()) / static_cast<double>(pixel_size)));
+    height_ = static_cast<std::size_t>(
+        std::ceil(static_cast<double>(extent.Height()) /
+                  static_cast<double>(pixel_size)));
+  }
+  explicit RasterFrame(const Point2<T>& origin, T pixel_size,
+                       std::size_t width, std::size_t height)
+      : origin_(origin), pixel_size_(pixel_size), width_(width),
+        height_(height) {
+    CHECK(pixel_size > 0) << "Pixel size must be positive. pixel_size: "
+                          << pixel_size;
+  }
+  RasterFrame(const RasterFrame&) = default;
+  RasterFrame(RasterFrame&&) = default;
+  ~RasterFrame() = default;
+
+  // Assignment operators.
+  RasterFrame& operator=(const RasterFrame&) = default;
+  RasterFrame& operator=(RasterFrame&&) = default;
+
+  // Accessors.
+  const Point2<T>& Origin() const { return origin_; }
+  T PixelSize() const { return pixel_size_; }
+  std::size_t Width() const { return width_; }
+  std::size_t Height() const { return height_; }
+  std::size_t NumPixels() const { return width_ * height_; }
+  // Returns the area covered by the pixels.
+  Box2<T> Extent() const { return PixelsBox(0, 0, width_, height_); }
+  Box2<T> PixelBox(std::size_t x, std::size_t y) const {
+    return PixelsBox(x, y, x + 1, y + 1);
+  }
+  // Returns the box of pixels [x0, x1) x [y0, y1).
+  Box2<T> PixelsBox(std::size_t x0, std::size_t y0, std::size_t x1,
+                    std::size_t y1) const {
+    return Box2<T>(origin_.x() + static_cast<T>(x0) * pixel_size_,
+                   origin_.y() + static_cast<T>(y0) * pixel_size_,
+                   origin_.x() + static_cast<T>(x1) * pixel_size_,
+                   origin_.y() + static_cast<T>(y1) * pixel_size_);
+  }
+  // Returns the columns [begin, end) whose centers lie in [lo, hi).
+  std::pair<std::size_t, std::size_t> Cols(double lo, double hi) const {
+    return {Index(lo, origin_.x(), width_), Index(hi, origin_.x(), width_)};
+  }
+  // Returns the rows [begin, end) whose centers lie in [lo, hi).
+  std::pair<std::size_t, std::size_t> Rows(double lo, double hi) const {
+    return {Index(lo, origin_.y(), height_), Index(hi, origin_.y(), height_)};
+  }
+  // Returns the y coordinate of the centers of row y.
+  double RowCenter(std::size_t y) const {
+    return static_cast<double>(origin_.y()) +
+           (static_cast<double>(y) + 0.5) * static_cast<double>(pixel_size_);
+  }
+
+  // Operators.
+  // Operator - Equality
+  bool operator==(const RasterFrame& f) const {
+    return origin_ == f.origin_ && pixel_size_ == f.pixel_size_ &&
+           width_ == f.width_ && height_ == f.height_;
+  }
+  bool operator!=(const RasterFrame& f) const { return !(*this == f); }
+
+  // Hash.
+  template <typename H>
+  friend H AbslHashValue(H h, const RasterFrame& f) {
+    return H::combine(std::move(h), f.origin_, f.pixel_size_, f.width_,
+                      f.height_);
+  }
+
+ private:
+  // Returns the first pixel whose center is at or above v, clamped to [0, n].
+  std::size_t Index(double v, T origin, std::size_t n) const {
+    const double i = std::ceil((v - static_cast<double>(origin)) /
+                                   static_cast<double>(pixel_size_) -
+                               0.5);
+    if (i <= 0) return 0;
+    if (i >= static_cast<double>(n)) return n;
+    return static_cast<std::size_t>(i);
+  }
+
+  Point2<T> origin_;
+  T pixel_size_ = 1;
+  std::size_t width_ = 0;
+  std::size_t height_ = 0;
+};
+
+// A packed bitmap over a RasterFrame, 64 pixels per word. Rows are padded to
+// whole words; padding bits are always 0.
+template <typename T>
+class Bitmap {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+  using area_type = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+
+  // Constructors.
+  Bitmap() = default;
+  explicit Bitmap(const RasterFrame<T>& frame)
+      : frame_(frame),
+        words_per_row_((frame.Width() + 63) / 64),
+        words_(words_per_row_ * frame.Height(), 0) {}
+  Bitmap(const Bitmap&) = default;
+  Bitmap(Bitmap&&) = default;
+  ~Bitmap() = default;
+
+  // Assignment operators.
+  Bitmap& operator=(const Bitmap&) = default;
+  Bitmap& operator=(Bitmap&&) = default;
+
+  // Accessors.
+  const RasterFrame<T>& Frame() const { return frame_; }
+  std::size_t Width() const { return frame_.Width(); }
+  std::size_t Height() const { return frame_.Height(); }
+  std::size_t WordsPerRow() const { return words_per_row_; }
+  const uint64_t* Row(std::size_t y) const {
+    return &words_[y * words_per_row_];
+  }
+  bool Get(std::size_t x, std::size_t y) const {
+    return (Row(y)[x / 64] >> (x % 64)) & 1;
+  }
+  // Returns the number of set pixels.
+  std::size_t Count() const {
+    std::size_t n = 0;
+    for (uint64_t w : words_) n += absl::popcount(w);
+    return n;
+  }
+  // Returns the area of the set pixels.
+  area_type Area() const {
+    const area_type p = frame_.PixelSize();
+    return static_cast<area_type>(Count()) * p * p;
+  }
+  // Returns the set pixels as boxes. Runs of set pixels in a row become boxes,
+  // and equal runs in consecutive rows are merged.
+  std::vector<Box2<T>> ToBoxes() const;
+
+  // Mutators.
+  uint64_t* Row(std::size_t y) { return &words_[y * words_per_row_]; }
+  void Set(std::size_t x, std::size_t y, bool value) {
+    const uint64_t bit = uint64_t{1} << (x % 64);
+    if (value) {
+      Row(y)[x / 64] |= bit;
+    } else {
+      Row(y)[x / 64] &= ~bit;
+    }
+  }
+  // Sets pixels [x0, x1) of row y.
+  void FillSpan(std::size_t y, std::size_t x0, std::size_t x1) {
+    FillBits(Row(y), x0, x1);
+  }
+  void Clear() { std::fill(words_.begin(), words_.end(), 0); }
+
+  // Operators.
+  // Operators - Boolean
+  // Both bitmaps must have the same frame.
+  Bitmap& operator|=(const Bitmap& b) {
+    return Combine(b, [](uint64_t x, uint64_t y) { return x | y; });
+  }
+  Bitmap& operator&=(const Bitmap& b) {
+    return Combine(b, [](uint64_t x, uint64_t y) { return x & y; });
+  }
+  Bitmap& operator^=(const Bitmap& b) {
+    return Combine(b, [](uint64_t x, uint64_t y) { return x ^ y; });
+  }
+  Bitmap& operator-=(const Bitmap& b) {
+    return Combine(b, [](uint64_t x, uint64_t y) { return x & ~y; });
+  }
+  // Operator - Equality
+  bool operator==(const Bitmap& b) const {
+    return frame_ == b.frame_ && words_ == b.words_;
+  }
+  bool operator!=(const Bitmap& b) const { return !(*this == b); }
+
+  // Hash.
+  template <typename H>
+  friend H AbslHashValue(H h, const Bitmap& b) {
+    return H::combine(std::move(h), b.frame_, b.words_);
+  }
+
+  // Sets bits [begin, end) of a row of words. Whole words in the middle are
+  // filled 64 pixels at a time.
+  static void FillBits(uint64_t* row, std::size_t begin, std::size_t end) {
+    if (begin >= end) return;
+    const std::size_t w0 = begin / 64, w1 = (end - 1) / 64;
+    const uint64_t m0 = ~uint64_t{0} << (begin % 64);
+    const uint64_t m1 = ~uint64_t{0} >> (63 - (end - 1) % 64);
+    if (w0 == w1) {
+      row[w0] |= m0 & m1;
+      return;
+    }
+    row[w0] |= m0;
+    std::fill(row + w0 + 1, row + w1, ~uint64_t{0});
+    row[w1] |= m1;
+  }
+
+ private:
+  // Returns the first pixel at or after x in row y that is set (clear), or
+  // Width() if there is none.
+  std::size_t NextPixel(std::size_t y, std::size_t x, bool set) const {
+    while (x < Width()) {
+      uint64_t w = Row(y)[x / 64];
+      if (!set) w = ~w;
+      w &= ~uint64_t{0} << (x % 64);
+      if (w != 0) {
+        return std::min<std::size_t>(Width(),
+                                     x / 64 * 64 + absl::countr_zero(w));
+      }
+      x = (x / 64 + 1) * 64;
+    }
+    return Width();
+  }
+  template <typename Op>
+  Bitmap& Combine(const Bitmap& b, const Op& op) {
+    CHECK(frame_ == b.frame_) << "Bitmaps must have the same frame.";
+    for (std::size_t i = 0; i < words_.size(); ++i) {
+      words_[i] = op(words_[i], b.words_[i]);
+    }
+    return *this;
+  }
+
+  RasterFrame<T> frame_;
+  std::size_t words_per_row_ = 0;
+  std::vector<uint64_t> words_;
+};
+
+template <typename T>
+std::vector<Box2<T>> Bitmap<T>::ToBoxes() const {
+  std::vector<Box2<T>> boxes;
+  // Open runs [x0, x1) of the previous row and the row they started at.
+  struct Run {
+    std::size_t x0;
+    std::size_t x1;
+    std::size_t y0;
+  };
+  std::vector<Run> open, next;
+  auto close = [&](const Run& r, std::size_t y) {
+    boxes.push_back(frame_.PixelsBox(r.x0, r.y0, r.x1, y));
+  };
+  for (std::size_t y = 0; y <= Height(); ++y) {
+    next.clear();
+    std::size_t k = 0;
+    std::size_t x = 0;
+    while (y < Height() && x < Width()) {
+      const std::size_t x0 = NextPixel(y, x, true);
+      if (x0 >= Width()) break;
+      const std::size_t x1 = NextPixel(y, x0, false);
+      while (k < open.size() && open[k].x0 < x0) close(open[k++], y);
+      if (k < open.size() && open[k].x0 == x0 && open[k].x1 == x1) {
+        next.push_back(open[k++]);
+      } else {
+        if (k < open.size() && open[k].x0 == x0) close(open[k++], y);
+        next.push_back({x0, x1, y});
+      }
+      x = x1;
+    }
+    while (k < open.size()) close(open[k++], y);
+    std::swap(open, next);
+  }
+  return boxes;
+}
+
+// A per-pixel count of the shapes covering each pixel over a RasterFrame.
+template <typename T>
+class CoverageGrid {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // Constructors.
+  CoverageGrid() = default;
+  explicit CoverageGrid(const RasterFrame<T>& frame)
+      : frame_(frame), counts_(frame.NumPixels(), 0) {}
+  CoverageGrid(const CoverageGrid&) = default;
+  CoverageGrid(CoverageGrid&&) = default;
+  ~CoverageGrid() = default;
+
+  // Assignment operators.
+  CoverageGrid& operator=(const CoverageGrid&) = default;
+  CoverageGrid& operator=(CoverageGrid&&) = default;
+
+  // Accessors.
+  const RasterFrame<T>& Frame() const { return frame_; }
+  std::size_t Width() const { return frame_.Width(); }
+  std::size_t Height() const { return frame_.Height(); }
+  const uint32_t* Row(std::size_t y) const { return &counts_[y * Width()]; }
+  uint32_t Get(std::size_t x, std::size_t y) const { return Row(y)[x]; }
+  uint32_t MaxCount() const {
+    return counts_.empty() ? 0
+                           : *std::max_element(counts_.begin(), counts_.end());
+  }
+  // Returns the pixels covered by at least min_count shapes.
+  Bitmap<T> Threshold(uint32_t min_count) const {
+    Bitmap<T> b(frame_);
+    for (std::size_t y = 0; y < Height(); ++y) {
+      const uint32_t* row = Row(y);
+      for (std::size_t x = 0; x < Width(); ++x) {
+        if (row[x] >= min_count) b.Set(x, y, true);
+      }
+    }
+    return b;
+  }
+
+  // Mutators.
+  uint32_t* Row(std::size_t y) { return &counts_[y * Width()]; }
+  // Adds 1 to pixels [x0, x1) of row y.
+  void AddSpan(std::size_t y, std::size_t x0, std::size_t x1) {
+    uint32_t* row = Row(y);
+    for (std::size_t x = x0; x < x1; ++x) ++row[x];
+  }
+
+  // Operators.
+  // Operator - Equality
+  bool operator==(const CoverageGrid& g) const {
+    return frame_ == g.frame_ && counts_ == g.counts_;
+  }
+  bool operator!=(const CoverageGrid& g) const { return !(*this == g); }
+
+ private:
+  RasterFrame<T> frame_;
+  std::vector<uint32_t> counts_;
+};
+
+namespace raster_internal {
+
+// A non-horizontal edge with y0 < y1.
+struct Edge {
+  double x0;
+  double y0;
+  double x1;
+  double y1;
+};
+
+// A shape to scan: a box, or the edges of a polygon (outer ring and holes)
+// filled by the even-odd rule.
+template <typename T>
+struct Item {
+  Box2<T> bbox;
+  bool is_box = false;
+  std::vector<Edge> edges;  // Sorted by y0.
+};
+
+template <typename T, typename Points>
+void AddRing(const Points& first, const Points& last, std::vector<Edge>& out) {
+  std::vector<std::pair<double, double>> pts;
+  for (Points it = first; it != last; ++it) {
+    pts.emplace_back(gtl::x(*it), gtl::y(*it));
+  }
+  for (std::size_t i = 0; i < pts.size(); ++i) {
+    auto p = pts[i];
+    auto q = pts[(i + 1) % pts.size()];
+    if (p.second == q.second) continue;
+    if (p.second > q.second) std::swap(p, q);
+    out.push_back({p.first, p.second, q.first, q.second});
+  }
+}
+
+// Appends the items of a Box2, ring, polygon with holes, or a range of them.
+template <typename T, typename Geometry>
+void CollectItems(const Geometry& g, std::vector<Item<T>>& items) {
+  using concept_type = typename gtl::geometry_concept<Geometry>::type;
+  if constexpr (std::is_same_v<concept_type, gtl::rectangle_concept>) {
+    Item<T> item;
+    item.bbox = Box2<T>(gtl::xl(g), gtl::yl(g), gtl::xh(g), gtl::yh(g));
+    item.is_box = true;
+    items.push_back(std::move(item));
+  } else if constexpr (std::is_same_v<concept_type, gtl::polygon_concept> ||
+                       std::is_same_v<concept_type, gtl::polygon_90_concept> ||
+                       std::is_same_v<concept_type,
+                                      gtl::polygon_with_holes_concept> ||
+                       std::is_same_v<concept_type,
+                                      gtl::polygon_90_with_holes_concept>) {
+    Item<T> item;
+    gtl::rectangle_data<T> r;
+    if (!gtl::extents(r, g)) return;
+    item.bbox = Box2<T>(gtl::xl(r), gtl::yl(r), gtl::xh(r), gtl::yh(r));
+    AddRing<T>(gtl::begin_points(g), gtl::end_points(g), item.edges);
+    if constexpr (std::is_same_v<concept_type,
+                                 gtl::polygon_with_holes_concept> ||
+                  std::is_same_v<concept_type,
+                                 gtl::polygon_90_with_holes_concept>) {
+      for (auto h = gtl::begin_holes(g); h != gtl::end_holes(g); ++h) {
+        AddRing<T>(gtl::begin_points(*h), gtl::end_points(*h), item.edges);
+      }
+    }
+    std::sort(item.edges.begin(), item.edges.end(),
+              [](const Edge& a, const Edge& b) { return a.y0 < b.y0; });
+    items.push_back(std::move(item));
+  } else {
+    for (const auto& e : g) CollectItems<T>(e, items);
+  }
+}
+
+// Calls fill(y, x0, x1) for every span of covered pixels, one call per span
+// of every item. Rows are split into blocks that are scanned in parallel;
+// fill is only called concurrently for different rows.
+template <typename T, typename Fill>
+void Scan(const std::vector<Item<T>>& items, const RasterFrame<T>& frame,
+          std::size_t num_threads, const Fill& fill) {
+  constexpr std::size_t kMinRowsPerBlock = 16;
+  ParallelForBlocks(
+      frame.Height(), num_threads,
+      [&](std::size_t, std::size_t begin, std::size_t end) {
+        std::vector<const Edge*> active;
+        std::vector<double> xs;
+        for (const Item<T>& item : items) {
+          auto [r0, r1] = frame.Rows(item.bbox.yl(), item.bbox.yh());
+          r0 = std::max(r0, begin);
+          r1 = std::min(r1, end);
+          if (r0 >= r1) continue;
+          if (item.is_box) {
+            const auto [c0, c1] = frame.Cols(item.bbox.xl(), item.bbox.xh());
+            if (c0 >= c1) continue;
+            for (std::size_t y = r0; y < r1; ++y) fill(y, c0, c1);
+            continue;
+          }
+          // Active edge table: edges that cross the center line of the row.
+          active.clear();
+          std::size_t next = 0;
+          for (std::size_t y = r0; y < r1; ++y) {
+            const double cy = frame.RowCenter(y);
+            while (next < item.edges.size() && item.edges[next].y0 <= cy) {
+              active.push_back(&item.edges[next++]);
+            }
+            active.erase(std::remove_if(active.begin(), active.end(),
+                                        [cy](const Edge* e) {
+                                          return e->y1 <= cy;
+                                        }),
+                         active.end());
+            xs.clear();
+            for (const Edge* e : active) {
+              xs.push_back(e->x0 + (cy - e->y0) * (e->x1 - e->x0) /
+                                       (e->y1 - e->y0));
+            }
+            std::sort(xs.begin(), xs.end());
+            for (std::size_t i = 0; i + 1 < xs.size(); i += 2) {
+              const auto [c0, c1] = frame.Cols(xs[i], xs[i + 1]);
+              if (c0 < c1) fill(y, c0, c1);
+            }
+          }
+        }
+      },
+      kMinRowsPerBlock);
+}
+
+}  // namespace raster_internal
+
+// Scan-converts a Box2, a ring, a polygon with holes, or a range of them
+// (e.g., a std::vector of Box2 or Ring2) into a bitmap. A pixel is set if its
+// center is inside any of the shapes. Rings need not be rectilinear.
+//
+// This is an approximation at the frame's resolution, meant for quick-look
+// density, approximate booleans (with the Bitmap operators), and pattern
+// matching, where an exact scanline boolean is not needed.
+template <typename T, typename Geometry>
+Bitmap<T> Rasterize(const Geometry& g, const RasterFrame<T>& frame,
+                    std::size_t num_threads = 0) {
+  std::vector<raster_internal::Item<T>> items;
+  raster_internal::CollectItems<T>(g, items);
+  Bitmap<T> bitmap(frame);
+  raster_internal::Scan(items, frame, num_threads,
+                        [&bitmap](std::size_t y, std::size_t x0,
+                                  std::size_t x1) {
+                          bitmap.FillSpan(y, x0, x1);
+                        });
+  return bitmap;
+}
+
+// Like Rasterize, but counts for every pixel how many shapes cover it.
+template <typename T, typename Geometry>
+CoverageGrid<T> RasterizeCoverage(const Geometry& g,
+                                  const RasterFrame<T>& frame,
+                                  std::size_t num_threads = 0) {
+  std::vector<raster_internal::Item<T>> items;
+  raster_internal::CollectItems<T>(g, items);
+  CoverageGrid<T> grid(frame);
+  raster_internal::Scan(items, frame, num_threads,
+                        [&grid](std::size_t y, std::size_t x0,
+                                std::size_t x1) { grid.AddSpan(y, x0, x1); });
+  return grid;
+}
+
+// Aliases.
+using RasterFrame_i = RasterFrame<int>;
+using RasterFrame_i32 = RasterFrame<int32_t>;
+using RasterFrame_i64 = RasterFrame<int64_t>;
+using Bitmap_i = Bitmap<int>;
+using Bitmap_i32 = Bitmap<int32_t>;
+using Bitmap_i64 = Bitmap<int64_t>;
+using CoverageGrid_i = CoverageGrid<int>;
+using CoverageGrid_i32 = CoverageGrid<int32_t>;
+using CoverageGrid_i64 = CoverageGrid<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_RASTER_H_
@@ -0,0 +1,191 @@
+#include "raster.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "absl/hash/hash_testing.h"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/polygon2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+TEST(RasterFrame, Accessors) {
+  RasterFrame_i frame(Box2_i(-10, 0, 15, 20), 10);
+
+  EXPECT_EQ(frame.Origin(), Point2_i(-10, 0));
+  EXPECT_EQ(frame.Width(), 3);
+  EXPECT_EQ(frame.Height(), 2);
+  EXPECT_EQ(frame.Extent(), Box2_i(-10, 0, 20, 20));
+  EXPECT_EQ(frame.PixelBox(1, 1), Box2_i(0, 10, 10, 20));
+  // Centers at -5, 5 and 15.
+  EXPECT_THAT(frame.Cols(-5, 5), Pair(0, 1));
+  EXPECT_THAT(frame.Cols(-4, 15.5), Pair(1, 3));
+  EXPECT_THAT(frame.Cols(-100, 100), Pair(0, 3));
+}
+
+TEST(Bitmap, FillSpan) {
+  Bitmap_i b(RasterFrame_i(Point2_i(0, 0), 1, 200, 2));
+  b.FillSpan(0, 3, 5);
+  b.FillSpan(1, 60, 140);
+
+  EXPECT_EQ(b.WordsPerRow(), 4);
+  EXPECT_EQ(b.Count(), 82);
+  EXPECT_FALSE(b.Get(2, 0));
+  EXPECT_TRUE(b.Get(3, 0));
+  EXPECT_TRUE(b.Get(4, 0));
+  EXPECT_FALSE(b.Get(5, 0));
+  EXPECT_FALSE(b.Get(59, 1));
+  EXPECT_TRUE(b.Get(60, 1));
+  EXPECT_TRUE(b.Get(139, 1));
+  EXPECT_FALSE(b.Get(140, 1));
+
+  b.Set(139, 1, false);
+
+  EXPECT_EQ(b.Count(), 81);
+}
+
+TEST(Rasterize, Box) {
+  RasterFrame_i frame(Box2_i(0, 0, 100, 100), 10);
+  Bitmap_i b = Rasterize(Box2_i(10, 20, 40, 30), frame);
+
+  EXPECT_EQ(b.Count(), 3);
+  EXPECT_EQ(b.Area(), 300);
+  EXPECT_TRUE(b.Get(1, 2));
+  EXPECT_TRUE(b.Get(3, 2));
+  EXPECT_THAT(b.ToBoxes(), ElementsAre(Box2_i(10, 20, 40, 30)));
+}
+
+TEST(Rasterize, PixelCenters) {
+  RasterFrame_i frame(Box2_i(0, 0, 100, 100), 10);
+  // Covers the centers of columns 1 to 3 and row 2 only.
+  Bitmap_i b = Rasterize(Box2_i(14, 24, 36, 26), frame);
+
+  EXPECT_EQ(b.Count(), 3);
+  EXPECT_THAT(b.ToBoxes(), ElementsAre(Box2_i(10, 20, 40, 30)));
+  // Covers no center.
+  EXPECT_EQ(Rasterize(Box2_i(16, 16, 24, 24), frame).Count(), 0);
+}
+
+TEST(Rasterize, Ring) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(30, 0), Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(0, 10),
+               Point2_i(0, 0)};
+  Bitmap_i b = Rasterize(r, RasterFrame_i(Box2_i(0, 0, 30, 30), 1));
+
+  EXPECT_EQ(b.Area(), r.Area());
+  EXPECT_TRUE(Equivalence(b.ToBoxes(), std::vector<Ring2_i>{r}));
+}
+
+TEST(Rasterize, Triangle) {
+  Ring2_i r = {Point2_i(0, 0), Point2_i(20, 0), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  Bitmap_i b = Rasterize(r, RasterFrame_i(Box2_i(0, 0, 20, 20), 1));
+
+  // Center (x + 0.5, y + 0.5) is inside if x + y < 19.
+  for (int y = 0; y < 20; ++y) {
+    for (int x = 0; x < 20; ++x) {
+      EXPECT_EQ(b.Get(x, y), x + y < 19) << x << ", " << y;
+    }
+  }
+  EXPECT_EQ(b.Count(), 190);
+}
+
+TEST(Rasterize, PolygonWithHoles) {
+  std::vector<Polygon2_i> polygons = {Polygon2_i(Box2_i(0, 0, 30, 30))};
+  SubtractSet(polygons, Box2_i(10, 10, 20, 20));
+  Bitmap_i b = Rasterize(polygons, RasterFrame_i(Box2_i(0, 0, 30, 30), 5));
+
+  EXPECT_EQ(b.Area(), 800);
+  EXPECT_FALSE(b.Get(2, 2));
+  EXPECT_TRUE(Equivalence(b.ToBoxes(), polygons));
+}
+
+TEST(Bitmap, Booleans) {
+  std::mt19937 gen(34);
+  std::uniform_int_distribution<int> pos(0, 90);
+  std::uniform_int_distribution<int> size(1, 30);
+  std::vector<Box2_i> a, b;
+  for (int i = 0; i < 30; ++i) {
+    int x = pos(gen), y = pos(gen);
+    (i % 2 == 0 ? a : b).emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+  // Unit pixels over integer coordinates are exact.
+  RasterFrame_i frame(Box2_i(0, 0, 120, 120), 1);
+  const Bitmap_i ba = Rasterize(a, frame);
+  const Bitmap_i bb = Rasterize(b, frame);
+
+  auto check = [&](Bitmap_i bits, BooleanOp op) {
+    std::vector<Box2_i> expected;
+    Assign(expected, a);
+    BooleanSet(expected, b, op);
+
+    EXPECT_TRUE(Equivalence(bits.ToBoxes(), expected));
+    EXPECT_EQ(bits.Area(), Area(expected));
+  };
+  check(Bitmap_i(ba) |= bb, BooleanOp::kUnion);
+  check(Bitmap_i(ba) &= bb, BooleanOp::kIntersection);
+  check(Bitmap_i(ba) ^= bb, BooleanOp::kDisjointUnion);
+  check(Bitmap_i(ba) -= bb, BooleanOp::kSubtract);
+}
+
+TEST(Bitmap, Hash) {
+  RasterFrame_i frame(Box2_i(0, 0, 100, 100), 10);
+
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      Bitmap_i(),
+      Bitmap_i(frame),
+      Rasterize(Box2_i(0, 0, 10, 10), frame),
+      Rasterize(Box2_i(0, 0, 20, 10), frame),
+  }));
+}
+
+TEST(RasterizeCoverage, Counts) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 20, 20), Box2_i(10, 10, 30, 30),
+                               Box2_i(15, 15, 25, 25)};
+  RasterFrame_i frame(Box2_i(0, 0, 30, 30), 5);
+  CoverageGrid_i grid = RasterizeCoverage(boxes, frame);
+
+  EXPECT_EQ(grid.MaxCount(), 3);
+  EXPECT_EQ(grid.Get(0, 0), 1);
+  EXPECT_EQ(grid.Get(2, 2), 2);
+  EXPECT_EQ(grid.Get(3, 3), 3);
+  EXPECT_EQ(grid.Get(5, 0), 0);
+  EXPECT_THAT(grid.Threshold(3).ToBoxes(),
+              ElementsAre(Box2_i(15, 15, 20, 20)));
+  EXPECT_THAT(grid.Threshold(2).ToBoxes(),
+              UnorderedElementsAre(Box2_i(10, 10, 20, 15),
+                                   Box2_i(10, 15, 25, 20),
+                                   Box2_i(15, 20, 25, 25)));
+}
+
+TEST(Rasterize, Parallel) {
+  std::mt19937 gen(341);
+  std::uniform_int_distribution<int> pos(0, 900);
+  std::uniform_int_distribution<int> size(1, 100);
+  std::vector<Box2_i> boxes;
+  std::vector<Ring2_i> rings;
+  for (int i = 0; i < 100; ++i) {
+    int x = pos(gen), y = pos(gen);
+    boxes.emplace_back(x, y, x + size(gen), y + size(gen));
+    rings.push_back({Point2_i(x, y), Point2_i(x + size(gen), y),
+                     Point2_i(x, y + size(gen)), Point2_i(x, y)});
+  }
+  RasterFrame_i frame(Box2_i(0, 0, 1000, 1000), 3);
+
+  EXPECT_EQ(Rasterize(boxes, frame, 4), Rasterize(boxes, frame, 1));
+  EXPECT_EQ(Rasterize(rings, frame, 4), Rasterize(rings, frame, 1));
+  EXPECT_EQ(RasterizeCoverage(rings, frame, 4),
+            RasterizeCoverage(rings, frame, 1));
+}
+
+}  // namespace moab
@@ -0,0 +1,381 @@
+#ifndef MOAB_RECTILINEAR_GRID_H_
+#define MOAB_RECTILINEAR_GRID_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/sweep_frontier.h"
+
+namespace moab {
+
+namespace gtl = boost::polygon;
+
+// Primary template: the coordinate type of a range of geometries.
+template <typename Geometry, typename = void>
+struct coordinate_of {
+  using type = typename Geometry::value_type::coordinate_type;
+};
+
+// Specialization for geometries that declare their own coordinate type.
+template <typename Geometry>
+struct coordinate_of<Geometry,
+                     std::void_t<typename Geometry::coordinate_type>> {
+  using type = typename Geometry::coordinate_type;
+};
+
+// Helper alias template for easier usage.
+template <typename Geometry>
+using coordinate_of_t = typename coordinate_of<Geometry>::type;
+
+// A horizontal edge of a rectilinear region: going up across y, the winding
+// number of [x0, x1) changes by delta.
+template <typename T>
+struct HorizontalEdge {
+  T y;
+  int delta;
+  T x0;
+  T x1;
+};
+
+namespace rectilinear_grid_internal {
+
+// Appends the horizontal edges of the ring [first, last), open or closed.
+// Either orientation adds the area of the ring to the region, times sign.
+// Rings without area add nothing.
+template <typename T, typename It>
+void AppendRingEdges(It first, It last, int sign,
+                     std::vector<HorizontalEdge<T>>& edges) {
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  if (first == last) return;
+  const std::size_t begin = edges.size();
+  W area2 = 0;
+  auto add = [&](const auto& p, const auto& q) {
+    const T px = gtl::x(p), py = gtl::y(p), qx = gtl::x(q), qy = gtl::y(q);
+    CHECK(px == qx || py == qy) << "Geometry must be rectilinear.";
+    area2 += static_cast<W>(px) * qy - static_cast<W>(qx) * py;
+    if (py != qy || px == qx) return;
+    // Counterclockwise, the interior lies above the edges that go right.
+    edges.push_back({py, qx > px ? 1 : -1, std::min(px, qx), std::max(px, qx)});
+  };
+  It prev = first;
+  for (It it = std::next(first); it != last; prev = it++) add(*prev, *it);
+  add(*prev, *first);
+  if (area2 == 0) {
+    edges.resize(begin);
+  } else if ((area2 > 0) != (sign > 0)) {
+    for (std::size_t i = begin; i < edges.size(); ++i) {
+      edges[i].delta = -edges[i].delta;
+    }
+  }
+}
+
+}  // namespace rectilinear_grid_internal
+
+// Appends the horizontal edges of a Box2, a rectilinear ring or polygon with
+// holes, or a polygon set (e.g., a std::vector of Box2, Ring2 or Polygon2).
+// Shapes of a set may overlap; the region is where the winding number is
+// positive. CHECK-fails on edges that are not axis-parallel.
+template <typename T, typename Geometry>
+void AppendHorizontalEdges(const Geometry& g,
+                           std::vector<HorizontalEdge<T>>& edges) {
+  namespace internal = rectilinear_grid_internal;
+  using concept_type = typename gtl::geometry_concept<Geometry>::type;
+  if constexpr (std::is_same_v<concept_type, gtl::rectangle_concept>) {
+    const T xl = gtl::xl(g), yl = gtl::yl(g), xh = gtl::xh(g), yh = gtl::yh(g);
+    if (xl >= xh || yl >= yh) return;
+    edges.push_back({yl, 1, xl, xh});
+    edges.push_back({yh, -1, xl, xh});
+  } else if constexpr (std::is_same_v<concept_type, gtl::polygon_concept> ||
+                       std::is_same_v<concept_type, gtl::polygon_90_concept>) {
+    internal::AppendRingEdges<T>(gtl::begin_points(g), gtl::end_points(g), 1,
+                                 edges);
+  } else if constexpr (
+      std::is_same_v<concept_type, gtl::polygon_with_holes_concept> ||
+      std::is_same_v<concept_type, gtl::polygon_90_with_holes_concept>) {
+    internal::AppendRingEdges<T>(gtl::begin_points(g), gtl::end_points(g), 1,
+                                 edges);
+    for (auto h = gtl::begin_holes(g); h != gtl::end_holes(g); ++h) {
+      internal::AppendRingEdges<T>(gtl::begin_points(*h), gtl::end_points(*h),
+                                   -1, edges);
+    }
+  } else if constexpr (std::is_same_v<concept_type, gtl::undefined_concept>) {
+    for (const auto& e : g) AppendHorizontalEdges<T>(e, edges);
+  } else {
+    std::vector<Box2<T>> boxes;
+    moab::Assign(boxes, g);
+    for (const Box2<T>& b : boxes) AppendHorizontalEdges<T>(b, edges);
+  }
+}
+
+// Returns the region where the winding number of the edges is positive as
+// its horizontal slabs: every maximal horizontal run of the region, extended
+// upward while it stays the same. The slabs do not overlap and come in
+// increasing order of top edge. A scanline over the edges (see SweepFrontier)
+// takes O(n log n) for n edges on typical layouts.
+template <typename T>
+std::vector<Box2<T>> HorizontalSlabs(std::vector<HorizontalEdge<T>> edges) {
+  std::sort(edges.begin(), edges.end(),
+            [](const HorizontalEdge<T>& a, const HorizontalEdge<T>& b) {
+              return a.y < b.y;
+            });
+  auto inside = [](int winding) { return winding > 0; };
+  SweepFrontier<T, int, decltype(inside)> frontier(inside);
+  std::vector<Box2<T>> slabs;
+  auto emit = [&slabs](const Box2<T>& b, bool) { slabs.push_back(b); };
+  std::size_t e = 0;
+  while (e < edges.size()) {
+    const T y = edges[e].y;
+    for (; e < edges.size() && edges[e].y == y; ++e) {
+      const int delta = edges[e].delta;
+      frontier.Update(edges[e].x0, edges[e].x1,
+                      [delta](int& winding) { winding += delta; });
+    }
+    frontier.Flush(y, emit);
+  }
+  return slabs;
+}
+
+// Returns non-overlapping boxes covering the same area as the geometry, its
+// horizontal slabs. Geometry is a Box2, a rectilinear ring or polygon with
+// holes, or a polygon set (e.g., a std::vector of Box2, Ring2 or Polygon2).
+template <typename T, typename Geometry>
+std::vector<Box2<T>> ToBoxes(const Geometry& g) {
+  using concept_type = typename gtl::geometry_concept<Geometry>::type;
+  if constexpr (std::is_same_v<concept_type, gtl::rectangle_concept>) {
+    std::vector<Box2<T>> boxes;
+    if (gtl::xl(g) < gtl::xh(g) && gtl::yl(g) < gtl::yh(g)) boxes.push_back(g);
+    return boxes;
+  } else {
+    std::vector<HorizontalEdge<T>> edges;
+    AppendHorizontalEdges<T>(g, edges);
+    return HorizontalSlabs(std::move(edges));
+  }
+}
+
+// A coverage bitmap over the compressed coordinates of a rectilinear region.
+// Columns are the intervals between consecutive x coordinates and rows are the
+// intervals between consecutive y coordinates. A cell is covered if it lies
+// inside the region. Coordinates that do not bound any coverage change are
+// allowed; algorithms built on the grid treat them as redundant splits.
+template <typename T>
+class RectilinearGrid {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // Constructors.
+  RectilinearGrid() = default;
+  // Builds the grid from boxes. Overlapping boxes are allowed.
+  explicit RectilinearGrid(const std::vector<Box2<T>>& boxes);
+  RectilinearGrid(const RectilinearGrid&) = default;
+  RectilinearGrid(RectilinearGrid&&) = default;
+  ~RectilinearGrid() = default;
+
+  // Assignment operators.
+  RectilinearGrid& operator=(const RectilinearGrid&) = default;
+  RectilinearGrid& operator=(RectilinearGrid&&) = default;
+
+  // Builds the grid from a Box2, a rectilinear ring, or a polygon set.
+  template <typename Geometry>
+  static RectilinearGrid FromGeometry(const Geometry& g) {
+    return RectilinearGrid(ToBoxes<T>(g));
+  }
+
+  // Accessors.
+  const std::vector<T>& Xs() const { return xs_; }
+  const std::vector<T>& Ys() const { return ys_; }
+  std::size_t NumCols() const { return xs_.empty() ? 0 : xs_.size() - 1; }
+  std::size_t NumRows() const { return ys_.empty() ? 0 : ys_.size() - 1; }
+  bool Empty() const { return NumCols() == 0 || NumRows() == 0; }
+
+  bool IsCovered(std::size_t col, std::size_t row) const {
+    return cells_[row * NumCols() + col] != 0;
+  }
+  // Returns the box spanned by columns [col0, col1) and rows [row0, row1).
+  Box2<T> CellsBox(std::size_t col0, std::size_t row0, std::size_t col1,
+                   std::size_t row1) const {
+    return Box2<T>(xs_[col0], ys_[row0], xs_[col1], ys_[row1]);
+  }
+  // Returns the index of coordinate x (y), or the number of coordinates if x
+  // (y) is not a grid line.
+  std::size_t XIndex(T x) const { return Find(xs_, x); }
+  std::size_t YIndex(T y) const { return Find(ys_, y); }
+
+  // Mutators.
+  void SetCovered(std::size_t col, std::size_t row, bool covered) {
+    cells_[row * NumCols() + col] = covered ? 1 : 0;
+  }
+  // Inserts a vertical (horizontal) grid line, splitting the cells it crosses.
+  // Returns the index of the line. No-op if the line already exists.
+  std::size_t InsertX(T x);
+  std::size_t InsertY(T y);
+  // Marks the cells inside b as covered (uncovered). Grid lines are inserted
+  // as needed so that the result is exact.
+  void Add(const Box2<T>& b) { Paint(b, true); }
+  void Subtract(const Box2<T>& b) { Paint(b, false); }
+
+  // Returns the covered area as non-overlapping boxes, one per maximal
+  // horizontal run of covered cells in every row.
+  std::vector<Box2<T>> RowRuns() const;
+
+ private:
+  static std::size_t Find(const std::vector<T>& v, T c) {
+    auto it = std::lower_bound(v.begin(), v.end(), c);
+    return (it != v.end() && *it == c) ? it - v.begin() : v.size();
+  }
+  void Paint(const Box2<T>& b, bool covered);
+
+  std::vector<T> xs_;
+  std::vector<T> ys_;
+  std::vector<uint8_t> cells_;  // Row-major, NumRows() x NumCols().
+};
+
+template <typename T>
+RectilinearGrid<T>::RectilinearGrid(const std::vector<Box2<T>>& boxes) {
+  for (const Box2<T>& b : boxes) {
+    if (b.Width() == 0 || b.Height() == 0) continue;
+    xs_.push_back(b.xl());
+    xs_.push_back(b.xh());
+    ys_.push_back(b.yl());
+    ys_.push_back(b.yh());
+  }
+  std::sort(xs_.begin(), xs_.end());
+  xs_.erase(std::unique(xs_.begin(), xs_.end()), xs_.end());
+  std::sort(ys_.begin(), ys_.end());
+  ys_.erase(std::unique(ys_.begin(), ys_.end()), ys_.end());
+  if (Empty()) return;
+
+  // 2D difference array over the (cols + 1) x (rows + 1) corners.
+  const std::size_t nc = NumCols() + 1;
+  const std::size_t nr = NumRows() + 1;
+  std::vector<int32_t> diff(nc * nr, 0);
+  for (const Box2<T>& b : boxes) {
+    if (b.Width() == 0 || b.Height() == 0) continue;
+    const std::size_t c0 = XIndex(b.xl()), c1 = XIndex(b.xh());
+    const std::size_t r0 = YIndex(b.yl()), r1 = YIndex(b.yh());
+    ++diff[r0 * nc + c0];
+    --diff[r0 * nc + c1];
+    --diff[r1 * nc + c0];
+    ++diff[r1 * nc + c1];
+  }
+  for (std::size_t r = 0; r < nr; ++r) {
+    for (std::size_t c = 1; c < nc; ++c) {
+      diff[r * nc + c] += diff[r * nc + c - 1];
+    }
+  }
+  for (std::size_t r = 1; r < nr; ++r) {
+    for (std::size_t c = 0; c < nc; ++c) {
+      diff[r * nc + c] += diff[(r - 1) * nc + c];
+    }
+  }
+  cells_.assign(NumCols() * NumRows(), 0);
+  for (std::size_t r = 0; r < NumRows(); ++r) {
+    for (std::size_t c = 0; c < NumCols(); ++c) {
+      cells_[r * NumCols() + c] = diff[r * nc + c] > 0 ? 1 : 0;
+    }
+  }
+}
+
+template <typename T>
+std::size_t RectilinearGrid<T>::InsertX(T x) {
+  auto it = std::lower_bound(xs_.begin(), xs_.end(), x);
+  const std::size_t i = it - xs_.begin();
+  if (it != xs_.end() && *it == x) return i;
+  const std::size_t old_cols = NumCols();
+  xs_.insert(it, x);
+  if (ys_.empty()) return i;
+  // A line outside the current range adds an uncovered column; a line inside
+  // splits column i - 1 into two copies.
+  std::vector<uint8_t> cells(NumCols() * NumRows(), 0);
+  for (std::size_t r = 0; r < NumRows(); ++r) {
+    for (std::size_t c = 0; c < NumCols(); ++c) {
+      std::size_t src;
+      if (old_cols == 0) continue;
+      if (i == 0) {
+        if (c == 0) continue;
+        src = c - 1;
+      } else if (i == xs_.size() - 1) {
+        if (c == NumCols() - 1) continue;
+        src = c;
+      } else {
+        src = c < i ? c : c - 1;
+      }
+      cells[r * NumCols() + c] = cells_[r * old_cols + src];
+    }
+  }
+  cells_ = std::move(cells);
+  return i;
+}
+
+template <typename T>
+std::size_t RectilinearGrid<T>::InsertY(T y) {
+  auto it = std::lower_bound(ys_.begin(), ys_.end(), y);
+  const std::size_t i = it - ys_.begin();
+  if (it != ys_.end() && *it == y) return i;
+  const std::size_t old_rows = NumRows();
+  ys_.insert(it, y);
+  if (xs_.empty()) return i;
+  std::vector<uint8_t> cells(NumCols() * NumRows(), 0);
+  for (std::size_t r = 0; r < NumRows(); ++r) {
+    std::size_t src;
+    if (old_rows == 0) continue;
+    if (i == 0) {
+      if (r == 0) continue;
+      src = r - 1;
+    } else if (i == ys_.size() - 1) {
+      if (r == NumRows() - 1) continue;
+      src = r;
+    } else {
+      src = r < i ? r : r - 1;
+    }
+    std::copy_n(cells_.begin() + src * NumCols(), NumCols(),
+                cells.begin() + r * NumCols());
+  }
+  cells_ = std::move(cells);
+  return i;
+}
+
+template <typename T>
+void RectilinearGrid<T>::Paint(const Box2<T>& b, bool covered) {
+  if (b.Width() == 0 || b.Height() == 0) return;
+  const std::size_t c0 = InsertX(b.xl());
+  const std::size_t c1 = InsertX(b.xh());
+  const std::size_t r0 = InsertY(b.yl());
+  const std::size_t r1 = InsertY(b.yh());
+  for (std::size_t r = r0; r < r1; ++r) {
+    for (std::size_t c = c0; c < c1; ++c) SetCovered(c, r, covered);
+  }
+}
+
+template <typename T>
+std::vector<Box2<T>> RectilinearGrid<T>::RowRuns() const {
+  std::vector<Box2<T>> boxes;
+  for (std::size_t r = 0; r < NumRows(); ++r) {
+    std::size_t c = 0;
+    while (c < NumCols()) {
+      if (!IsCovered(c, r)) {
+        ++c;
+        continue;
+      }
+      std::size_t e = c;
+      while (e < NumCols() && IsCovered(e, r)) ++e;
+      boxes.push_back(CellsBox(c, r, e, r + 1));
+      c = e;
+    }
+  }
+  return boxes;
+}
+
+}  // namespace moab
+
+#endif  // MOAB_RECTILINEAR_GRID_H_
@@ -0,0 +1,105 @@
+#include "rectilinear_grid.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+
+TEST(Constructor, Default) {
+  RectilinearGrid<int> g;
+
+  EXPECT_TRUE(g.Empty());
+  EXPECT_EQ(g.NumCols(), 0);
+  EXPECT_EQ(g.NumRows(), 0);
+}
+
+TEST(Constructor, Boxes) {
+  RectilinearGrid<int> g({Box2_i(0, 0, 40, 20), Box2_i(20, 0, 40, 40)});
+
+  EXPECT_THAT(g.Xs(), ElementsAre(0, 20, 40));
+  EXPECT_THAT(g.Ys(), ElementsAre(0, 20, 40));
+  EXPECT_TRUE(g.IsCovered(0, 0));
+  EXPECT_TRUE(g.IsCovered(1, 0));
+  EXPECT_FALSE(g.IsCovered(0, 1));
+  EXPECT_TRUE(g.IsCovered(1, 1));
+}
+
+TEST(Constructor, IgnoresDegenerateBoxes) {
+  RectilinearGrid<int> g({Box2_i(0, 0, 10, 10), Box2_i(20, 0, 20, 10)});
+
+  EXPECT_THAT(g.Xs(), ElementsAre(0, 10));
+  EXPECT_THAT(g.Ys(), ElementsAre(0, 10));
+}
+
+TEST(Constructor, FromRing) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  RectilinearGrid<int> g = RectilinearGrid<int>::FromGeometry(r);
+
+  EXPECT_EQ(g.NumCols(), 2);
+  EXPECT_EQ(g.NumRows(), 2);
+  EXPECT_FALSE(g.IsCovered(0, 1));
+  EXPECT_TRUE(g.IsCovered(1, 1));
+}
+
+TEST(Mutators, InsertX) {
+  RectilinearGrid<int> g({Box2_i(0, 0, 10, 10)});
+
+  EXPECT_EQ(g.InsertX(5), 1);
+  EXPECT_EQ(g.InsertX(5), 1);
+  EXPECT_EQ(g.InsertX(-5), 0);
+  EXPECT_EQ(g.InsertX(20), 4);
+  EXPECT_THAT(g.Xs(), ElementsAre(-5, 0, 5, 10, 20));
+  EXPECT_FALSE(g.IsCovered(0, 0));
+  EXPECT_TRUE(g.IsCovered(1, 0));
+  EXPECT_TRUE(g.IsCovered(2, 0));
+  EXPECT_FALSE(g.IsCovered(3, 0));
+}
+
+TEST(Mutators, InsertY) {
+  RectilinearGrid<int> g({Box2_i(0, 0, 10, 10)});
+
+  EXPECT_EQ(g.InsertY(5), 1);
+  EXPECT_EQ(g.InsertY(-5), 0);
+  EXPECT_EQ(g.InsertY(20), 4);
+  EXPECT_THAT(g.Ys(), ElementsAre(-5, 0, 5, 10, 20));
+  EXPECT_FALSE(g.IsCovered(0, 0));
+  EXPECT_TRUE(g.IsCovered(0, 1));
+  EXPECT_TRUE(g.IsCovered(0, 2));
+  EXPECT_FALSE(g.IsCovered(0, 3));
+}
+
+TEST(Mutators, AddSubtract) {
+  RectilinearGrid<int> g({Box2_i(0, 0, 10, 10)});
+  g.Add(Box2_i(10, 0, 20, 5));
+  g.Subtract(Box2_i(2, 2, 4, 4));
+
+  EXPECT_EQ(Area(g.RowRuns()), 10 * 10 + 10 * 5 - 2 * 2);
+}
+
+TEST(Operations, RowRuns) {
+  RectilinearGrid<int> g({Box2_i(0, 0, 40, 20), Box2_i(20, 0, 40, 40)});
+
+  EXPECT_THAT(g.RowRuns(), UnorderedElementsAre(Box2_i(0, 0, 40, 20),
+                                                Box2_i(20, 20, 40, 40)));
+}
+
+TEST(Utilities, ToBoxes) {
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 10, 10), Box2_i(5, 5, 15, 15)};
+
+  EXPECT_EQ(Area(ToBoxes<int>(boxes)), 175);
+  EXPECT_EQ(Area(ToBoxes<int>(Box2_i(0, 0, 3, 3))), 9);
+  EXPECT_EQ(Area(ToBoxes<int>(Ring2_i(Box2_i(0, 0, 3, 3)))), 9);
+}
+
+}  // namespace moab
@@ -1,14 +1,21 @@
 #ifndef MOAB_RING2_H_
 #define MOAB_RING2_H_
 
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
 #include <cstdint>
 #include <initializer_list>
+#include <iterator>
 #include <string>
+#include <type_traits>
 #include <vector>
 
+#include "absl/container/inlined_vector.h"
 #include "absl/log/check.h"
 #include "absl/strings/str_join.h"
 #include "moab/box2.h"
+#include "moab/max_rectangles.h"
 #include "moab/operation.h"
 #include "moab/point2.h"
 
@@ -17,11 +24,16 @@ namespace moab {
 namespace bg = boost::geometry;
 namespace gtl = boost::polygon;
 
-template <typename T>
+// A ring of points. The first N points are stored inline, in the object
+// itself; larger rings spill to the heap. The default N holds rectangles,
+// L-shapes and T-shapes, closing point included, without an allocation.
+// Points() returns that storage, base_type, which has the interface of a
+// std::vector but is not one.
+template <typename T, std::size_t N>
 class Ring2 {
  public:
   // Type aliases.
-  using base_type = std::vector<Point2<T>>;
+  using base_type = absl::InlinedVector<Point2<T>, N>;
   using coordinate_type = T;
   using point_type = Point2<T>;
   using iterator_type = typename base_type::const_iterator;
@@ -30,24 +42,40 @@ class Ring2 {
 
   // Constructors.
   Ring2() = default;
-  explicit Ring2(const std::vector<Point2<T>>& v) : d_(v) {}
-  explicit Ring2(std::vector<Point2<T>>&& v) : d_(std::move(v)) {}
+  // The points are copied, also from an rvalue: the inline storage cannot
+  // adopt the buffer of v.
+  explicit Ring2(const std::vector<Point2<T>>& v) : d_(v.begin(), v.end()) {}
   explicit Ring2(const Box2<T>& b)
       : d_({Point2<T>(b.MinX(), b.MinY()), Point2<T>(b.MaxX(), b.MinY()),
             Point2<T>(b.MaxX(), b.MaxY()), Point2<T>(b.MinX(), b.MaxY()),
             Point2<T>(b.MinX(), b.MinY())}) {}
   Ring2(std::initializer_list<Point2<T>> il) : d_(il) {}
-  Ring2(const Ring2&) = default;
-  Ring2(Ring2&&) = default;
+  Ring2(const Ring2& r) : d_(r.d_), shape_(r.shape_.load(kRelaxed)) {}
+  Ring2(Ring2&& r) noexcept
+      : d_(std::move(r.d_)), shape_(r.shape_.exchange(0, kRelaxed)) {}
   ~Ring2() = default;
 
   // Assignment operators.
-  Ring2& operator=(const Ring2&) = default;
-  Ring2& operator=(Ring2&&) = default;
+  Ring2& operator=(const Ring2& r) {
+    d_ = r.d_;
+    shape_.store(r.shape_.load(kRelaxed), kRelaxed);
+    return *this;
+  }
+  Ring2& operator=(Ring2&& r) noexcept {
+    d_ = std::move(r.d_);
+    shape_.store(r.shape_.exchange(0, kRelaxed), kRelaxed);
+    return *this;
+  }
 
   // Accessors.
-  std::vector<Point2<T>>& Points() { return d_; }
-  const std::vector<Point2<T>>& Points() const { return d_; }
+  // The mutable accessors and iterators reset the cached shape (see
+  // IsRectilinear), so points must not be changed through a reference or
+  // iterator obtained before a later IsRectilinear or Winding call.
+  base_type& Points() {
+    ResetShape();
+    return d_;
+  }
+  const base_type& Points() const { return d_; }
   size_t Size() const { return d_.size(); }
   bool Empty() const { return d_.empty(); }
 
@@ -58,48 +86,107 @@ class Ring2 {
     return p;
   }
   Box2<T> BoundingBox() const {
+    if (!d_.empty()) return Box2<T>::BoundingBox(d_.data(), d_.size());
     Box2<T> b;
     bg::envelope(*this, b);
     return b;
   }
-  // Returns the maximum boxes that cover the ring.
-  std::vector<Box2<T>> MaxBoxes() const {
-    std::vector<Box2<T>> boxes;
-    gtl::get_max_rectangles(boxes,
-                            gtl::view_as<gtl::polygon_90_set_concept>(*this));
-    return boxes;
+  // Returns true if every edge is horizontal or vertical. Computed once and
+  // cached together with the winding until the ring is changed.
+  bool IsRectilinear() const { return Shape() & kRectilinear; }
+  // Returns the orientation of the ring, or unknown_winding if it has no area.
+  // Cached like IsRectilinear.
+  gtl::winding_direction Winding() const {
+    const uint8_t shape = Shape();
+    if (shape & kCounterclockwise) return gtl::counterclockwise_winding;
+    if (shape & kClockwise) return gtl::clockwise_winding;
+    return gtl::unknown_winding;
+  }
+  // Returns the maximum boxes that cover the ring. Only boxes at least
+  // min_width wide and min_height tall are returned.
+  std::vector<Box2<T>> MaxBoxes(T min_width = 0, T min_height = 0) const {
+    return MaxRectangles(*this, min_width, min_height);
   }
 
   // Mutators.
   // Avoid using these methods if possible. It is designed for Boost
   // polygon/geometry registration.
-  void Clear() { d_.clear(); }
-  void Append(const Point2<T>& p) { d_.push_back(p); }
-  void Resize(std::size_t n) { d_.resize(n); }
+  void Clear() {
+    ResetShape();
+    d_.clear();
+  }
+  void Append(const Point2<T>& p) {
+    ResetShape();
+    d_.push_back(p);
+  }
+  void Resize(std::size_t n) {
+    ResetShape();
+    d_.resize(n);
+  }
 
   template <typename InputIt>
   void Assign(InputIt first, InputIt last) {
+    ResetShape();
     d_.assign(first, last);
   }
-  void Assign(std::initializer_list<Point2<T>> il) { d_.assign(il); }
+  void Assign(std::initializer_list<Point2<T>> il) {
+    ResetShape();
+    d_.assign(il);
+  }
+  void SetPoint(std::size_t i, const Point2<T>& p) {
+    ResetShape();
+    d_[i] = p;
+  }
+  // Calls fn(base_type&) to change the points in place, then resets the
+  // cached shape. fn must not keep the reference.
+  template <typename Fn>
+  void UpdatePoints(const Fn& fn) {
+    fn(d_);
+    ResetShape();
+  }
 
   // Operations.
   // Operations - Bloat
-  std::vector<Ring2<T>> BloatedRings(T x, T y) const;
+  std::vector<Ring2> BloatedRings(T x, T y) const;
+  // Operations - Canonical form
+  // Returns the ring closed, counterclockwise, without repeated or collinear
+  // points, and starting at its lowest (x, then y) point. Rings that are
+  // equal under operator== have the same canonical form. Degenerate rings
+  // (no area) give an empty ring.
+  Ring2 Canonical() const;
 
   // Iterators.
-  mutable_iterator_type begin() { return d_.begin(); }
-  mutable_iterator_type end() { return d_.end(); }
+  mutable_iterator_type begin() {
+    ResetShape();
+    return d_.begin();
+  }
+  mutable_iterator_type end() {
+    ResetShape();
+    return d_.end();
+  }
   const_iterator_type begin() const { return d_.cbegin(); }
   const_iterator_type end() const { return d_.cend(); }
-  mutable_iterator_type rbegin() { return d_.rbegin(); }
-  mutable_iterator_type rend() { return d_.rend(); }
-  const_iterator_type rbegin() const { return d_.rbegin(); }
-  const_iterator_type rend() const { return d_.rend(); }
+  std::reverse_iterator<mutable_iterator_type> rbegin() {
+    ResetShape();
+    return d_.rbegin();
+  }
+  std::reverse_iterator<mutable_iterator_type> rend() {
+    ResetShape();
+    return d_.rend();
+  }
+  std::reverse_iterator<const_iterator_type> rbegin() const {
+    return d_.crbegin();
+  }
+  std::reverse_iterator<const_iterator_type> rend() const {
+    return d_.crend();
+  }
 
   // Operators.
   // Operator - Subscript
-  Point2<T>& operator[](std::size_t i) { return d_[i]; }
+  Point2<T>& operator[](std::size_t i) {
+    ResetShape();
+    return d_[i];
+  }
   const Point2<T>& operator[](std::size_t i) const { return d_[i]; }
   // Operator - Equality
   bool operator==(const Ring2& r) const { return moab::IsEqual(*this, r); }
@@ -117,18 +204,30 @@ class Ring2 {
   }
 
   // Hash.
-  // This is NOT a perfect hash function. Be careful when using this hash
-  // function. It is possible that two equivalent rings with different point
-  // sets have different hash values. They are equal under operator== (the
-  // IsEqual function) but have different hash values.
+  // Hashes the canonical form and the orientation, so rings that are equal
+  // under operator== (the IsEqual function) have the same hash value, whatever
+  // their start point or collinear points.
   template <typename H>
   friend H AbslHashValue(H h, const Ring2& r) {
-    h = H::combine(std::move(h), r.d_);
+    h = H::combine(std::move(h), r.Canonical().d_, bg::area(r) < 0);
     return h;
   }
 
  private:
-  std::vector<Point2<T>> d_;
+  // Cached shape bits.
+  static constexpr uint8_t kKnown = 1;
+  static constexpr uint8_t kRectilinear = 2;
+  static constexpr uint8_t kCounterclockwise = 4;
+  static constexpr uint8_t kClockwise = 8;
+  static constexpr std::memory_order kRelaxed = std::memory_order_relaxed;
+
+  void ResetShape() { shape_.store(0, kRelaxed); }
+  // Returns the cached shape bits, computing them first if needed. Concurrent
+  // callers may both compute them; they store the same value.
+  uint8_t Shape() const;
+
+  base_type d_;
+  mutable std::atomic<uint8_t> shape_ = 0;
 };
 
 // Aliases.
@@ -136,54 +235,119 @@ using Ring2_i = Ring2<int>;
 using Ring2_i32 = Ring2<int32_t>;
 using Ring2_i64 = Ring2<int64_t>;
 
-template <typename T>
-std::vector<Ring2<T>> Ring2<T>::BloatedRings(T x, T y) const {
+template <typename T, std::size_t N>
+std::vector<Ring2<T, N>> Ring2<T, N>::BloatedRings(T x, T y) const {
   CHECK(x >= 0 && y >= 0) << "Bloat values must be non-negative.";
   std::vector<Box2<T>> bloated_boxes;
   for (moab::Box2<T> box : MaxBoxes()) {
     bloated_boxes.push_back(box.Bloat(x, y));
   }
-  std::vector<Ring2<T>> bloated_rings;
+  std::vector<Ring2> bloated_rings;
   moab::Assign(bloated_rings, bloated_boxes);
   return bloated_rings;
 }
 
+template <typename T, std::size_t N>
+uint8_t Ring2<T, N>::Shape() const {
+  uint8_t shape = shape_.load(kRelaxed);
+  if (shape & kKnown) return shape;
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  bool rectilinear = true;
+  W area2 = 0;
+  for (std::size_t i = 0; i < d_.size(); ++i) {
+    const Point2<T>& p = d_[i];
+    const Point2<T>& q = d_[(i + 1) % d_.size()];
+    rectilinear = rectilinear && (p.x() == q.x() || p.y() == q.y());
+    area2 += static_cast<W>(p.x()) * q.y() - static_cast<W>(q.x()) * p.y();
+  }
+  shape = kKnown;
+  if (rectilinear) shape |= kRectilinear;
+  if (area2 > 0) shape |= kCounterclockwise;
+  if (area2 < 0) shape |= kClockwise;
+  shape_.store(shape, kRelaxed);
+  return shape;
+}
+
+template <typename T, std::size_t N>
+Ring2<T, N> Ring2<T, N>::Canonical() const {
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  auto collinear = [](const Point2<T>& a, const Point2<T>& b,
+                      const Point2<T>& c) {
+    return (static_cast<W>(b.x()) - a.x()) * (static_cast<W>(c.y()) - a.y()) ==
+           (static_cast<W>(b.y()) - a.y()) * (static_cast<W>(c.x()) - a.x());
+  };
+  base_type pts;
+  pts.reserve(d_.size());
+  for (const Point2<T>& p : d_) {
+    if (!pts.empty() && pts.back() == p) continue;
+    while (pts.size() >= 2 && collinear(pts[pts.size() - 2], pts.back(), p)) {
+      pts.pop_back();
+    }
+    pts.push_back(p);
+  }
+  // Points around the closing point.
+  while (pts.size() >= 3) {
+    const std::size_t n = pts.size();
+    if (pts[n - 1] == pts[0] || collinear(pts[n - 2], pts[n - 1], pts[0])) {
+      pts.pop_back();
+    } else if (collinear(pts[n - 1], pts[0], pts[1])) {
+      pts.erase(pts.begin());
+    } else {
+      break;
+    }
+  }
+  if (pts.size() < 3) return Ring2();
+  W area2 = 0;
+  for (std::size_t i = 0; i < pts.size(); ++i) {
+    const Point2<T>& p = pts[i];
+    const Point2<T>& q = pts[(i + 1) % pts.size()];
+    area2 += static_cast<W>(p.x()) * q.y() - static_cast<W>(q.x()) * p.y();
+  }
+  if (area2 < 0) std::reverse(pts.begin(), pts.end());
+  std::rotate(pts.begin(), std::min_element(pts.begin(), pts.end()),
+              pts.end());
+  pts.push_back(pts.front());
+  Ring2 r;
+  r.d_ = std::move(pts);
+  return r;
+}
+
 }  // namespace moab
 
 // Boost geometry traits.
 namespace boost::geometry::traits {
 
-template <typename T>
-struct tag<moab::Ring2<T>> {
+template <typename T, std::size_t N>
+struct tag<moab::Ring2<T, N>> {
   using type = ring_tag;
 };
 
-template <typename T>
-struct clear<moab::Ring2<T>> {
-  static inline void apply(moab::Ring2<T>& r) { r.Clear(); }
+template <typename T, std::size_t N>
+struct clear<moab::Ring2<T, N>> {
+  static inline void apply(moab::Ring2<T, N>& r) { r.Clear(); }
 };
 
-template <typename T>
-struct push_back<moab::Ring2<T>> {
-  using point_type = typename moab::Ring2<T>::point_type;
+template <typename T, std::size_t N>
+struct push_back<moab::Ring2<T, N>> {
+  using point_type = typename moab::Ring2<T, N>::point_type;
 
-  static inline void apply(moab::Ring2<T>& r, const point_type& p) {
+  static inline void apply(moab::Ring2<T, N>& r, const point_type& p) {
     r.Append(p);
   }
 };
 
-template <typename T>
-struct resize<moab::Ring2<T>> {
-  static inline void apply(moab::Ring2<T>& r, std::size_t n) { r.Resize(n); }
+template <typename T, std::size_t N>
+struct resize<moab::Ring2<T, N>> {
+  static inline void apply(moab::Ring2<T, N>& r, std::size_t n) { r.Resize(n); }
 };
 
-template <typename T>
-struct point_order<moab::Ring2<T>> {
+template <typename T, std::size_t N>
+struct point_order<moab::Ring2<T, N>> {
   static const order_selector value = counterclockwise;
 };
 
-template <typename T>
-struct closure<moab::Ring2<T>> {
+template <typename T, std::size_t N>
+struct closure<moab::Ring2<T, N>> {
   static const closure_selector value = closed;
 };
 
@@ -192,48 +356,48 @@ struct closure<moab::Ring2<T>> {
 // Boost range traits.
 namespace boost {
 
-template <typename T>
-struct range_mutable_iterator<moab::Ring2<T>> {
-  using type = typename moab::Ring2<T>::mutable_iterator_type;
+template <typename T, std::size_t N>
+struct range_mutable_iterator<moab::Ring2<T, N>> {
+  using type = typename moab::Ring2<T, N>::mutable_iterator_type;
 };
 
-template <typename T>
-struct range_const_iterator<moab::Ring2<T>> {
-  using type = typename moab::Ring2<T>::const_iterator_type;
+template <typename T, std::size_t N>
+struct range_const_iterator<moab::Ring2<T, N>> {
+  using type = typename moab::Ring2<T, N>::const_iterator_type;
 };
 
-template <typename T>
-struct range_size<moab::Ring2<T>> {
+template <typename T, std::size_t N>
+struct range_size<moab::Ring2<T, N>> {
   using type = std::size_t;
 };
 
-template <typename T>
-inline typename range_mutable_iterator<moab::Ring2<T>>::type range_begin(
-    moab::Ring2<T>& r) {
+template <typename T, std::size_t N>
+inline typename range_mutable_iterator<moab::Ring2<T, N>>::type range_begin(
+    moab::Ring2<T, N>& r) {
   return r.begin();
 }
 
-template <typename T>
-inline typename range_mutable_iterator<moab::Ring2<T>>::type range_end(
-    moab::Ring2<T>& r) {
+template <typename T, std::size_t N>
+inline typename range_mutable_iterator<moab::Ring2<T, N>>::type range_end(
+    moab::Ring2<T, N>& r) {
   return r.end();
 }
 
-template <typename T>
-inline typename range_const_iterator<moab::Ring2<T>>::type range_begin(
-    const moab::Ring2<T>& r) {
-  return r.cbegin();
+template <typename T, std::size_t N>
+inline typename range_const_iterator<moab::Ring2<T, N>>::type range_begin(
+    const moab::Ring2<T, N>& r) {
+  return r.begin();
 }
 
-template <typename T>
-inline typename range_const_iterator<moab::Ring2<T>>::type range_end(
-    const moab::Ring2<T>& r) {
-  return r.cend();
+template <typename T, std::size_t N>
+inline typename range_const_iterator<moab::Ring2<T, N>>::type range_end(
+    const moab::Ring2<T, N>& r) {
+  return r.end();
 }
 
-template <typename T>
-inline typename range_const_iterator<moab::Ring2<T>>::type range_calculate_size(
-    const moab::Ring2<T>& r) {
+template <typename T, std::size_t N>
+inline typename range_const_iterator<moab::Ring2<T, N>>::type
+range_calculate_size(const moab::Ring2<T, N>& r) {
   return r.Size();
 }
 
@@ -242,44 +406,52 @@ inline typename range_const_iterator<moab::Ring2<T>>::type range_calculate_size(
 // Boost polygon traits.
 namespace boost::polygon {
 
-template <typename T>
-struct geometry_concept<moab::Ring2<T>> {
+template <typename T, std::size_t N>
+struct geometry_concept<moab::Ring2<T, N>> {
   using type = polygon_concept;
 };
 
-template <typename T>
+template <typename T, std::size_t N>
 struct polygon_traits<
-    moab::Ring2<T>,
-    typename gtl_or_4<typename gtl_same_type<typename geometry_concept<T>::type,
-                                             polygon_concept>::type,
-                      typename gtl_same_type<typename geometry_concept<T>::type,
-                                             polygon_90_concept>::type,
-                      typename gtl_same_type<typename geometry_concept<T>::type,
-                                             polygon_90_set_concept>::type,
-                      typename gtl_same_type<typename geometry_concept<T>::type,
-                                             polygon_45_concept>::type>::type> {
-  using type = moab::Ring2<T>;
-  using coordinate_type = typename moab::Ring2<T>::coordinate_type;
-  using point_type = typename moab::Ring2<T>::point_type;
-  using iterator_type = typename moab::Ring2<T>::const_iterator_type;
-
-  static inline iterator_type begin_points(const moab::Ring2<T>& r) {
-    return r.cbegin();
-  }
-  static inline iterator_type end_points(const moab::Ring2<T>& r) {
-    return r.cend();
-  }
-  static inline std::size_t size(const moab::Ring2<T>& r) { return r.Size(); }
-  static inline winding_direction winding(const moab::Ring2<T>& r) {
-    return winding_direction::unknown_winding;
+    moab::Ring2<T, N>,
+    typename gtl_or_4<
+        typename gtl_same_type<
+            typename geometry_concept<moab::Ring2<T, N>>::type,
+            polygon_concept>::type,
+        typename gtl_same_type<
+            typename geometry_concept<moab::Ring2<T, N>>::type,
+            polygon_45_concept>::type,
+        typename gtl_same_type<
+            typename geometry_concept<moab::Ring2<T, N>>::type,
+            polygon_with_holes_concept>::type,
+        typename gtl_same_type<
+            typename geometry_concept<moab::Ring2<T, N>>::type,
+            polygon_45_with_holes_concept>::type>::type> {
+  using type = moab::Ring2<T, N>;
+  using coordinate_type = typename moab::Ring2<T, N>::coordinate_type;
+  using point_type = typename moab::Ring2<T, N>::point_type;
+  using iterator_type = typename moab::Ring2<T, N>::const_iterator_type;
+
+  static inline iterator_type begin_points(const moab::Ring2<T, N>& r) {
+    return r.begin();
+  }
+  static inline iterator_type end_points(const moab::Ring2<T, N>& r) {
+    return r.end();
+  }
+  static inline std::size_t size(const moab::Ring2<T, N>& r) {
+    return r.Size();
+  }
+  // The cached winding, so Boost does not compute it again.
+  static inline winding_direction winding(const moab::Ring2<T, N>& r) {
+    return r.Winding();
   }
 };
 
-template <typename T>
-struct polygon_mutable_traits<moab::Ring2<T>> {
+template <typename T, std::size_t N>
+struct polygon_mutable_traits<moab::Ring2<T, N>> {
   template <typename iT>
-  static inline moab::Ring2<T>& set_points(moab::Ring2<T>& r, iT input_begin,
-                                           iT input_end) {
+  static inline moab::Ring2<T, N>& set_points(moab::Ring2<T, N>& r,
+                                              iT input_begin, iT input_end) {
     r.Clear();
     while (input_begin != input_end) {
       r.Append(moab::Point2<T>(input_begin->x(), input_begin->y()));
@@ -13,6 +13,7 @@
 namespace moab {
 
 using ::testing::ElementsAre;
+using ::testing::ElementsAreArray;
 using ::testing::Pair;
 using ::testing::StrEq;
 using ::testing::UnorderedElementsAre;
@@ -42,7 +43,8 @@ TEST(Constructor, VectorMove) {
                                   Point2_i(0, 0)};
   Ring2_i r(std::move(points));
 
-  EXPECT_EQ(points.size(), 0);
+  // The points are copied into the inline storage.
+  EXPECT_EQ(points.size(), 5);
   EXPECT_EQ(r.Size(), 5);
   EXPECT_THAT(r.Points(),
               ElementsAre(Point2_i(0, 0), Point2_i(2, 0), Point2_i(2, 2),
@@ -97,6 +99,25 @@ TEST(Constructor, Move) {
                           Point2_i(0, 2), Point2_i(0, 0)));
 }
 
+TEST(Constructor, SpillsToHeap) {
+  std::vector<Point2_i> points;
+  for (int i = 0; i < 8; ++i) {
+    points.emplace_back(i, 0);
+    points.emplace_back(i, 1);
+  }
+  points.emplace_back(0, 0);
+  Ring2<int, 4> r(points);
+  Ring2<int, 4> copy(r);
+  Ring2<int, 4> moved(std::move(copy));
+
+  EXPECT_EQ(r.Size(), 17);
+  EXPECT_THAT(r.Points(), ElementsAreArray(points));
+  EXPECT_EQ(moved, r);
+  r.Resize(5);
+  EXPECT_EQ(r.Size(), 5);
+  EXPECT_EQ(moved.Size(), 17);
+}
+
 TEST(Accessors, Points) {
   Ring2_i r = {Point2_i(0, 0), Point2_i(2, 0), Point2_i(2, 2), Point2_i(0, 2),
                Point2_i(0, 0)};
@@ -217,6 +238,64 @@ TEST(Operations, MaxBoxes) {
       boxes, UnorderedElementsAre(Box2_i(20, 0, 40, 40), Box2_i(0, 0, 40, 20)));
 }
 
+TEST(Operations, IsRectilinear) {
+  Ring2_i r = {Point2_i(0, 0),   Point2_i(40, 0),  Point2_i(40, 40),
+               Point2_i(20, 40), Point2_i(20, 20), Point2_i(0, 20),
+               Point2_i(0, 0)};
+  Ring2_i triangle = {Point2_i(0, 0), Point2_i(2, 0), Point2_i(0, 2),
+                      Point2_i(0, 0)};
+
+  EXPECT_TRUE(r.IsRectilinear());
+  EXPECT_FALSE(triangle.IsRectilinear());
+  EXPECT_TRUE(Ring2_i().IsRectilinear());
+}
+
+TEST(Operations, Winding) {
+  Ring2_i ccw(Box2_i(0, 0, 2, 2));
+  Ring2_i cw = {Point2_i(0, 0), Point2_i(0, 2), Point2_i(2, 2),
+                Point2_i(2, 0), Point2_i(0, 0)};
+
+  EXPECT_EQ(ccw.Winding(), gtl::counterclockwise_winding);
+  EXPECT_EQ(cw.Winding(), gtl::clockwise_winding);
+  EXPECT_EQ(Ring2_i().Winding(), gtl::unknown_winding);
+  // Boost polygon reads the cached winding.
+  EXPECT_EQ(gtl::polygon_traits<Ring2_i>::winding(ccw),
+            gtl::counterclockwise_winding);
+  EXPECT_EQ(gtl::polygon_traits<Ring2_i>::winding(cw),
+            gtl::clockwise_winding);
+  EXPECT_EQ(gtl::winding(cw), gtl::CLOCKWISE);
+}
+
+TEST(Operations, ShapeCache) {
+  Ring2_i r(Box2_i(0, 0, 2, 2));
+  ASSERT_TRUE(r.IsRectilinear());
+  Ring2_i copy = r;
+
+  r.Points()[2] = Point2_i(3, 3);
+  EXPECT_FALSE(r.IsRectilinear());
+  EXPECT_TRUE(copy.IsRectilinear());
+
+  r[2] = Point2_i(2, 2);
+  EXPECT_TRUE(r.IsRectilinear());
+
+  *(r.begin() + 2) = Point2_i(3, 3);
+  EXPECT_FALSE(r.IsRectilinear());
+
+  r.SetPoint(2, Point2_i(2, 2));
+  EXPECT_TRUE(r.IsRectilinear());
+
+  r.UpdatePoints([](auto& points) { points[2] = Point2_i(3, 3); });
+  EXPECT_FALSE(r.IsRectilinear());
+  r.UpdatePoints([](auto& points) { points[2] = Point2_i(2, 2); });
+
+  r.Assign({Point2_i(0, 0), Point2_i(0, 2), Point2_i(2, 0), Point2_i(0, 0)});
+  EXPECT_FALSE(r.IsRectilinear());
+  EXPECT_EQ(r.Winding(), gtl::clockwise_winding);
+
+  copy = std::move(r);
+  EXPECT_FALSE(copy.IsRectilinear());
+}
+
 TEST(Mutators, Clear) {
   Ring2_i r = {Point2_i(0, 0), Point2_i(2, 0), Point2_i(2, 2), Point2_i(0, 2),
                Point2_i(0, 0)};
@@ -310,6 +389,24 @@ TEST(Operations, BloatedRings1) {
   EXPECT_EQ(rings[0].Area(), 20 * 30 + 30 * 50);
 }
 
+TEST(Operations, Canonical) {
+  // Clockwise, starting mid-edge, with a repeated and a collinear point.
+  Ring2_i r = {Point2_i(2, 1), Point2_i(2, 0), Point2_i(0, 0), Point2_i(0, 0),
+               Point2_i(0, 2), Point2_i(1, 2), Point2_i(2, 2), Point2_i(2, 1)};
+
+  EXPECT_THAT(r.Canonical().Points(),
+              ElementsAre(Point2_i(0, 0), Point2_i(2, 0), Point2_i(2, 2),
+                          Point2_i(0, 2), Point2_i(0, 0)));
+  EXPECT_EQ(r.Canonical().Area(), r.Area());
+}
+
+TEST(Operations, CanonicalDegenerate) {
+  Ring2_i r = {Point2_i(0, 0), Point2_i(2, 0), Point2_i(4, 0), Point2_i(0, 0)};
+
+  EXPECT_TRUE(r.Canonical().Empty());
+  EXPECT_TRUE(Ring2_i().Canonical().Empty());
+}
+
 TEST(Operators, Subscript) {
   Ring2_i r = {Point2_i(0, 0), Point2_i(2, 0), Point2_i(2, 2), Point2_i(0, 2),
                Point2_i(0, 0)};
@@ -389,6 +486,12 @@ TEST(Hash, SupportsAbslHash) {
                Point2_i(0, 0)}),
       Ring2_i({Point2_i(0, 0), Point2_i(20, 0), Point2_i(20, 20),
                Point2_i(0, 20), Point2_i(0, 0)}),
+      // Equal to the previous ring: other start point, collinear point.
+      Ring2_i({Point2_i(20, 20), Point2_i(0, 20), Point2_i(0, 0),
+               Point2_i(10, 0), Point2_i(20, 0), Point2_i(20, 20)}),
+      // Clockwise.
+      Ring2_i({Point2_i(20, 20), Point2_i(20, 0), Point2_i(0, 0),
+               Point2_i(0, 20), Point2_i(20, 20)}),
   }));
 }
 
@@ -0,0 +1,287 @@
+#ifndef MOAB_RULE_CHECK_H_
+#define MOAB_RULE_CHECK_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/point2.h"
+#include "moab/rectilinear_grid.h"
+#include "moab/segment2.h"
+
+namespace moab {
+
+namespace gtl = boost::polygon;
+
+// Rule types.
+enum class RuleType {
+  // Distance between two facing edges of the same shape, across its inside.
+  kWidth,
+  // Distance between two facing edges of different shapes, across the
+  // outside.
+  kSpacing,
+  // Distance between two facing edges of the same shape, across the outside.
+  kNotch,
+};
+
+// Rule values. A rule with value 0 is not checked.
+template <typename T>
+struct RuleValues {
+  T min_width = 0;
+  T min_spacing = 0;
+  T min_notch = 0;
+};
+
+// A rule violation between two parallel edges.
+template <typename T>
+struct RuleViolation {
+  RuleType type;
+  // The two edges, edge1 below (left of) edge2.
+  Segment2<T> edge1;
+  Segment2<T> edge2;
+  // The part of the area between the edges where they face each other.
+  Box2<T> region;
+};
+
+namespace rule_check_internal {
+
+// A horizontal boundary edge. Vertical edges are checked as horizontal edges
+// of the transposed layout.
+template <typename T>
+struct Edge {
+  T pos;              // y coordinate.
+  T lo;               // Lowest x.
+  T hi;               // Highest x.
+  bool interior_up;   // True if the shape is above the edge.
+  std::size_t shape;  // Connected shape index.
+};
+
+// A violation piece between edges (edge indices) below and above.
+template <typename T>
+struct Piece {
+  RuleType type;
+  std::size_t below;
+  std::size_t above;
+  T lo;
+  T hi;
+};
+
+// Appends the boundary edges of the polygons. Horizontal edges go to h and
+// vertical edges go to v, transposed.
+template <typename T>
+void CollectEdges(
+    const std::vector<gtl::polygon_90_with_holes_data<T>>& polygons,
+    std::vector<Edge<T>>& h, std::vector<Edge<T>>& v) {
+  auto add_ring = [&](auto first, auto last, bool outer, std::size_t shape) {
+    std::vector<gtl::point_data<T>> pts(first, last);
+    if (pts.size() < 4) return;
+    int64_t area2 = 0;
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+      const auto& p = pts[i];
+      const auto& q = pts[(i + 1) % pts.size()];
+      area2 += static_cast<int64_t>(p.x()) * q.y() -
+               static_cast<int64_t>(q.x()) * p.y();
+    }
+    // The shape lies on the left of every edge of a counterclockwise outer
+    // ring and of a clockwise hole.
+    const bool left_inside = (area2 > 0) == outer;
+    for (std::size_t i = 0; i < pts.size(); ++i) {
+      const auto& p = pts[i];
+      const auto& q = pts[(i + 1) % pts.size()];
+      if (p.y() == q.y() && p.x() != q.x()) {
+        h.push_back({p.y(), std::min(p.x(), q.x()), std::max(p.x(), q.x()),
+                     (q.x() > p.x()) == left_inside, shape});
+      } else if (p.x() == q.x() && p.y() != q.y()) {
+        v.push_back({p.x(), std::min(p.y(), q.y()), std::max(p.y(), q.y()),
+                     (q.y() > p.y()) != left_inside, shape});
+      }
+    }
+  };
+  for (std::size_t s = 0; s < polygons.size(); ++s) {
+    const auto& poly = polygons[s];
+    add_ring(poly.begin(), poly.end(), true, s);
+    for (auto it = poly.begin_holes(); it != poly.end_holes(); ++it) {
+      add_ring(it->begin(), it->end(), false, s);
+    }
+  }
+}
+
+// Checks the edges (sorted by pos) whose x range overlaps [x0, x1), clipped
+// to it. Every edge is compared with the nearest edge below it over each part
+// of its x range, so edges hidden behind other edges are never reported.
+template <typename T>
+std::vector<Piece<T>> SweepStripe(const std::vector<Edge<T>>& edges, T x0,
+                                  T x1, const RuleValues<T>& rules) {
+  constexpr std::size_t kNone = static_cast<std::size_t>(-1);
+  std::vector<Piece<T>> pieces;
+  // Piecewise constant map from x to the nearest edge below the sweep line.
+  // Key: start of a piece, value: edge index. The piece ends at the next key.
+  std::map<T, std::size_t> below = {{x0, kNone}, {x1, kNone}};
+  auto split = [&below](T x) {
+    auto it = std::prev(below.upper_bound(x));
+    if (it->first != x) below.emplace_hint(std::next(it), x, it->second);
+  };
+  std::size_t first = 0;
+  while (first < edges.size()) {
+    std::size_t last = first;
+    while (last < edges.size() && edges[last].pos == edges[first].pos) ++last;
+    // Queries at this y see only the edges strictly below it.
+    for (std::size_t k = first; k < last; ++k) {
+      const Edge<T>& e = edges[k];
+      const T lo = std::max(e.lo, x0), hi = std::min(e.hi, x1);
+      if (lo >= hi) continue;
+      for (auto it = std::prev(below.upper_bound(lo)); it->first < hi; ++it) {
+        const std::size_t f = it->second;
+        if (f == kNone) continue;
+        const Edge<T>& b = edges[f];
+        // Facing edges only: inside (outside) below and above for width
+        // (spacing and notch).
+        if (b.interior_up != !e.interior_up) continue;
+        RuleType type;
+        T limit;
+        if (b.interior_up) {
+          type = RuleType::kWidth;
+          limit = rules.min_width;
+        } else if (b.shape == e.shape) {
+          type = RuleType::kNotch;
+          limit = rules.min_notch;
+        } else {
+          type = RuleType::kSpacing;
+          limit = rules.min_spacing;
+        }
+        if (e.pos - b.pos >= limit) continue;
+        pieces.push_back({type, f, k, std::max(it->first, lo),
+                          std::min(std::next(it)->first, hi)});
+      }
+    }
+    for (std::size_t k = first; k < last; ++k) {
+      const Edge<T>& e = edges[k];
+      const T lo = std::max(e.lo, x0), hi = std::min(e.hi, x1);
+      if (lo >= hi) continue;
+      split(lo);
+      split(hi);
+      auto begin = below.find(lo);
+      below.erase(std::next(begin), below.find(hi));
+      begin->second = k;
+    }
+    first = last;
+  }
+  return pieces;
+}
+
+// Checks the horizontal edges on up to num_threads threads. The x range is
+// cut into stripes that are swept independently; a pair of horizontal edges
+// only interacts over the x range they share, so stripes need no halo. Pieces
+// of the same edge pair that meet at a stripe border are merged.
+template <typename T>
+std::vector<Piece<T>> Sweep(std::vector<Edge<T>>& edges,
+                            const RuleValues<T>& rules,
+                            std::size_t num_threads) {
+  if (edges.empty()) return {};
+  std::sort(edges.begin(), edges.end(), [](const Edge<T>& a, const Edge<T>& b) {
+    return a.pos < b.pos;
+  });
+  T xmin = edges[0].lo, xmax = edges[0].hi;
+  for (const Edge<T>& e : edges) {
+    xmin = std::min(xmin, e.lo);
+    xmax = std::max(xmax, e.hi);
+  }
+  constexpr std::size_t kMinEdgesPerStripe = 1024;
+  const std::size_t stripes =
+      NumBlocks(edges.size(), num_threads, kMinEdgesPerStripe);
+  using W = std::conditional_t<std::is_integral_v<T>, int64_t, double>;
+  auto border = [&](std::size_t s) {
+    if (s == stripes) return xmax;
+    return static_cast<T>(xmin + static_cast<W>(xmax - xmin) *
+                                     static_cast<W>(s) /
+                                     static_cast<W>(stripes));
+  };
+  std::vector<std::vector<Piece<T>>> results(stripes);
+  ParallelFor(stripes, num_threads, [&](std::size_t s) {
+    if (border(s) < border(s + 1)) {
+      results[s] = SweepStripe(edges, border(s), border(s + 1), rules);
+    }
+  });
+  std::vector<Piece<T>> pieces;
+  for (std::vector<Piece<T>>& r : results) {
+    pieces.insert(pieces.end(), r.begin(), r.end());
+  }
+  std::sort(pieces.begin(), pieces.end(),
+            [](const Piece<T>& a, const Piece<T>& b) {
+              return std::tie(a.below, a.above, a.lo) <
+                     std::tie(b.below, b.above, b.lo);
+            });
+  std::vector<Piece<T>> merged;
+  for (const Piece<T>& p : pieces) {
+    if (!merged.empty() && merged.back().below == p.below &&
+        merged.back().above == p.above && merged.back().hi == p.lo) {
+      merged.back().hi = p.hi;
+    } else {
+      merged.push_back(p);
+    }
+  }
+  return merged;
+}
+
+}  // namespace rule_check_internal
+
+// Checks min-width, min-spacing and notch rules on a Box2, a rectilinear ring,
+// or a polygon set (e.g., a std::vector of Box2 or Ring2). Overlapping input
+// shapes are merged first.
+//
+// Rules are measured edge to edge: two parallel boundary edges that face each
+// other with nothing in between and closer than the rule value violate it over
+// the part where their projections overlap. Corner-to-corner distances are not
+// checked. Violations are sorted by type and region.
+template <typename Geometry>
+std::vector<RuleViolation<coordinate_of_t<Geometry>>> CheckRules(
+    const Geometry& g, const RuleValues<coordinate_of_t<Geometry>>& rules,
+    std::size_t num_threads = 0) {
+  using T = coordinate_of_t<Geometry>;
+  namespace internal = rule_check_internal;
+  const std::vector<Box2<T>> boxes = ToBoxes<T>(g);
+  gtl::polygon_90_set_data<T> ps;
+  ps.insert(boxes.begin(), boxes.end());
+  std::vector<gtl::polygon_90_with_holes_data<T>> polygons;
+  ps.get(polygons);
+
+  std::vector<internal::Edge<T>> h, v;
+  internal::CollectEdges(polygons, h, v);
+  std::vector<RuleViolation<T>> violations;
+  auto report = [&violations](const std::vector<internal::Edge<T>>& edges,
+                              const std::vector<internal::Piece<T>>& pieces,
+                              bool transposed) {
+    for (const internal::Piece<T>& p : pieces) {
+      const internal::Edge<T>& b = edges[p.below];
+      const internal::Edge<T>& a = edges[p.above];
+      if (transposed) {
+        violations.push_back({p.type, Segment2<T>(b.pos, b.lo, b.pos, b.hi),
+                              Segment2<T>(a.pos, a.lo, a.pos, a.hi),
+                              Box2<T>(b.pos, p.lo, a.pos, p.hi)});
+      } else {
+        violations.push_back({p.type, Segment2<T>(b.lo, b.pos, b.hi, b.pos),
+                              Segment2<T>(a.lo, a.pos, a.hi, a.pos),
+                              Box2<T>(p.lo, b.pos, p.hi, a.pos)});
+      }
+    }
+  };
+  report(h, internal::Sweep(h, rules, num_threads), false);
+  report(v, internal::Sweep(v, rules, num_threads), true);
+  std::sort(violations.begin(), violations.end(),
+            [](const RuleViolation<T>& a, const RuleViolation<T>& b) {
+              return std::tie(a.type, a.region) < std::tie(b.type, b.region);
+            });
+  return violations;
+}
+
+}  // namespace moab
+
+#endif  // MOAB_RULE_CHECK_H_
@@ -0,0 +1,138 @@
+#include "rule_check.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+#include "moab/segment2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+MATCHER_P2(IsViolation, type, region, "") {
+  return arg.type == type && arg.region == region;
+}
+
+TEST(CheckRules, Empty) {
+  EXPECT_THAT(CheckRules(std::vector<Box2_i>(), RuleValues<int>{10, 10, 10}),
+              ElementsAre());
+}
+
+TEST(CheckRules, Width) {
+  RuleValues<int> rules;
+  rules.min_width = 20;
+  std::vector<RuleViolation<int>> v = CheckRules(Box2_i(0, 0, 10, 100), rules);
+
+  ASSERT_THAT(v, ElementsAre(IsViolation(RuleType::kWidth,
+                                         Box2_i(0, 0, 10, 100))));
+  EXPECT_EQ(v[0].edge1, Segment2_i(0, 0, 0, 100));
+  EXPECT_EQ(v[0].edge2, Segment2_i(10, 0, 10, 100));
+}
+
+TEST(CheckRules, Spacing) {
+  RuleValues<int> rules;
+  rules.min_spacing = 10;
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 10, 10), Box2_i(15, 0, 25, 10)};
+
+  EXPECT_THAT(CheckRules(boxes, rules),
+              ElementsAre(IsViolation(RuleType::kSpacing,
+                                      Box2_i(10, 0, 15, 10))));
+}
+
+TEST(CheckRules, SpacingPartialProjection) {
+  RuleValues<int> rules;
+  rules.min_spacing = 5;
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 10, 10), Box2_i(5, 12, 20, 20)};
+
+  EXPECT_THAT(CheckRules(boxes, rules),
+              ElementsAre(IsViolation(RuleType::kSpacing,
+                                      Box2_i(5, 10, 10, 12))));
+}
+
+TEST(CheckRules, HiddenEdgesAreSkipped) {
+  RuleValues<int> rules;
+  rules.min_spacing = 20;
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 10, 10), Box2_i(0, 15, 10, 20),
+                               Box2_i(0, 25, 10, 30)};
+
+  EXPECT_THAT(
+      CheckRules(boxes, rules),
+      ElementsAre(IsViolation(RuleType::kSpacing, Box2_i(0, 10, 10, 15)),
+                  IsViolation(RuleType::kSpacing, Box2_i(0, 20, 10, 25))));
+}
+
+TEST(CheckRules, Notch) {
+  // U shape with a 10 wide slot.
+  Ring2_i u = {Point2_i(0, 0),   Point2_i(30, 0),  Point2_i(30, 30),
+               Point2_i(20, 30), Point2_i(20, 10), Point2_i(10, 10),
+               Point2_i(10, 30), Point2_i(0, 30),  Point2_i(0, 0)};
+  RuleValues<int> rules;
+  rules.min_spacing = 15;
+
+  EXPECT_THAT(CheckRules(u, rules), ElementsAre());
+
+  rules.min_notch = 15;
+
+  EXPECT_THAT(CheckRules(u, rules),
+              ElementsAre(IsViolation(RuleType::kNotch,
+                                      Box2_i(10, 10, 20, 30))));
+}
+
+TEST(CheckRules, Hole) {
+  // A 30 x 30 square with a 10 x 10 hole.
+  std::vector<Box2_i> boxes = {Box2_i(0, 0, 30, 10), Box2_i(0, 20, 30, 30),
+                               Box2_i(0, 0, 10, 30), Box2_i(20, 0, 30, 30)};
+  RuleValues<int> rules;
+  rules.min_width = 15;
+
+  // Only the sides of the hole are narrower than 15.
+  EXPECT_THAT(
+      CheckRules(boxes, rules),
+      ElementsAre(IsViolation(RuleType::kWidth, Box2_i(0, 10, 10, 20)),
+                  IsViolation(RuleType::kWidth, Box2_i(10, 0, 20, 10)),
+                  IsViolation(RuleType::kWidth, Box2_i(10, 20, 20, 30)),
+                  IsViolation(RuleType::kWidth, Box2_i(20, 10, 30, 20))));
+}
+
+TEST(CheckRules, RandomParallelMatchesSerial) {
+  std::mt19937 gen(29);
+  std::uniform_int_distribution<int> pos(0, 20000);
+  std::uniform_int_distribution<int> size(1, 30);
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < 3000; ++i) {
+    int x = pos(gen), y = pos(gen);
+    boxes.push_back(Box2_i(x, y, x + size(gen), y + size(gen)));
+  }
+  RuleValues<int> rules = {10, 10, 10};
+  std::vector<RuleViolation<int>> serial = CheckRules(boxes, rules, 1);
+  std::vector<RuleViolation<int>> parallel = CheckRules(boxes, rules, 4);
+
+  ASSERT_EQ(serial.size(), parallel.size());
+  for (std::size_t i = 0; i < serial.size(); ++i) {
+    EXPECT_EQ(serial[i].type, parallel[i].type);
+    EXPECT_EQ(serial[i].region, parallel[i].region);
+    EXPECT_EQ(serial[i].edge1, parallel[i].edge1);
+    EXPECT_EQ(serial[i].edge2, parallel[i].edge2);
+  }
+  // Width regions lie inside the shapes, spacing and notch regions outside.
+  ASSERT_GT(serial.size(), 100);
+  for (std::size_t i = 0; i < serial.size(); i += serial.size() / 100) {
+    const RuleViolation<int>& v = serial[i];
+    std::vector<Box2_i> inside = {v.region};
+    IntersectionSet(inside, boxes);
+    if (v.type == RuleType::kWidth) {
+      EXPECT_EQ(Area(inside), v.region.Area());
+    } else {
+      EXPECT_EQ(Area(inside), 0);
+    }
+  }
+}
+
+}  // namespace moab
@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "absl/hash/hash.h"
@@ -32,9 +33,14 @@ class Segment2 {
   using point_type = Point2<T>;
 
   // Constructors.
-  Segment2() : d_({Point2<T>(0, 0), Point2<T>(0, 0)}) {}
-  explicit Segment2(const Point2<T>& p0, const Point2<T>& p1) { Set(p0, p1); }
-  explicit Segment2(T x0, T y0, T x1, T y1) { Set(x0, y0, x1, y1); }
+  constexpr Segment2() noexcept : d_({Point2<T>(0, 0), Point2<T>(0, 0)}) {}
+  constexpr explicit Segment2(const Point2<T>& p0,
+                              const Point2<T>& p1) noexcept {
+    Set(p0, p1);
+  }
+  constexpr explicit Segment2(T x0, T y0, T x1, T y1) noexcept {
+    Set(x0, y0, x1, y1);
+  }
   explicit Segment2(const Segment2Proto& proto) { SetFromProto(proto); }
   Segment2(const Segment2&) = default;
   Segment2(Segment2&&) = default;
@@ -45,85 +51,113 @@ class Segment2 {
   Segment2& operator=(Segment2&&) = default;
 
   // Accessors.
-  Point2<T>& p0() { return d_[0]; }
-  const Point2<T>& p0() const { return d_.at(0); }
-  Point2<T>& p1() { return d_[1]; }
-  const Point2<T>& p1() const { return d_.at(1); }
-  Point2<T>* data() { return d_.data(); }
-  const Point2<T>* data() const { return d_.data(); }
+  constexpr Point2<T>& p0() noexcept { return d_[0]; }
+  constexpr const Point2<T>& p0() const noexcept { return d_[0]; }
+  constexpr Point2<T>& p1() noexcept { return d_[1]; }
+  constexpr const Point2<T>& p1() const noexcept { return d_[1]; }
+  constexpr Point2<T>* data() noexcept { return d_.data(); }
+  constexpr const Point2<T>* data() const noexcept { return d_.data(); }
 
-  constexpr std::size_t Size() const { return d_.size(); }
+  constexpr std::size_t Size() const noexcept { return d_.size(); }
 
-  std::pair<Point2<T>, Point2<T>> ToPair() const { return {d_[0], d_[1]}; }
+  constexpr std::pair<Point2<T>, Point2<T>> ToPair() const noexcept {
+    return {d_[0], d_[1]};
+  }
 
-  T Length() const { return d_[0].Distance(d_[1]); }
+  constexpr T Length() const noexcept { return d_[0].Distance(d_[1]); }
 
-  T xl() const { return d_[0].x() < d_[1].x() ? d_[0].x() : d_[1].x(); }
-  T yl() const { return d_[0].y() < d_[1].y() ? d_[0].y() : d_[1].y(); }
-  T xh() const { return d_[0].x() > d_[1].x() ? d_[0].x() : d_[1].x(); }
-  T yh() const { return d_[0].y() > d_[1].y() ? d_[0].y() : d_[1].y(); }
+  constexpr T xl() const noexcept {
+    return d_[0].x() < d_[1].x() ? d_[0].x() : d_[1].x();
+  }
+  constexpr T yl() const noexcept {
+    return d_[0].y() < d_[1].y() ? d_[0].y() : d_[1].y();
+  }
+  constexpr T xh() const noexcept {
+    return d_[0].x() > d_[1].x() ? d_[0].x() : d_[1].x();
+  }
+  constexpr T yh() const noexcept {
+    return d_[0].y() > d_[1].y() ? d_[0].y() : d_[1].y();
+  }
 
-  T MinX() const { return xl(); }
-  T MinY() const { return yl(); }
-  T MaxX() const { return xh(); }
-  T MaxY() const { return yh(); }
+  constexpr T MinX() const noexcept { return xl(); }
+  constexpr T MinY() const noexcept { return yl(); }
+  constexpr T MaxX() const noexcept { return xh(); }
+  constexpr T MaxY() const noexcept { return yh(); }
 
-  Point2<T>& MinPoint() { return d_[0] < d_[1] ? d_[0] : d_[1]; }
-  const Point2<T>& MinPoint() const { return d_[0] < d_[1] ? d_[0] : d_[1]; }
-  Point2<T>& MaxPoint() { return d_[0] > d_[1] ? d_[0] : d_[1]; }
-  const Point2<T>& MaxPoint() const { return d_[0] > d_[1] ? d_[0] : d_[1]; }
+  constexpr Point2<T>& MinPoint() noexcept {
+    return d_[0] < d_[1] ? d_[0] : d_[1];
+  }
+  constexpr const Point2<T>& MinPoint() const noexcept {
+    return d_[0] < d_[1] ? d_[0] : d_[1];
+  }
+  constexpr Point2<T>& MaxPoint() noexcept {
+    return d_[0] > d_[1] ? d_[0] : d_[1];
+  }
+  constexpr const Point2<T>& MaxPoint() const noexcept {
+    return d_[0] > d_[1] ? d_[0] : d_[1];
+  }
 
   // Mutators.
-  void Set(T x0, T y0, T x1, T y1) {
+  constexpr void Set(T x0, T y0, T x1, T y1) noexcept {
     d_[0].Set(x0, y0);
     d_[1].Set(x1, y1);
   }
-  void Set(const Point2<T>& p0, const Point2<T>& p1) {
+  constexpr void Set(const Point2<T>& p0, const Point2<T>& p1) noexcept {
     d_[0] = p0;
     d_[1] = p1;
   }
-  void SetP0(const Point2<T>& p) { d_[0] = p; }
-  void SetP1(const Point2<T>& p) { d_[1] = p; }
+  constexpr void SetP0(const Point2<T>& p) noexcept { d_[0] = p; }
+  constexpr void SetP1(const Point2<T>& p) noexcept { d_[1] = p; }
   void SetP(std::size_t i, const Point2<T>& p) {
     DCHECK(i < 2) << "Invalid index. i: " << i;
     d_[i] = p;
   }
 
   // Operations.
-  void Shift(T dx, T dy) {
+  constexpr void Shift(T dx, T dy) noexcept {
     d_[0].Shift(dx, dy);
     d_[1].Shift(dx, dy);
   }
-  void ShiftX(T dx) {
+  constexpr void ShiftX(T dx) noexcept {
     d_[0].ShiftX(dx);
     d_[1].ShiftX(dx);
   }
-  void ShiftY(T dy) {
+  constexpr void ShiftY(T dy) noexcept {
     d_[0].ShiftY(dy);
     d_[1].ShiftY(dy);
   }
 
   // Operators.
   // Operators - Subscript
-  Point2<T>& operator[](std::size_t i) { return d_[i]; }
-  const Point2<T>& operator[](std::size_t i) const { return d_.at(i); }
+  constexpr Point2<T>& operator[](std::size_t i) noexcept { return d_[i]; }
+  constexpr const Point2<T>& operator[](std::size_t i) const noexcept {
+    return d_[i];
+  }
   // Operators - Equality
-  bool operator==(const Segment2& p) const {
+  constexpr bool operator==(const Segment2& p) const noexcept {
     return d_[0] == p.d_[0] && d_[1] == p.d_[1];
   }
-  bool operator!=(const Segment2& p) const { return !(*this == p); }
+  constexpr bool operator!=(const Segment2& p) const noexcept {
+    return !(*this == p);
+  }
   // Operators - Inequality
-  bool operator<(const Segment2& p) const {
+  constexpr bool operator<(const Segment2& p) const noexcept {
     return d_[0] != p.d_[0] ? d_[0] < p.d_[0] : d_[1] < p.d_[1];
   }
-  bool operator>(const Segment2& p) const { return p < *this; }
-  bool operator<=(const Segment2& p) const { return !(*this > p); }
-  bool operator>=(const Segment2& p) const { return !(*this < p); }
+  constexpr bool operator>(const Segment2& p) const noexcept {
+    return p < *this;
+  }
+  constexpr bool operator<=(const Segment2& p) const noexcept {
+    return !(*this > p);
+  }
+  constexpr bool operator>=(const Segment2& p) const noexcept {
+    return !(*this < p);
+  }
 
   // String conversion.
   template <typename Sink>
   friend void AbslStringify(Sink& sink, const Segment2& s) {
-    absl::Format(&sink, "(%v %v)", s.d_.at(0), s.d_.at(1));
+    absl::Format(&sink, "(%v %v)", s.d_[0], s.d_[1]);
   }
   std::string ToString() const { return absl::StrCat(*this); }
   friend std::ostream& operator<<(std::ostream& os, const Segment2& s) {
@@ -134,7 +168,7 @@ class Segment2 {
   // Hash.
   template <typename H>
   friend H AbslHashValue(H h, const Segment2& s) {
-    return H::combine(std::move(h), s.d_.at(0), s.d_.at(1));
+    return H::combine(std::move(h), s.d_[0], s.d_[1]);
   }
 
   // Protobuf.
@@ -201,6 +235,10 @@ using Segment2_i = Segment2<int>;
 using Segment2_i32 = Segment2<int32_t>;
 using Segment2_i64 = Segment2<int64_t>;
 
+static_assert(std::is_trivially_copyable_v<Segment2_i>);
+static_assert(std::is_nothrow_default_constructible_v<Segment2_i>);
+static_assert(Segment2_i(Point2_i(0, 0), Point2_i(3, 4)).Length() == 7);
+
 }  // namespace moab
 
 // Boost geometry traits.
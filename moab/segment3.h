@@ -5,6 +5,7 @@
 #include <cstdint>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <utility>
 
 #include "absl/hash/hash.h"
@@ -31,9 +32,13 @@ class Segment3 {
   using point_type = Point3<T>;
 
   // Constructors.
-  Segment3() : d_({Point3<T>(0, 0, 0), Point3<T>(0, 0, 0)}) {}
-  explicit Segment3(const Point3<T>& p0, const Point3<T>& p1) { Set(p0, p1); }
-  explicit Segment3(T xl, T yl, T zl, T xh, T yh, T zh) {
+  constexpr Segment3() noexcept
+      : d_({Point3<T>(0, 0, 0), Point3<T>(0, 0, 0)}) {}
+  constexpr explicit Segment3(const Point3<T>& p0,
+                              const Point3<T>& p1) noexcept {
+    Set(p0, p1);
+  }
+  constexpr explicit Segment3(T xl, T yl, T zl, T xh, T yh, T zh) noexcept {
     Set(xl, yl, zl, xh, yh, zh);
   }
   explicit Segment3(const Segment3Proto& proto) { SetFromProto(proto); }
@@ -46,49 +51,71 @@ class Segment3 {
   Segment3& operator=(Segment3&&) = default;
 
   // Accessors.
-  Point3<T>& p0() { return d_[0]; }
-  const Point3<T>& p0() const { return d_.at(0); }
-  Point3<T>& p1() { return d_[1]; }
-  const Point3<T>& p1() const { return d_.at(1); }
-  Point3<T>* data() { return d_.data(); }
-  const Point3<T>* data() const { return d_.data(); }
-
-  constexpr std::size_t Size() const { return d_.size(); }
-
-  std::pair<Point3<T>, Point3<T>> ToPair() const { return {d_[0], d_[1]}; }
-
-  T Length() const { return d_[0].Distance(d_[1]); }
-
-  T xl() const { return d_[0].x() < d_[1].x() ? d_[0].x() : d_[1].x(); }
-  T yl() const { return d_[0].y() < d_[1].y() ? d_[0].y() : d_[1].y(); }
-  T zl() const { return d_[0].z() < d_[1].z() ? d_[0].z() : d_[1].z(); }
-  T xh() const { return d_[0].x() > d_[1].x() ? d_[0].x() : d_[1].x(); }
-  T yh() const { return d_[0].y() > d_[1].y() ? d_[0].y() : d_[1].y(); }
-  T zh() const { return d_[0].z() > d_[1].z() ? d_[0].z() : d_[1].z(); }
-
-  T MinX() const { return xl(); }
-  T MinY() const { return yl(); }
-  T MinZ() const { return zl(); }
-  T MaxX() const { return xh(); }
-  T MaxY() const { return yh(); }
-  T MaxZ() const { return zh(); }
-
-  Point3<T>& MinPoint() { return d_[0] < d_[1] ? d_[0] : d_[1]; }
-  const Point3<T>& MinPoint() const { return d_[0] < d_[1] ? d_[0] : d_[1]; }
-  Point3<T>& MaxPoint() { return d_[0] > d_[1] ? d_[0] : d_[1]; }
-  const Point3<T>& MaxPoint() const { return d_[0] > d_[1] ? d_[0] : d_[1]; }
+  constexpr Point3<T>& p0() noexcept { return d_[0]; }
+  constexpr const Point3<T>& p0() const noexcept { return d_[0]; }
+  constexpr Point3<T>& p1() noexcept { return d_[1]; }
+  constexpr const Point3<T>& p1() const noexcept { return d_[1]; }
+  constexpr Point3<T>* data() noexcept { return d_.data(); }
+  constexpr const Point3<T>* data() const noexcept { return d_.data(); }
+
+  constexpr std::size_t Size() const noexcept { return d_.size(); }
+
+  constexpr std::pair<Point3<T>, Point3<T>> ToPair() const noexcept {
+    return {d_[0], d_[1]};
+  }
+
+  constexpr T Length() const noexcept { return d_[0].Distance(d_[1]); }
+
+  constexpr T xl() const noexcept {
+    return d_[0].x() < d_[1].x() ? d_[0].x() : d_[1].x();
+  }
+  constexpr T yl() const noexcept {
+    return d_[0].y() < d_[1].y() ? d_[0].y() : d_[1].y();
+  }
+  constexpr T zl() const noexcept {
+    return d_[0].z() < d_[1].z() ? d_[0].z() : d_[1].z();
+  }
+  constexpr T xh() const noexcept {
+    return d_[0].x() > d_[1].x() ? d_[0].x() : d_[1].x();
+  }
+  constexpr T yh() const noexcept {
+    return d_[0].y() > d_[1].y() ? d_[0].y() : d_[1].y();
+  }
+  constexpr T zh() const noexcept {
+    return d_[0].z() > d_[1].z() ? d_[0].z() : d_[1].z();
+  }
+
+  constexpr T MinX() const noexcept { return xl(); }
+  constexpr T MinY() const noexcept { return yl(); }
+  constexpr T MinZ() const noexcept { return zl(); }
+  constexpr T MaxX() const noexcept { return xh(); }
+  constexpr T MaxY() const noexcept { return yh(); }
+  constexpr T MaxZ() const noexcept { return zh(); }
+
+  constexpr Point3<T>& MinPoint() noexcept {
+    return d_[0] < d_[1] ? d_[0] : d_[1];
+  }
+  constexpr const Point3<T>& MinPoint() const noexcept {
+    return d_[0] < d_[1] ? d_[0] : d_[1];
+  }
+  constexpr Point3<T>& MaxPoint() noexcept {
+    return d_[0] > d_[1] ? d_[0] : d_[1];
+  }
+  constexpr const Point3<T>& MaxPoint() const noexcept {
+    return d_[0] > d_[1] ? d_[0] : d_[1];
+  }
 
   // Mutators.
-  void Set(T x0, T y0, T z0, T x1, T y1, T z1) {
+  constexpr void Set(T x0, T y0, T z0, T x1, T y1, T z1) noexcept {
     d_[0].Set(x0, y0, z0);
     d_[1].Set(x1, y1, z1);
   }
-  void Set(const Point3<T>& p0, const Point3<T>& p1) {
+  constexpr void Set(const Point3<T>& p0, const Point3<T>& p1) noexcept {
     d_[0] = p0;
     d_[1] = p1;
   }
-  void SetP0(const Point3<T>& p) { d_[0] = p; }
-  void SetP1(const Point3<T>& p) { d_[1] = p; }
+  constexpr void SetP0(const Point3<T>& p) noexcept { d_[0] = p; }
+  constexpr void SetP1(const Point3<T>& p) noexcept { d_[1] = p; }
   void SetP(std::size_t i, const Point3<T>& p) {
     DCHECK(i < 2) << "Invalid SetP Index i" << i;
     d_[i] = p;
@@ -96,44 +123,54 @@ class Segment3 {
 
   // Operations.
   // It's safe. No need to check for validity.
-  void Shift(T dx, T dy, T dz) {
+  constexpr void Shift(T dx, T dy, T dz) noexcept {
     d_[0].Shift(dx, dy, dz);
     d_[1].Shift(dx, dy, dz);
   }
-  void ShiftX(T dx) {
+  constexpr void ShiftX(T dx) noexcept {
     d_[0].ShiftX(dx);
     d_[1].ShiftX(dx);
   }
-  void ShiftY(T dy) {
+  constexpr void ShiftY(T dy) noexcept {
     d_[0].ShiftY(dy);
     d_[1].ShiftY(dy);
   }
-  void ShiftZ(T dz) {
+  constexpr void ShiftZ(T dz) noexcept {
     d_[0].ShiftZ(dz);
     d_[1].ShiftZ(dz);
   }
 
   // Operators.
   // Operators - Subscript
-  Point3<T>& operator[](std::size_t i) { return d_[i]; }
-  const Point3<T>& operator[](std::size_t i) const { return d_.at(i); }
+  constexpr Point3<T>& operator[](std::size_t i) noexcept { return d_[i]; }
+  constexpr const Point3<T>& operator[](std::size_t i) const noexcept {
+    return d_[i];
+  }
   // Operators - Equality
-  bool operator==(const Segment3& p) const {
+  constexpr bool operator==(const Segment3& p) const noexcept {
     return d_[0] == p.d_[0] && d_[1] == p.d_[1];
   }
-  bool operator!=(const Segment3& p) const { return !(*this == p); }
+  constexpr bool operator!=(const Segment3& p) const noexcept {
+    return !(*this == p);
+  }
   // Operators - Inequality
-  bool operator<(const Segment3& p) const {
+  constexpr bool operator<(const Segment3& p) const noexcept {
     return d_[0] != p.d_[0] ? d_[0] < p.d_[0] : d_[1] < p.d_[1];
   }
-  bool operator>(const Segment3& p) const { return p < *this; }
-  bool operator<=(const Segment3& p) const { return !(*this > p); }
-  bool operator>=(const Segment3& p) const { return !(*this < p); }
+  constexpr bool operator>(const Segment3& p) const noexcept {
+    return p < *this;
+  }
+  constexpr bool operator<=(const Segment3& p) const noexcept {
+    return !(*this > p);
+  }
+  constexpr bool operator>=(const Segment3& p) const noexcept {
+    return !(*this < p);
+  }
 
   // String conversion.
   template <typename Sink>
   friend void AbslStringify(Sink& sink, const Segment3& s) {
-    absl::Format(&sink, "(%v %v)", s.d_.at(0), s.d_.at(1));
+    absl::Format(&sink, "(%v %v)", s.d_[0], s.d_[1]);
   }
   std::string ToString() const { return absl::StrCat(*this); }
   friend std::ostream& operator<<(std::ostream& os, const Segment3& s) {
@@ -144,7 +181,7 @@ class Segment3 {
   // Hash.
   template <typename H>
   friend H AbslHashValue(H h, const Segment3& s) {
-    return H::combine(std::move(h), s.d_.at(0), s.d_.at(1));
+    return H::combine(std::move(h), s.d_[0], s.d_[1]);
   }
 
   // Protobuf.
@@ -223,6 +260,10 @@ using Segment3_i = Segment3<int>;
 using Segment3_i32 = Segment3<int32_t>;
 using Segment3_i64 = Segment3<int64_t>;
 
+static_assert(std::is_trivially_copyable_v<Segment3_i>);
+static_assert(std::is_nothrow_default_constructible_v<Segment3_i>);
+static_assert(Segment3_i(Point3_i(0, 0, 0), Point3_i(1, 2, 3)).Length() == 6);
+
 }  // namespace moab
 
 // Boost geometry traits.
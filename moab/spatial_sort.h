@@ -0,0 +1,237 @@
+#ifndef MOAB_SPATIAL_SORT_H_
+#define MOAB_SPATIAL_SORT_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/numeric/bits.h"
+#include "moab/box2.h"
+#include "moab/parallel.h"
+#include "moab/point2.h"
+#include "moab/segment2.h"
+
+#if defined(__BMI2__)
+#include <immintrin.h>
+#endif
+
+namespace moab {
+
+// Space-filling curves that map a 2D grid cell to a 1D key. Cells with close
+// keys are close in space; the Hilbert curve keeps more locality, the Morton
+// (Z-order) curve is cheaper to compute.
+enum class SpatialCurve : uint8_t {
+  kMorton,
+  kHilbert,
+};
+
+namespace spatial_sort_internal {
+
+// Spreads the bits of v to the even bits of the result.
+constexpr uint64_t SpreadBits(uint32_t v) {
+  uint64_t x = v;
+  x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+  x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+  x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+  x = (x | (x << 2)) & 0x3333333333333333ull;
+  x = (x | (x << 1)) & 0x5555555555555555ull;
+  return x;
+}
+
+}  // namespace spatial_sort_internal
+
+// Returns the Morton key of grid cell (x, y): the bits of x and y
+// interleaved, x in the even bits. Uses BMI2 when available, except in
+// constant expressions.
+constexpr uint64_t MortonKey(uint32_t x, uint32_t y) {
+#if defined(__BMI2__)
+  if (!__builtin_is_constant_evaluated()) {
+    return _pdep_u64(x, 0x5555555555555555ull) |
+           _pdep_u64(y, 0xAAAAAAAAAAAAAAAAull);
+  }
+#endif
+  return spatial_sort_internal::SpreadBits(x) |
+         (spatial_sort_internal::SpreadBits(y) << 1);
+}
+
+// Returns the distance of grid cell (x, y) along the Hilbert curve that fills
+// the 2^32 x 2^32 grid, starting at (0, 0).
+constexpr uint64_t HilbertKey(uint32_t x, uint32_t y) {
+  uint64_t d = 0;
+  for (uint32_t s = uint32_t{1} << 31; s > 0; s >>= 1) {
+    const uint32_t rx = (x & s) ? 1 : 0;
+    const uint32_t ry = (y & s) ? 1 : 0;
+    d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+    // Rotates the quadrant so that the sub-curve starts at its origin.
+    if (ry == 0) {
+      if (rx == 1) {
+        x = ~x;
+        y = ~y;
+      }
+      const uint32_t t = x;
+      x = y;
+      y = t;
+    }
+  }
+  return d;
+}
+
+namespace spatial_sort_internal {
+
+// Returns the box a geometry is keyed by.
+template <typename T>
+Box2<T> Bounds(const Point2<T>& p) {
+  return Box2<T>(p, p);
+}
+template <typename T>
+const Box2<T>& Bounds(const Box2<T>& b) {
+  return b;
+}
+template <typename T>
+Box2<T> Bounds(const Segment2<T>& s) {
+  return Box2<T>(s.p0(), s.p1());
+}
+
+// Maps the coordinates inside a bounding box to the 2^32 x 2^32 grid of the
+// curve keys: offsets from the lower left corner, shifted right just enough
+// to fit in 32 bits. 32-bit coordinates keep full precision; larger extents
+// of 64-bit coordinates lose their low bits.
+template <typename T>
+class Grid {
+ public:
+  explicit Grid(const Box2<T>& bounds) : ll_(bounds.ll()) {
+    const uint64_t extent = std::max(Offset(bounds.xh(), ll_.x()),
+                                     Offset(bounds.yh(), ll_.y()));
+    shift_ = std::max(static_cast<int>(absl::bit_width(extent)), 32) - 32;
+  }
+
+  // Returns the key of the center of b.
+  uint64_t Key(const Box2<T>& b, SpatialCurve curve) const {
+    const uint64_t x =
+        (Cell(b.xl(), ll_.x()) + Cell(b.xh(), ll_.x())) / 2;
+    const uint64_t y =
+        (Cell(b.yl(), ll_.y()) + Cell(b.yh(), ll_.y())) / 2;
+    return curve == SpatialCurve::kMorton
+               ? MortonKey(static_cast<uint32_t>(x), static_cast<uint32_t>(y))
+               : HilbertKey(static_cast<uint32_t>(x),
+                            static_cast<uint32_t>(y));
+  }
+
+ private:
+  // Unsigned arithmetic: the offset of two 64-bit coordinates may not fit in
+  // int64_t.
+  static uint64_t Offset(T v, T lo) {
+    return static_cast<uint64_t>(v) - static_cast<uint64_t>(lo);
+  }
+  uint64_t Cell(T v, T lo) const { return Offset(v, lo) >> shift_; }
+
+  Point2<T> ll_;
+  int shift_ = 0;
+};
+
+}  // namespace spatial_sort_internal
+
+// Returns the order of the geometries (Point2, Box2 or Segment2) along a
+// space-filling curve: geometries[order[0]] comes first. Each geometry is
+// keyed by the center of its bounding box on a grid over the bounds of all
+// of them. Equal keys keep their input order.
+//
+// The keys are computed and radix sorted 8 bits at a time over contiguous
+// blocks on up to num_threads threads (0 means one thread per hardware
+// thread).
+template <typename G>
+std::vector<std::size_t> SpatialOrder(
+    const std::vector<G>& geometries,
+    SpatialCurve curve = SpatialCurve::kHilbert, std::size_t num_threads = 0) {
+  using T = typename G::coordinate_type;
+  static_assert(std::is_integral_v<T>, "Coordinates must be integral.");
+  const std::size_t n = geometries.size();
+  std::vector<std::size_t> order(n);
+  if (n == 0) return order;
+  Box2<T> bounds = spatial_sort_internal::Bounds(geometries[0]);
+  for (const G& g : geometries) {
+    bounds.Encompass(spatial_sort_internal::Bounds(g));
+  }
+  const spatial_sort_internal::Grid<T> grid(bounds);
+
+  std::vector<std::pair<uint64_t, std::size_t>> keys(n);
+  ParallelForBlocks(n, num_threads,
+                    [&](std::size_t, std::size_t begin, std::size_t end) {
+                      for (std::size_t i = begin; i < end; ++i) {
+                        const auto& b =
+                            spatial_sort_internal::Bounds(geometries[i]);
+                        keys[i] = {grid.Key(b, curve), i};
+                      }
+                    });
+
+  // LSD radix sort. Every block counts its digits, the counts are turned
+  // into per-block output positions, and every block scatters its keys in
+  // order, so the sort is stable.
+  constexpr int kDigitBits = 8;
+  constexpr std::size_t kBuckets = std::size_t{1} << kDigitBits;
+  const std::size_t blocks = NumBlocks(n, num_threads);
+  std::vector<std::array<std::size_t, kBuckets>> counts(blocks);
+  std::vector<std::pair<uint64_t, std::size_t>> sorted(n);
+  for (int shift = 0; shift < 64; shift += kDigitBits) {
+    auto digit = [shift](uint64_t key) {
+      return static_cast<std::size_t>((key >> shift) & (kBuckets - 1));
+    };
+    ParallelForBlocks(n, num_threads,
+                      [&](std::size_t block, std::size_t begin,
+                          std::size_t end) {
+                        counts[block].fill(0);
+                        for (std::size_t i = begin; i < end; ++i) {
+                          ++counts[block][digit(keys[i].first)];
+                        }
+                      });
+    // A digit shared by all keys leaves the order as is.
+    std::size_t total = 0;
+    bool skip = false;
+    for (std::size_t d = 0; d < kBuckets; ++d) {
+      std::size_t count = 0;
+      for (std::size_t b = 0; b < blocks; ++b) {
+        const std::size_t c = counts[b][d];
+        counts[b][d] = total;
+        total += c;
+        count += c;
+      }
+      skip = skip || count == n;
+    }
+    if (skip) continue;
+    ParallelForBlocks(n, num_threads,
+                      [&](std::size_t block, std::size_t begin,
+                          std::size_t end) {
+                        for (std::size_t i = begin; i < end; ++i) {
+                          sorted[counts[block][digit(keys[i].first)]++] =
+                              keys[i];
+                        }
+                      });
+    keys.swap(sorted);
+  }
+  for (std::size_t i = 0; i < n; ++i) order[i] = keys[i].second;
+  return order;
+}
+
+// Reorders the geometries (Point2, Box2 or Segment2) along a space-filling
+// curve, e.g., before a bulk Rtree build, a batch of queries or writing them
+// to disk, so that geometries close in space are close in memory. See
+// SpatialOrder.
+template <typename G>
+void SpatialSort(std::vector<G>& geometries,
+                 SpatialCurve curve = SpatialCurve::kHilbert,
+                 std::size_t num_threads = 0) {
+  const std::vector<std::size_t> order =
+      SpatialOrder(geometries, curve, num_threads);
+  std::vector<G> sorted;
+  sorted.reserve(geometries.size());
+  for (std::size_t i : order) sorted.push_back(std::move(geometries[i]));
+  geometries.swap(sorted);
+}
+
+}  // namespace moab
+
+#endif  // MOAB_SPATIAL_SORT_H_
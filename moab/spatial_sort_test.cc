@@ -0,0 +1,110 @@
+#include "spatial_sort.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/segment2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+static_assert(MortonKey(0, 0) == 0);
+static_assert(MortonKey(3, 1) == 7);
+static_assert(MortonKey(0xFFFFFFFF, 0) == 0x5555555555555555ull);
+static_assert(HilbertKey(0, 0) == 0);
+static_assert(HilbertKey(0xFFFFFFFF, 0) == 0xFFFFFFFFFFFFFFFFull);
+
+TEST(MortonKey, MatchesBitByBit) {
+  std::mt19937 gen(48);
+  for (int i = 0; i < 1000; ++i) {
+    const uint32_t x = gen(), y = gen();
+    uint64_t expected = 0;
+    for (int b = 0; b < 32; ++b) {
+      expected |= static_cast<uint64_t>((x >> b) & 1) << (2 * b);
+      expected |= static_cast<uint64_t>((y >> b) & 1) << (2 * b + 1);
+    }
+    EXPECT_EQ(MortonKey(x, y), expected);
+  }
+}
+
+TEST(HilbertKey, VisitsNeighbors) {
+  // The 16 x 16 cells at the origin form a sub-curve with keys 0 to 255, and
+  // consecutive keys are adjacent cells.
+  std::vector<Point2_i> cells(256, Point2_i(-1, -1));
+  for (int x = 0; x < 16; ++x) {
+    for (int y = 0; y < 16; ++y) {
+      const uint64_t key = HilbertKey(x, y);
+      ASSERT_LT(key, 256);
+      EXPECT_EQ(cells[key], Point2_i(-1, -1));
+      cells[key] = Point2_i(x, y);
+    }
+  }
+  for (std::size_t i = 1; i < cells.size(); ++i) {
+    EXPECT_EQ(std::abs(cells[i].x() - cells[i - 1].x()) +
+                  std::abs(cells[i].y() - cells[i - 1].y()),
+              1);
+  }
+}
+
+TEST(SpatialSort, Points) {
+  std::vector<Point2_i> points = {Point2_i(1, 1), Point2_i(0, 0),
+                                  Point2_i(0, 1), Point2_i(1, 0)};
+
+  EXPECT_THAT(SpatialOrder(points, SpatialCurve::kMorton),
+              ElementsAre(1, 3, 2, 0));
+  SpatialSort(points, SpatialCurve::kHilbert);
+  EXPECT_THAT(points, ElementsAre(Point2_i(0, 0), Point2_i(1, 0),
+                                  Point2_i(1, 1), Point2_i(0, 1)));
+}
+
+TEST(SpatialSort, BoxesAndSegments) {
+  // Negative and 64-bit coordinates, keyed by their centers.
+  std::vector<Box2_i64> boxes = {
+      Box2_i64(int64_t{1} << 50, 0, (int64_t{1} << 50) + 2, 2),
+      Box2_i64(-(int64_t{1} << 50), 0, -(int64_t{1} << 50) + 2, 2),
+      Box2_i64(0, 0, 2, 2)};
+  std::vector<Segment2_i> segments = {Segment2_i(Point2_i(10, 10),
+                                                 Point2_i(8, 8)),
+                                      Segment2_i(Point2_i(-10, -10),
+                                                 Point2_i(-8, -8))};
+
+  EXPECT_THAT(SpatialOrder(boxes, SpatialCurve::kMorton), ElementsAre(1, 2, 0));
+  SpatialSort(segments);
+  EXPECT_EQ(segments[0].p0(), Point2_i(-10, -10));
+}
+
+TEST(SpatialSort, Parallel) {
+  std::mt19937 gen(49);
+  std::uniform_int_distribution<int> pos(-1000000, 1000000);
+  std::vector<Point2_i> points;
+  for (int i = 0; i < 100000; ++i) points.emplace_back(pos(gen), pos(gen));
+
+  for (SpatialCurve curve : {SpatialCurve::kMorton, SpatialCurve::kHilbert}) {
+    const std::vector<std::size_t> order = SpatialOrder(points, curve, 4);
+    EXPECT_EQ(SpatialOrder(points, curve, 1), order);
+    std::vector<std::size_t> sorted = order;
+    std::sort(sorted.begin(), sorted.end());
+    for (std::size_t i = 0; i < sorted.size(); ++i) EXPECT_EQ(sorted[i], i);
+
+    // Neighbors along the curve are much closer than random pairs.
+    double along = 0;
+    for (std::size_t i = 1; i < order.size(); ++i) {
+      const Point2_i& p = points[order[i - 1]];
+      const Point2_i& q = points[order[i]];
+      along += std::abs(static_cast<double>(p.x()) - q.x()) +
+               std::abs(static_cast<double>(p.y()) - q.y());
+    }
+    EXPECT_LT(along / order.size(), 100000);
+  }
+}
+
+}  // namespace moab
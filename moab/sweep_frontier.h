@@ -0,0 +1,221 @@
+#ifndef MOAB_SWEEP_FRONTIER_H_
+#define MOAB_SWEEP_FRONTIER_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "moab/box2.h"
+
+namespace moab {
+
+// The state of a bottom-up scanline over the plane, for sweeps that turn
+// horizontal edge events into non-overlapping output boxes.
+//
+// The scanline holds a State for every x, stored as the x where it changes,
+// and classifies each state to a result; a default constructed result means
+// outside. Runs of equal non-empty results are open output boxes, extended
+// upward while they stay the same. Update() changes the states of [x0, x1) at
+// the current y, and Flush(y) closes the boxes whose run changed. Both cost
+// O(log n) plus the number of runs they touch, so a sweep over n events takes
+// O(n log n) on typical layouts, whatever the number of distinct x.
+//
+// classify(const State&) returns the result of a state, and must return an
+// empty result for State{}.
+//
+// Usage:
+//   auto covered = [](int count) { return count > 0; };
+//   SweepFrontier<int, int, decltype(covered)> frontier(covered);
+//   for (each y of the events, from bottom to top) {
+//     for (each event at y) frontier.Update(x0, x1, [](int& c) { c += d; });
+//     frontier.Flush(y, [](const Box2_i& box, bool) { ... });
+//   }
+template <typename T, typename State, typename Classify>
+class SweepFrontier {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+  using state_type = State;
+  using result_type = std::invoke_result_t<const Classify&, const State&>;
+
+  // Constructors.
+  explicit SweepFrontier(Classify classify) : classify_(std::move(classify)) {}
+  SweepFrontier(const SweepFrontier&) = default;
+  SweepFrontier(SweepFrontier&&) = default;
+  ~SweepFrontier() = default;
+
+  // Assignment operators.
+  SweepFrontier& operator=(const SweepFrontier&) = default;
+  SweepFrontier& operator=(SweepFrontier&&) = default;
+
+  // Accessors.
+  // Returns true if every state is State{} and no box is open.
+  bool Empty() const { return states_.empty() && open_.empty(); }
+
+  // Mutators.
+  // Calls update(State&) on the states of [x0, x1).
+  template <typename Fn>
+  void Update(T x0, T x1, const Fn& update);
+  // Moves the scanline to y, after the updates at y. Calls
+  // emit(const Box2<T>&, const result_type&) for every open box whose run
+  // changed since the last flush, in increasing order of x.
+  template <typename Emit>
+  void Flush(T y, const Emit& emit);
+
+ private:
+  // An open output box [x0, x1) x [y, ...), keyed by x0.
+  struct Run {
+    T x1;
+    T y;
+    result_type result;
+  };
+  // A run of equal results [x0, x1).
+  struct Piece {
+    T x0;
+    T x1;
+    result_type result;
+  };
+
+  // Returns the state at x.
+  const State& StateAt(T x) const {
+    auto it = states_.upper_bound(x);
+    return it == states_.begin() ? kOutside : std::prev(it)->second;
+  }
+  // Makes x the start of a state run.
+  void Split(T x) {
+    auto it = states_.lower_bound(x);
+    if (it != states_.end() && it->first == x) return;
+    states_.emplace_hint(it, x, StateAt(x));
+  }
+  // Drops the changes in [x0, x1] that repeat the state before them.
+  void Coalesce(T x0, T x1);
+  // Rebuilds the open runs over the changed [x0, x1).
+  template <typename Emit>
+  void FlushRange(T x0, T x1, T y, const Emit& emit);
+
+  inline static const State kOutside{};
+
+  Classify classify_;
+  // The state of [x, next x) for every x where it changes.
+  std::map<T, State> states_;
+  std::map<T, Run> open_;
+  // Ranges updated since the last flush.
+  std::vector<std::pair<T, T>> dirty_;
+};
+
+template <typename T, typename State, typename Classify>
+template <typename Fn>
+void SweepFrontier<T, State, Classify>::Update(T x0, T x1, const Fn& update) {
+  if (x0 >= x1) return;
+  Split(x0);
+  Split(x1);
+  for (auto it = states_.find(x0); it->first < x1; ++it) update(it->second);
+  Coalesce(x0, x1);
+  dirty_.push_back({x0, x1});
+}
+
+template <typename T, typename State, typename Classify>
+void SweepFrontier<T, State, Classify>::Coalesce(T x0, T x1) {
+  auto it = states_.lower_bound(x0);
+  const State* prev =
+      it == states_.begin() ? &kOutside : &std::prev(it)->second;
+  while (it != states_.end() && it->first <= x1) {
+    if (it->second == *prev) {
+      it = states_.erase(it);
+    } else {
+      prev = &it->second;
+      ++it;
+    }
+  }
+}
+
+template <typename T, typename State, typename Classify>
+template <typename Emit>
+void SweepFrontier<T, State, Classify>::Flush(T y, const Emit& emit) {
+  std::sort(dirty_.begin(), dirty_.end());
+  std::size_t i = 0;
+  while (i < dirty_.size()) {
+    const T x0 = dirty_[i].first;
+    T x1 = dirty_[i].second;
+    for (++i; i < dirty_.size() && dirty_[i].first <= x1; ++i) {
+      x1 = std::max(x1, dirty_[i].second);
+    }
+    FlushRange(x0, x1, y, emit);
+  }
+  dirty_.clear();
+}
+
+template <typename T, typename State, typename Classify>
+template <typename Emit>
+void SweepFrontier<T, State, Classify>::FlushRange(T x0, T x1, T y,
+                                                   const Emit& emit) {
+  // Outside [x0, x1) the results did not change, so the new runs differ from
+  // the open ones only up to the open runs that reach x0 and x1.
+  std::vector<Piece> pieces;
+  T lo = x0, hi = x1;
+  auto first = open_.lower_bound(x0);
+  if (first != open_.begin() && std::prev(first)->second.x1 >= x0) {
+    --first;
+    lo = first->first;
+    pieces.push_back({lo, x0, first->second.result});
+  }
+  auto last = open_.upper_bound(x1);
+  if (last != open_.begin() && std::prev(last)->second.x1 > x1) {
+    hi = std::prev(last)->second.x1;
+  }
+  const result_type right =
+      hi > x1 ? std::prev(last)->second.result : result_type{};
+
+  // The new runs over [lo, hi).
+  auto it = states_.upper_bound(x0);
+  const State* state =
+      it == states_.begin() ? &kOutside : &std::prev(it)->second;
+  for (T x = x0; x < x1;) {
+    const T next = it == states_.end() || it->first >= x1 ? x1 : it->first;
+    pieces.push_back({x, next, classify_(*state)});
+    if (next == x1) break;
+    state = &it->second;
+    x = next;
+    ++it;
+  }
+  if (hi > x1) pieces.push_back({x1, hi, right});
+  std::vector<Piece> runs;
+  for (const Piece& p : pieces) {
+    if (p.result == result_type{}) continue;
+    if (!runs.empty() && runs.back().x1 == p.x0 &&
+        runs.back().result == p.result) {
+      runs.back().x1 = p.x1;
+    } else {
+      runs.push_back(p);
+    }
+  }
+
+  // Keeps the open runs that did not change and closes the others.
+  std::vector<std::pair<T, Run>> old(first, last);
+  open_.erase(first, last);
+  std::size_t k = 0;
+  for (const Piece& r : runs) {
+    for (; k < old.size() && old[k].first < r.x0; ++k) {
+      const Run& o = old[k].second;
+      if (o.y < y) emit(Box2<T>(old[k].first, o.y, o.x1, y), o.result);
+    }
+    if (k < old.size() && old[k].first == r.x0 &&
+        old[k].second.x1 == r.x1 && old[k].second.result == r.result) {
+      open_.insert(last, old[k++]);
+    } else {
+      open_.emplace_hint(last, r.x0, Run{r.x1, y, r.result});
+    }
+  }
+  for (; k < old.size(); ++k) {
+    const Run& o = old[k].second;
+    if (o.y < y) emit(Box2<T>(old[k].first, o.y, o.x1, y), o.result);
+  }
+}
+
+}  // namespace moab
+
+#endif  // MOAB_SWEEP_FRONTIER_H_
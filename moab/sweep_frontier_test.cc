@@ -0,0 +1,97 @@
+#include "sweep_frontier.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <tuple>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::IsEmpty;
+
+auto Covered = [](int count) { return count > 0; };
+using Frontier = SweepFrontier<int, int, decltype(Covered)>;
+
+// Sweeps the boxes with the frontier and returns the output boxes.
+std::vector<Box2_i> Sweep(const std::vector<Box2_i>& boxes) {
+  std::vector<std::tuple<int, int, int, int>> events;  // <y, delta, x0, x1>
+  for (const Box2_i& b : boxes) {
+    events.emplace_back(b.yl(), 1, b.xl(), b.xh());
+    events.emplace_back(b.yh(), -1, b.xl(), b.xh());
+  }
+  std::sort(events.begin(), events.end());
+  Frontier frontier(Covered);
+  std::vector<Box2_i> out;
+  std::size_t e = 0;
+  while (e < events.size()) {
+    const int y = std::get<0>(events[e]);
+    for (; e < events.size() && std::get<0>(events[e]) == y; ++e) {
+      const int delta = std::get<1>(events[e]);
+      frontier.Update(std::get<2>(events[e]), std::get<3>(events[e]),
+                      [delta](int& c) { c += delta; });
+    }
+    frontier.Flush(y, [&out](const Box2_i& b, bool) { out.push_back(b); });
+  }
+  EXPECT_TRUE(frontier.Empty());
+  return out;
+}
+
+TEST(SweepFrontier, Empty) {
+  Frontier frontier(Covered);
+
+  EXPECT_TRUE(frontier.Empty());
+  EXPECT_THAT(Sweep({}), IsEmpty());
+}
+
+TEST(SweepFrontier, Box) {
+  EXPECT_THAT(Sweep({Box2_i(0, 0, 10, 20)}),
+              ElementsAre(Box2_i(0, 0, 10, 20)));
+}
+
+TEST(SweepFrontier, MergesAdjacentStates) {
+  // Counts 1, 2, 1 over [0, 30) are one run.
+  EXPECT_THAT(Sweep({Box2_i(0, 0, 20, 10), Box2_i(10, 0, 30, 10)}),
+              ElementsAre(Box2_i(0, 0, 30, 10)));
+}
+
+TEST(SweepFrontier, ExtendsUnchangedRuns) {
+  // The left box is not split where the right one starts.
+  EXPECT_THAT(Sweep({Box2_i(0, 0, 10, 30), Box2_i(20, 10, 30, 20)}),
+              ElementsAre(Box2_i(20, 10, 30, 20), Box2_i(0, 0, 10, 30)));
+}
+
+TEST(SweepFrontier, SplitsChangedRuns) {
+  EXPECT_THAT(Sweep({Box2_i(0, 0, 30, 10), Box2_i(10, 10, 20, 20)}),
+              ElementsAre(Box2_i(0, 0, 30, 10), Box2_i(10, 10, 20, 20)));
+  EXPECT_THAT(Sweep({Box2_i(0, 0, 10, 10), Box2_i(0, 10, 20, 20)}),
+              ElementsAre(Box2_i(0, 0, 10, 10), Box2_i(0, 10, 20, 20)));
+}
+
+TEST(SweepFrontier, RandomBoxes) {
+  std::mt19937 gen(7);
+  std::uniform_int_distribution<int> pos(0, 500);
+  std::uniform_int_distribution<int> size(1, 80);
+  std::vector<Box2_i> boxes;
+  for (int i = 0; i < 300; ++i) {
+    int x = pos(gen), y = pos(gen);
+    boxes.emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+
+  const std::vector<Box2_i> out = Sweep(boxes);
+
+  EXPECT_TRUE(Equivalence(out, boxes));
+  // Non-overlapping.
+  int64_t sum = 0;
+  for (const Box2_i& b : out) sum += b.Area();
+  EXPECT_EQ(sum, Area(boxes));
+}
+
+}  // namespace moab
@@ -0,0 +1,378 @@
+#ifndef MOAB_TILED_STORAGE_H_
+#define MOAB_TILED_STORAGE_H_
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/log/check.h"
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/rtree.h"
+#include "moab/segment2.h"
+
+namespace moab {
+
+namespace tiled_storage_internal {
+
+// The geometry type G with coordinates of type O.
+template <typename G, typename O>
+struct Narrow;
+template <typename T, typename O>
+struct Narrow<Point2<T>, O> {
+  using type = Point2<O>;
+};
+template <typename T, typename O>
+struct Narrow<Box2<T>, O> {
+  using type = Box2<O>;
+};
+template <typename T, typename O>
+struct Narrow<Segment2<T>, O> {
+  using type = Segment2<O>;
+};
+
+// Returns the bounding box of a geometry.
+template <typename T>
+Box2<T> Bounds(const Point2<T>& p) {
+  return Box2<T>(p, p);
+}
+template <typename T>
+const Box2<T>& Bounds(const Box2<T>& b) {
+  return b;
+}
+template <typename T>
+Box2<T> Bounds(const Segment2<T>& s) {
+  return Box2<T>(s.p0(), s.p1());
+}
+
+// Converts between a geometry and its offsets from origin.
+template <typename O, typename T>
+Point2<O> ToNarrow(const Point2<T>& p, const Point2<T>& origin) {
+  return Point2<O>(static_cast<O>(p.x() - origin.x()),
+                   static_cast<O>(p.y() - origin.y()));
+}
+template <typename O, typename T>
+Box2<O> ToNarrow(const Box2<T>& b, const Point2<T>& origin) {
+  return Box2<O>(ToNarrow<O>(b.ll(), origin), ToNarrow<O>(b.ur(), origin));
+}
+template <typename O, typename T>
+Segment2<O> ToNarrow(const Segment2<T>& s, const Point2<T>& origin) {
+  return Segment2<O>(ToNarrow<O>(s.p0(), origin), ToNarrow<O>(s.p1(), origin));
+}
+template <typename T, typename O>
+Point2<T> ToWide(const Point2<O>& p, const Point2<T>& origin) {
+  return Point2<T>(origin.x() + p.x(), origin.y() + p.y());
+}
+template <typename T, typename O>
+Box2<T> ToWide(const Box2<O>& b, const Point2<T>& origin) {
+  return Box2<T>(ToWide(b.ll(), origin), ToWide(b.ur(), origin));
+}
+template <typename T, typename O>
+Segment2<T> ToWide(const Segment2<O>& s, const Point2<T>& origin) {
+  return Segment2<T>(ToWide(s.p0(), origin), ToWide(s.p1(), origin));
+}
+
+// Assigns geometries to square tiles of tile_size, by the lower left corner
+// of their bounding box.
+template <typename T, typename O>
+class Tiling {
+  static_assert(std::is_integral_v<T> && std::is_integral_v<O>,
+                "Coordinates must be integral.");
+  static_assert(sizeof(O) < sizeof(T), "Offsets must be narrower than T.");
+
+ public:
+  using tile_type = std::pair<int64_t, int64_t>;
+
+  explicit Tiling(T tile_size) : tile_size_(tile_size) {
+    CHECK(tile_size > 0 && tile_size <= std::numeric_limits<O>::max())
+        << "Tile size must be positive and fit in the offset type. "
+        << "tile_size: " << tile_size;
+  }
+
+  T TileSize() const { return tile_size_; }
+  // Returns the tile of b, or false if b crosses the border of its tile.
+  bool TileOf(const Box2<T>& b, tile_type& tile) const {
+    tile = {FloorDiv(b.xl(), tile_size_), FloorDiv(b.yl(), tile_size_)};
+    const Point2<T> origin = Origin(tile);
+    return b.xh() - origin.x() <= tile_size_ &&
+           b.yh() - origin.y() <= tile_size_;
+  }
+  Point2<T> Origin(const tile_type& tile) const {
+    return Point2<T>(static_cast<T>(tile.first * tile_size_),
+                     static_cast<T>(tile.second * tile_size_));
+  }
+
+ private:
+  static int64_t FloorDiv(int64_t a, int64_t b) {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+  }
+
+  T tile_size_;
+};
+
+}  // namespace tiled_storage_internal
+
+// A container of Point2, Box2 or Segment2 with wide coordinates T (e.g.,
+// int64_t) that stores them as narrow offsets of type O (int32_t or int16_t)
+// from the origin of their tile. Tiles are squares of tile_size, which must
+// fit in O; a geometry belongs to the tile of the lower left corner of its
+// bounding box. The few geometries that cross the border of their tile are
+// stored at full width. Geometries are widened back to G on access.
+//
+// Box2<int64_t> takes 32 bytes, Box2<int32_t> 16 and Box2<int16_t> 8, plus
+// one origin per tile.
+//
+// Usage:
+//   TiledVector<Box2_i64, int32_t> boxes(/*tile_size=*/1 << 30);
+//   for (const Box2_i64& b : layer) boxes.Insert(b);
+//   boxes.ForEach([](const Box2_i64& b) { ... });
+template <typename G, typename O>
+class TiledVector {
+ public:
+  // Type aliases.
+  using value_type = G;
+  using coordinate_type = typename G::coordinate_type;
+  using offset_type = O;
+  using narrow_type = typename tiled_storage_internal::Narrow<G, O>::type;
+  using tiling_type = tiled_storage_internal::Tiling<coordinate_type, O>;
+  using tile_type = typename tiling_type::tile_type;
+
+  // Constructors.
+  explicit TiledVector(coordinate_type tile_size) : tiling_(tile_size) {}
+  TiledVector(const TiledVector&) = default;
+  TiledVector(TiledVector&&) = default;
+  ~TiledVector() = default;
+
+  // Assignment operators.
+  TiledVector& operator=(const TiledVector&) = default;
+  TiledVector& operator=(TiledVector&&) = default;
+
+  // Accessors.
+  coordinate_type TileSize() const { return tiling_.TileSize(); }
+  std::size_t Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+  std::size_t NumTiles() const { return tiles_.size(); }
+  // Returns the number of geometries stored at full width.
+  std::size_t NumWide() const { return wide_.size(); }
+
+  // Mutators.
+  void Insert(const G& g) {
+    ++size_;
+    tile_type tile;
+    if (!tiling_.TileOf(tiled_storage_internal::Bounds(g), tile)) {
+      wide_.push_back(g);
+      return;
+    }
+    auto [it, inserted] = index_.try_emplace(tile, tiles_.size());
+    if (inserted) tiles_.push_back({tiling_.Origin(tile), {}});
+    Tile& t = tiles_[it->second];
+    t.items.push_back(tiled_storage_internal::ToNarrow<O>(g, t.origin));
+  }
+  void Clear() {
+    tiles_.clear();
+    index_.clear();
+    wide_.clear();
+    size_ = 0;
+  }
+
+  // Operations.
+  // Calls fn(const G&) for every geometry: tile by tile in order of first
+  // use, then the wide geometries. Insertion order is kept within a tile.
+  template <typename Fn>
+  void ForEach(Fn&& fn) const {
+    for (const Tile& t : tiles_) {
+      for (const narrow_type& g : t.items) {
+        fn(tiled_storage_internal::ToWide(g, t.origin));
+      }
+    }
+    for (const G& g : wide_) fn(g);
+  }
+  // Returns the geometries in ForEach order.
+  std::vector<G> ToVector() const {
+    std::vector<G> out;
+    out.reserve(size_);
+    ForEach([&out](const G& g) { out.push_back(g); });
+    return out;
+  }
+
+ private:
+  struct Tile {
+    Point2<coordinate_type> origin;
+    std::vector<narrow_type> items;
+  };
+
+  tiling_type tiling_;
+  std::vector<Tile> tiles_;
+  absl::flat_hash_map<tile_type, std::size_t> index_;
+  std::vector<G> wide_;
+  std::size_t size_ = 0;
+};
+
+// An R-tree of Point2, Box2 or Segment2 with the tiled, narrow storage of
+// TiledVector: every tile holds an Rtree of narrow offsets, and geometries
+// crossing a tile border go to an Rtree at full width. A query visits the
+// tiles the window covers, moves the window into each of them, and widens the
+// hits. Query windows far larger than a tile visit many tiles, so the tile
+// size should be well above the typical window.
+//
+// Usage:
+//   TiledRtree<Box2_i64, int16_t> rtree(/*tile_size=*/1 << 14);
+//   rtree.Insert(Box2_i64(...));
+//   std::vector<Box2_i64> hits = rtree.QueryIntersects(window);
+template <typename G, typename O>
+class TiledRtree {
+ public:
+  // Type aliases.
+  using value_type = G;
+  using coordinate_type = typename G::coordinate_type;
+  using offset_type = O;
+  using narrow_type = typename tiled_storage_internal::Narrow<G, O>::type;
+  using tiling_type = tiled_storage_internal::Tiling<coordinate_type, O>;
+  using tile_type = typename tiling_type::tile_type;
+
+  // Constructors.
+  explicit TiledRtree(coordinate_type tile_size) : tiling_(tile_size) {}
+  TiledRtree(const TiledRtree&) = default;
+  TiledRtree(TiledRtree&&) = default;
+  ~TiledRtree() = default;
+
+  // Assignment operators.
+  TiledRtree& operator=(const TiledRtree&) = default;
+  TiledRtree& operator=(TiledRtree&&) = default;
+
+  // Accessors.
+  coordinate_type TileSize() const { return tiling_.TileSize(); }
+  std::size_t Size() const { return size_; }
+  bool Empty() const { return size_ == 0; }
+  std::size_t NumTiles() const { return tiles_.size(); }
+  // Returns the number of geometries stored at full width.
+  std::size_t NumWide() const { return wide_.Size(); }
+
+  // Mutators.
+  void Insert(const G& g) {
+    ++size_;
+    tile_type tile;
+    if (!tiling_.TileOf(tiled_storage_internal::Bounds(g), tile)) {
+      wide_.Insert(g);
+      return;
+    }
+    tiles_[tile].Insert(
+        tiled_storage_internal::ToNarrow<O>(g, tiling_.Origin(tile)));
+  }
+  // Removes one copy of g. Returns false if g is not stored.
+  bool Remove(const G& g) {
+    tile_type tile;
+    if (!tiling_.TileOf(tiled_storage_internal::Bounds(g), tile)) {
+      if (wide_.Count(g) == 0) return false;
+      wide_.Remove(g);
+      --size_;
+      return true;
+    }
+    auto it = tiles_.find(tile);
+    if (it == tiles_.end()) return false;
+    const narrow_type n =
+        tiled_storage_internal::ToNarrow<O>(g, tiling_.Origin(tile));
+    if (it->second.Count(n) == 0) return false;
+    it->second.Remove(n);
+    if (it->second.Empty()) tiles_.erase(it);
+    --size_;
+    return true;
+  }
+  void Clear() {
+    tiles_.clear();
+    wide_.Clear();
+    size_ = 0;
+  }
+
+  // Queries.
+  // Calls fn(const G&) for every geometry that intersects window.
+  template <typename Fn>
+  void QueryIntersects(const Box2<coordinate_type>& window, Fn&& fn) const;
+  std::vector<G> QueryIntersects(const Box2<coordinate_type>& window) const {
+    std::vector<G> out;
+    QueryIntersects(window, [&out](const G& g) { out.push_back(g); });
+    return out;
+  }
+
+ private:
+  tiling_type tiling_;
+  absl::flat_hash_map<tile_type, Rtree<narrow_type>> tiles_;
+  Rtree<G> wide_;
+  std::size_t size_ = 0;
+};
+
+template <typename G, typename O>
+template <typename Fn>
+void TiledRtree<G, O>::QueryIntersects(const Box2<coordinate_type>& window,
+                                       Fn&& fn) const {
+  using T = coordinate_type;
+  for (const G& g : wide_.QueryIntersects(window)) fn(g);
+  if (tiles_.empty()) return;
+  // A geometry lies inside its tile, so the tiles left of or below the
+  // window cannot hold a hit. Tiles that touch the window on their far side
+  // can, as tiles are closed.
+  tile_type first, last;
+  tiling_.TileOf(Box2<T>(window.ll(), window.ll()), first);
+  tiling_.TileOf(Box2<T>(window.ur(), window.ur()), last);
+  if (first.first > std::numeric_limits<int64_t>::min()) --first.first;
+  if (first.second > std::numeric_limits<int64_t>::min()) --first.second;
+  // The number of covered tiles along each axis, in unsigned arithmetic as
+  // the difference of two tile indices may not fit in int64_t, saturated for
+  // the full 2^64 tiles.
+  auto count = [](int64_t lo, int64_t hi) {
+    const uint64_t n = static_cast<uint64_t>(hi) - static_cast<uint64_t>(lo);
+    return n == std::numeric_limits<uint64_t>::max() ? n : n + 1;
+  };
+  const uint64_t columns = count(first.first, last.first);
+  const uint64_t rows = count(first.second, last.second);
+  auto visit = [&](const tile_type& tile, const Rtree<narrow_type>& rtree) {
+    const Point2<T> origin = tiling_.Origin(tile);
+    const uint64_t size = static_cast<uint64_t>(tiling_.TileSize());
+    // Offsets from the origin are unsigned: the far side of the last tile
+    // of the coordinate range does not fit in T.
+    auto offset = [](T v, T o) {
+      return static_cast<uint64_t>(v) - static_cast<uint64_t>(o);
+    };
+    if (window.xh() < origin.x() || window.yh() < origin.y()) return;
+    if ((window.xl() > origin.x() && offset(window.xl(), origin.x()) > size) ||
+        (window.yl() > origin.y() && offset(window.yl(), origin.y()) > size)) {
+      return;
+    }
+    // Clipped to the tile, the window fits in O and finds the same hits.
+    auto clip = [&](T v, T o) {
+      return static_cast<O>(v <= o ? 0 : std::min(offset(v, o), size));
+    };
+    const Box2<O> local(clip(window.xl(), origin.x()),
+                        clip(window.yl(), origin.y()),
+                        clip(window.xh(), origin.x()),
+                        clip(window.yh(), origin.y()));
+    for (const narrow_type& g : rtree.QueryIntersects(local)) {
+      fn(tiled_storage_internal::ToWide(g, origin));
+    }
+  };
+  // Large windows walk the stored tiles rather than every covered tile. The
+  // product of the counts may overflow: each factor is compared first.
+  const uint64_t stored = tiles_.size();
+  if (rows > stored || columns > stored / rows) {
+    for (const auto& [tile, rtree] : tiles_) visit(tile, rtree);
+    return;
+  }
+  // Counted loops: the last tile index may be the largest int64_t.
+  for (uint64_t di = 0; di < columns; ++di) {
+    const int64_t i = first.first + static_cast<int64_t>(di);
+    for (uint64_t dj = 0; dj < rows; ++dj) {
+      const int64_t j = first.second + static_cast<int64_t>(dj);
+      auto it = tiles_.find(tile_type(i, j));
+      if (it != tiles_.end()) visit(it->first, it->second);
+    }
+  }
+}
+
+}  // namespace moab
+
+#endif  // MOAB_TILED_STORAGE_H_
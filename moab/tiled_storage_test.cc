@@ -0,0 +1,151 @@
+#include "tiled_storage.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/segment2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+using ::testing::UnorderedElementsAre;
+using ::testing::UnorderedElementsAreArray;
+
+constexpr int64_t kFar = int64_t{1} << 40;
+
+std::vector<Box2_i64> RandomBoxes(std::size_t n, int seed) {
+  std::mt19937_64 gen(seed);
+  std::uniform_int_distribution<int64_t> pos(-kFar, kFar);
+  std::uniform_int_distribution<int64_t> size(0, 2000);
+  std::vector<Box2_i64> boxes;
+  for (std::size_t i = 0; i < n; ++i) {
+    const int64_t x = pos(gen) / 1000000, y = pos(gen) / 1000000;
+    boxes.emplace_back(x, y, x + size(gen), y + size(gen));
+  }
+  return boxes;
+}
+
+TEST(TiledVector, Boxes) {
+  TiledVector<Box2_i64, int16_t> boxes(10000);
+  boxes.Insert(Box2_i64(kFar + 10, kFar + 20, kFar + 30, kFar + 40));
+  boxes.Insert(Box2_i64(-kFar, -kFar, -kFar + 5, -kFar + 5));
+  boxes.Insert(Box2_i64(kFar + 100, kFar, kFar + 200, kFar + 300));
+  // Crosses a tile border.
+  boxes.Insert(Box2_i64(9990, 0, 10010, 10));
+
+  EXPECT_EQ(boxes.Size(), 4);
+  EXPECT_EQ(boxes.NumTiles(), 2);
+  EXPECT_EQ(boxes.NumWide(), 1);
+  EXPECT_THAT(
+      boxes.ToVector(),
+      ElementsAre(Box2_i64(kFar + 10, kFar + 20, kFar + 30, kFar + 40),
+                  Box2_i64(kFar + 100, kFar, kFar + 200, kFar + 300),
+                  Box2_i64(-kFar, -kFar, -kFar + 5, -kFar + 5),
+                  Box2_i64(9990, 0, 10010, 10)));
+  using Narrow = TiledVector<Box2_i64, int16_t>;
+  EXPECT_DEATH(Narrow(1 << 16), "Tile size");
+}
+
+TEST(TiledVector, PointsAndSegments) {
+  TiledVector<Point2_i64, int32_t> points(int64_t{1} << 30);
+  TiledVector<Segment2_i64, int32_t> segments(int64_t{1} << 30);
+  points.Insert(Point2_i64(-kFar - 1, 7));
+  segments.Insert(
+      Segment2_i64(Point2_i64(kFar + 10, 3), Point2_i64(kFar + 5, 8)));
+
+  EXPECT_THAT(points.ToVector(), ElementsAre(Point2_i64(-kFar - 1, 7)));
+  EXPECT_THAT(segments.ToVector(),
+              ElementsAre(Segment2_i64(Point2_i64(kFar + 10, 3),
+                                       Point2_i64(kFar + 5, 8))));
+  EXPECT_EQ(segments.NumWide(), 0);
+}
+
+TEST(TiledRtree, SameAsRtree) {
+  const std::vector<Box2_i64> boxes = RandomBoxes(5000, 49);
+  TiledRtree<Box2_i64, int16_t> tiled(20000);
+  for (const Box2_i64& b : boxes) tiled.Insert(b);
+  ASSERT_EQ(tiled.Size(), boxes.size());
+
+  const std::vector<Box2_i64> windows = {
+      Box2_i64(0, 0, 100000, 100000), Box2_i64(-50000, -50000, 0, 0),
+      Box2_i64(-kFar, -kFar, kFar, kFar), Box2_i64(19990, 0, 20000, 20000)};
+  for (const Box2_i64& w : windows) {
+    std::vector<Box2_i64> expected;
+    for (const Box2_i64& b : boxes) {
+      if (IsIntersect(b, w)) expected.push_back(b);
+    }
+    EXPECT_THAT(tiled.QueryIntersects(w), UnorderedElementsAreArray(expected))
+        << w;
+  }
+}
+
+TEST(TiledRtree, TileBorders) {
+  TiledRtree<Box2_i64, int16_t> tiled(100);
+  tiled.Insert(Box2_i64(50, 50, 100, 60));  // Touches the next tile.
+  tiled.Insert(Box2_i64(90, 0, 110, 10));   // Crosses into the next tile.
+  tiled.Insert(Box2_i64(100, 0, 105, 5));
+
+  EXPECT_EQ(tiled.NumWide(), 1);
+  EXPECT_THAT(tiled.QueryIntersects(Box2_i64(100, 0, 200, 100)),
+              UnorderedElementsAreArray({Box2_i64(50, 50, 100, 60),
+                                         Box2_i64(90, 0, 110, 10),
+                                         Box2_i64(100, 0, 105, 5)}));
+  EXPECT_TRUE(tiled.Remove(Box2_i64(100, 0, 105, 5)));
+  EXPECT_TRUE(tiled.Remove(Box2_i64(90, 0, 110, 10)));
+  EXPECT_FALSE(tiled.Remove(Box2_i64(90, 0, 110, 10)));
+  EXPECT_FALSE(tiled.Remove(Box2_i64(0, 0, 1, 1)));
+  EXPECT_EQ(tiled.Size(), 1);
+  EXPECT_EQ(tiled.NumTiles(), 1);
+  EXPECT_THAT(tiled.QueryIntersects(Box2_i64(0, 0, 200, 200)),
+              ElementsAre(Box2_i64(50, 50, 100, 60)));
+}
+
+TEST(TiledRtree, ExtremeWindows) {
+  constexpr int64_t kMin = std::numeric_limits<int64_t>::min();
+  constexpr int64_t kMax = std::numeric_limits<int64_t>::max();
+  TiledRtree<Box2_i64, int16_t> tiled(16);
+  tiled.Insert(Box2_i64(0, 0, 10, 10));
+  tiled.Insert(Box2_i64(kMax - 10, kMax - 10, kMax - 5, kMax - 5));
+  TiledRtree<Box2_i64, int16_t> unit(1);
+  unit.Insert(Box2_i64(kMax - 1, kMax - 1, kMax, kMax));
+  unit.Insert(Box2_i64(kMin, kMin, kMin + 1, kMin + 1));
+
+  // 2^60 tiles along each axis: the product of the counts overflows.
+  EXPECT_THAT(tiled.QueryIntersects(Box2_i64(kMin, kMin, kMax, kMax)),
+              UnorderedElementsAre(Box2_i64(0, 0, 10, 10),
+                                   Box2_i64(kMax - 10, kMax - 10, kMax - 5,
+                                            kMax - 5)));
+  // Tile indices at the limits of int64_t.
+  EXPECT_THAT(unit.QueryIntersects(Box2_i64(kMax - 2, kMax - 2, kMax, kMax)),
+              ElementsAre(Box2_i64(kMax - 1, kMax - 1, kMax, kMax)));
+  EXPECT_THAT(unit.QueryIntersects(Box2_i64(kMin, kMin, kMin + 2, kMin + 2)),
+              ElementsAre(Box2_i64(kMin, kMin, kMin + 1, kMin + 1)));
+  EXPECT_EQ(unit.QueryIntersects(Box2_i64(kMin, kMin, kMax, kMax)).size(), 2);
+}
+
+TEST(TiledRtree, PointsAndSegments) {
+  TiledRtree<Point2_i64, int32_t> points(int64_t{1} << 20);
+  TiledRtree<Segment2_i64, int32_t> segments(int64_t{1} << 20);
+  points.Insert(Point2_i64(kFar, kFar));
+  points.Insert(Point2_i64(-kFar, 3));
+  const Segment2_i64 s(Point2_i64(kFar + 10, 3), Point2_i64(kFar + 5, 8));
+  segments.Insert(s);
+
+  EXPECT_THAT(points.QueryIntersects(Box2_i64(kFar - 1, kFar - 1, kFar, kFar)),
+              ElementsAre(Point2_i64(kFar, kFar)));
+  EXPECT_THAT(segments.QueryIntersects(Box2_i64(kFar, 0, kFar + 6, 8)),
+              ElementsAre(s));
+  EXPECT_THAT(segments.QueryIntersects(Box2_i64(kFar, 0, kFar + 4, 8)),
+              ElementsAre());
+}
+
+}  // namespace moab
@@ -0,0 +1,271 @@
+#ifndef MOAB_TRANSFORM_H_
+#define MOAB_TRANSFORM_H_
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "absl/log/log.h"
+#include "absl/strings/str_cat.h"
+#include "absl/strings/str_format.h"
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+#include "moab/segment2.h"
+
+namespace moab {
+
+// The eight Manhattan orientations: rotations counterclockwise about the
+// origin, optionally preceded by a mirror. MX mirrors about the x axis
+// (y -> -y), MY about the y axis (x -> -x); MXR90 is MX followed by R90.
+enum class Orientation : uint8_t {
+  kR0,     // (x, y)
+  kR90,    // (-y, x)
+  kR180,   // (-x, -y)
+  kR270,   // (y, -x)
+  kMX,     // (x, -y)
+  kMXR90,  // (y, x)
+  kMY,     // (-x, y)
+  kMYR90,  // (-y, -x)
+};
+
+namespace transform_internal {
+
+// Rows of the 2x2 matrix of every orientation, {a, b, c, d} for
+// x' = a * x + b * y, y' = c * x + d * y.
+inline constexpr std::array<std::array<int, 4>, 8> kMatrices = {{
+    {1, 0, 0, 1},
+    {0, -1, 1, 0},
+    {-1, 0, 0, -1},
+    {0, 1, -1, 0},
+    {1, 0, 0, -1},
+    {0, 1, 1, 0},
+    {-1, 0, 0, 1},
+    {0, -1, -1, 0},
+}};
+
+inline constexpr std::array<std::string_view, 8> kNames = {
+    "R0", "R90", "R180", "R270", "MX", "MXR90", "MY", "MYR90"};
+
+// Returns the orientation with the given matrix.
+inline Orientation FromMatrix(const std::array<int, 4>& m) {
+  for (std::size_t i = 0; i < kMatrices.size(); ++i) {
+    if (kMatrices[i] == m) return static_cast<Orientation>(i);
+  }
+  LOG(FATAL) << "Not a Manhattan orientation.";
+  return Orientation::kR0;
+}
+
+}  // namespace transform_internal
+
+// An orientation followed by a shift by offset, e.g., the placement of an
+// instance: p -> M * p + offset.
+//
+// Usage:
+//   Transform2_i t(Orientation::kR90, Point2_i(100, 0));
+//   std::vector<Box2_i> placed;
+//   Transform(t, master_boxes, placed);
+template <typename T>
+class Transform2 {
+ public:
+  // Type aliases.
+  using coordinate_type = T;
+
+  // Constructors.
+  Transform2() = default;
+  explicit Transform2(Orientation orientation,
+                      const Point2<T>& offset = Point2<T>(0, 0))
+      : orientation_(orientation), offset_(offset) {}
+  explicit Transform2(Orientation orientation, T dx, T dy)
+      : orientation_(orientation), offset_(dx, dy) {}
+  Transform2(const Transform2&) = default;
+  Transform2(Transform2&&) = default;
+  ~Transform2() = default;
+
+  // Assignment operators.
+  Transform2& operator=(const Transform2&) = default;
+  Transform2& operator=(Transform2&&) = default;
+
+  // Accessors.
+  Orientation orientation() const { return orientation_; }
+  const Point2<T>& offset() const { return offset_; }
+  // Returns true if the transform mirrors. Mirrored rings get their points
+  // reversed to keep their winding.
+  bool IsMirrored() const { return orientation_ >= Orientation::kMX; }
+  // Returns true if x and y trade places (R90, R270, MXR90, MYR90).
+  bool SwapsAxes() const { return Matrix()[0] == 0; }
+
+  // Operations.
+  Point2<T> Apply(const Point2<T>& p) const {
+    const std::array<int, 4>& m = Matrix();
+    return Point2<T>(m[0] * p.x() + m[1] * p.y() + offset_.x(),
+                     m[2] * p.x() + m[3] * p.y() + offset_.y());
+  }
+  Segment2<T> Apply(const Segment2<T>& s) const {
+    return Segment2<T>(Apply(s.p0()), Apply(s.p1()));
+  }
+  // The corners are renormalized, so the result is a valid box.
+  Box2<T> Apply(const Box2<T>& b) const {
+    const Point2<T> p0 = Apply(b.ll()), p1 = Apply(b.ur());
+    return Box2<T>(p0.x(), p0.y(), p1.x(), p1.y());
+  }
+  // Mirroring reverses the order of the points, so the ring keeps its
+  // winding (counterclockwise, as Boost expects of Ring2).
+  Ring2<T> Apply(const Ring2<T>& r) const {
+    Ring2<T> out;
+    out.UpdatePoints([&](auto& points) {
+      const std::size_t n = r.Size();
+      points.resize(n);
+      for (std::size_t i = 0; i < n; ++i) {
+        points[IsMirrored() ? n - 1 - i : i] = Apply(r[i]);
+      }
+    });
+    return out;
+  }
+  // Returns the transform that undoes this one.
+  Transform2 Inverse() const {
+    // The matrices are orthogonal: the inverse is the transpose.
+    const std::array<int, 4>& m = Matrix();
+    const std::array<int, 4> inv = {m[0], m[2], m[1], m[3]};
+    return Transform2(transform_internal::FromMatrix(inv),
+                      -(inv[0] * offset_.x() + inv[1] * offset_.y()),
+                      -(inv[2] * offset_.x() + inv[3] * offset_.y()));
+  }
+
+  // Operators.
+  // Operator - Composition: (a * b).Apply(p) == a.Apply(b.Apply(p)).
+  Transform2 operator*(const Transform2& b) const {
+    const std::array<int, 4>& m = Matrix();
+    const std::array<int, 4>& n = b.Matrix();
+    const std::array<int, 4> mn = {
+        m[0] * n[0] + m[1] * n[2], m[0] * n[1] + m[1] * n[3],
+        m[2] * n[0] + m[3] * n[2], m[2] * n[1] + m[3] * n[3]};
+    return Transform2(transform_internal::FromMatrix(mn), Apply(b.offset_));
+  }
+  // Operator - Equality
+  bool operator==(const Transform2& t) const {
+    return orientation_ == t.orientation_ && offset_ == t.offset_;
+  }
+  bool operator!=(const Transform2& t) const { return !(*this == t); }
+
+  // String conversion.
+  template <typename Sink>
+  friend void AbslStringify(Sink& sink, const Transform2& t) {
+    absl::Format(&sink, "(%s %v)",
+                 transform_internal::kNames[static_cast<std::size_t>(
+                     t.orientation_)],
+                 t.offset_);
+  }
+  std::string ToString() const { return absl::StrCat(*this); }
+  friend std::ostream& operator<<(std::ostream& os, const Transform2& t) {
+    os << t.ToString();
+    return os;
+  }
+
+  // Hash.
+  template <typename H>
+  friend H AbslHashValue(H h, const Transform2& t) {
+    return H::combine(std::move(h), t.orientation_, t.offset_);
+  }
+
+ private:
+  const std::array<int, 4>& Matrix() const {
+    return transform_internal::kMatrices[static_cast<std::size_t>(
+        orientation_)];
+  }
+
+  Orientation orientation_ = Orientation::kR0;
+  Point2<T> offset_;
+};
+
+// Batch transforms.
+// The matrix and offset are loaded once and every element goes through the
+// same branch-free multiply-add, so the loops over contiguous coordinates
+// vectorize. out is overwritten and its capacity reused.
+
+// Transforms points[0, n) into out[0, n). out may equal points.
+template <typename T>
+void Transform(const Transform2<T>& t, const Point2<T>* points, std::size_t n,
+               Point2<T>* out) {
+  const std::array<int, 4>& m =
+      transform_internal::kMatrices[static_cast<std::size_t>(t.orientation())];
+  const T a = m[0], b = m[1], c = m[2], d = m[3];
+  const T dx = t.offset().x(), dy = t.offset().y();
+  for (std::size_t i = 0; i < n; ++i) {
+    const T x = points[i].x(), y = points[i].y();
+    out[i].Set(a * x + b * y + dx, c * x + d * y + dy);
+  }
+}
+
+// Transforms every element of a std::vector of Point2, Segment2, Box2 or
+// Ring2 in place.
+template <typename T>
+void Transform(const Transform2<T>& t, std::vector<Point2<T>>& points) {
+  Transform(t, points.data(), points.size(), points.data());
+}
+template <typename T>
+void Transform(const Transform2<T>& t, std::vector<Segment2<T>>& segments) {
+  for (Segment2<T>& s : segments) Transform(t, s.data(), 2, s.data());
+}
+template <typename T>
+void Transform(const Transform2<T>& t, std::vector<Box2<T>>& boxes) {
+  for (Box2<T>& b : boxes) b = t.Apply(b);
+}
+template <typename T>
+void Transform(const Transform2<T>& t, std::vector<Ring2<T>>& rings) {
+  for (Ring2<T>& r : rings) {
+    r.UpdatePoints([&t](auto& points) {
+      Transform(t, points.data(), points.size(), points.data());
+      if (t.IsMirrored()) std::reverse(points.begin(), points.end());
+    });
+  }
+}
+
+// Writes the transformed elements of in to out.
+template <typename T>
+void Transform(const Transform2<T>& t, const std::vector<Point2<T>>& in,
+               std::vector<Point2<T>>& out) {
+  out.resize(in.size());
+  Transform(t, in.data(), in.size(), out.data());
+}
+template <typename T>
+void Transform(const Transform2<T>& t, const std::vector<Segment2<T>>& in,
+               std::vector<Segment2<T>>& out) {
+  out.resize(in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    Transform(t, in[i].data(), 2, out[i].data());
+  }
+}
+template <typename T>
+void Transform(const Transform2<T>& t, const std::vector<Box2<T>>& in,
+               std::vector<Box2<T>>& out) {
+  out.resize(in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) out[i] = t.Apply(in[i]);
+}
+template <typename T>
+void Transform(const Transform2<T>& t, const std::vector<Ring2<T>>& in,
+               std::vector<Ring2<T>>& out) {
+  out.resize(in.size());
+  for (std::size_t i = 0; i < in.size(); ++i) {
+    out[i].UpdatePoints([&](auto& points) {
+      points.resize(in[i].Size());
+      Transform(t, in[i].Points().data(), in[i].Size(), points.data());
+      if (t.IsMirrored()) std::reverse(points.begin(), points.end());
+    });
+  }
+}
+
+// Aliases.
+using Transform2_i = Transform2<int>;
+using Transform2_i32 = Transform2<int32_t>;
+using Transform2_i64 = Transform2<int64_t>;
+
+}  // namespace moab
+
+#endif  // MOAB_TRANSFORM_H_
@@ -0,0 +1,148 @@
+#include "transform.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "absl/hash/hash_testing.h"
+#include "absl/strings/str_format.h"
+#include "moab/box2.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+#include "moab/segment2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+constexpr Orientation kOrientations[] = {
+    Orientation::kR0,  Orientation::kR90,   Orientation::kR180,
+    Orientation::kR270, Orientation::kMX,   Orientation::kMXR90,
+    Orientation::kMY,  Orientation::kMYR90};
+
+TEST(Transform2, ApplyPoint) {
+  const Point2_i p(2, 1);
+  auto apply = [&p](Orientation o) { return Transform2_i(o).Apply(p); };
+
+  EXPECT_EQ(apply(Orientation::kR0), Point2_i(2, 1));
+  EXPECT_EQ(apply(Orientation::kR90), Point2_i(-1, 2));
+  EXPECT_EQ(apply(Orientation::kR180), Point2_i(-2, -1));
+  EXPECT_EQ(apply(Orientation::kR270), Point2_i(1, -2));
+  EXPECT_EQ(apply(Orientation::kMX), Point2_i(2, -1));
+  EXPECT_EQ(apply(Orientation::kMXR90), Point2_i(1, 2));
+  EXPECT_EQ(apply(Orientation::kMY), Point2_i(-2, 1));
+  EXPECT_EQ(apply(Orientation::kMYR90), Point2_i(-1, -2));
+  EXPECT_EQ(Transform2_i(Orientation::kR90, 10, 20).Apply(p),
+            Point2_i(9, 22));
+
+  // Agrees with Point2 rotations.
+  Point2_i q = p;
+  q.Rotate90();
+  EXPECT_EQ(apply(Orientation::kR90), q);
+}
+
+TEST(Transform2, ApplyShapes) {
+  const Transform2_i t(Orientation::kR90, 100, 0);
+
+  EXPECT_EQ(t.Apply(Box2_i(0, 0, 10, 20)), Box2_i(80, 0, 100, 10));
+  EXPECT_EQ(t.Apply(Segment2_i(0, 0, 10, 0)), Segment2_i(100, 0, 100, 10));
+  EXPECT_EQ(t.Apply(Ring2_i(Box2_i(0, 0, 10, 20))).Area(), 200);
+  EXPECT_EQ(Transform2_i(Orientation::kMX)
+                .Apply(Ring2_i(Box2_i(0, 0, 10, 20)))
+                .Winding(),
+            gtl::counterclockwise_winding);
+  EXPECT_TRUE(Transform2_i(Orientation::kMY).IsMirrored());
+  EXPECT_FALSE(Transform2_i(Orientation::kR270).IsMirrored());
+  EXPECT_TRUE(Transform2_i(Orientation::kMXR90).SwapsAxes());
+  EXPECT_FALSE(Transform2_i(Orientation::kR180).SwapsAxes());
+}
+
+TEST(Transform2, KeepsWinding) {
+  const Ring2_i l_shape = {Point2_i(0, 0),   Point2_i(20, 0), Point2_i(20, 10),
+                           Point2_i(10, 10), Point2_i(10, 20), Point2_i(0, 20),
+                           Point2_i(0, 0)};
+  for (Orientation o : kOrientations) {
+    const Transform2_i t(o, 3, -4);
+    const Ring2_i r = t.Apply(l_shape);
+    std::vector<Ring2_i> in_place = {l_shape}, out;
+    Transform(t, in_place);
+    Transform(t, std::vector<Ring2_i>{l_shape}, out);
+
+    EXPECT_EQ(bg::area(r), 300) << t;
+    EXPECT_EQ(r.Winding(), gtl::counterclockwise_winding) << t;
+    EXPECT_EQ(r.Points().front(), t.Apply(l_shape[0])) << t;
+    EXPECT_THAT(in_place, ElementsAre(r)) << t;
+    EXPECT_THAT(out, ElementsAre(r)) << t;
+  }
+}
+
+TEST(Transform2, ComposeAndInverse) {
+  const Point2_i p(3, -7);
+  for (Orientation a : kOrientations) {
+    for (Orientation b : kOrientations) {
+      const Transform2_i ta(a, 5, -2), tb(b, -1, 4);
+
+      EXPECT_EQ((ta * tb).Apply(p), ta.Apply(tb.Apply(p)));
+    }
+    const Transform2_i ta(a, 5, -2);
+
+    EXPECT_EQ(ta.Inverse().Apply(ta.Apply(p)), p);
+    EXPECT_EQ(ta * ta.Inverse(), Transform2_i());
+  }
+}
+
+TEST(Transform, Batch) {
+  const Transform2_i t(Orientation::kMYR90, 7, 9);
+  std::vector<Point2_i> points;
+  std::vector<Box2_i> boxes;
+  std::vector<Segment2_i> segments;
+  std::vector<Ring2_i> rings;
+  for (int i = 0; i < 37; ++i) {
+    points.emplace_back(i, 2 * i - 5);
+    boxes.emplace_back(i, -i, 2 * i + 1, 3);
+    segments.emplace_back(i, 0, i, 10);
+    rings.push_back(Ring2_i(Box2_i(0, i, 5, i + 1)));
+  }
+  std::vector<Point2_i> points_out;
+  std::vector<Box2_i> boxes_out;
+  std::vector<Segment2_i> segments_out;
+  std::vector<Ring2_i> rings_out;
+  Transform(t, points, points_out);
+  Transform(t, boxes, boxes_out);
+  Transform(t, segments, segments_out);
+  Transform(t, rings, rings_out);
+
+  for (int i = 0; i < 37; ++i) {
+    EXPECT_EQ(points_out[i], t.Apply(points[i]));
+    EXPECT_EQ(boxes_out[i], t.Apply(boxes[i]));
+    EXPECT_EQ(segments_out[i], t.Apply(segments[i]));
+    EXPECT_EQ(rings_out[i], t.Apply(rings[i]));
+  }
+
+  Transform(t, points);
+  Transform(t, boxes);
+  Transform(t, segments);
+  Transform(t, rings);
+
+  EXPECT_EQ(points, points_out);
+  EXPECT_EQ(boxes, boxes_out);
+  EXPECT_EQ(segments, segments_out);
+  EXPECT_EQ(rings, rings_out);
+}
+
+TEST(StringConversion, SupportsAbslStringify) {
+  EXPECT_EQ(absl::StrFormat("%v", Transform2_i(Orientation::kMXR90, 1, 2)),
+            "(MXR90 (1 2))");
+}
+
+TEST(Hash, SupportsAbslHash) {
+  EXPECT_TRUE(absl::VerifyTypeImplementsAbslHashCorrectly({
+      Transform2_i(),
+      Transform2_i(Orientation::kR90),
+      Transform2_i(Orientation::kR90, 1, 0),
+      Transform2_i(Orientation::kMY, 0, 1),
+  }));
+}
+
+}  // namespace moab
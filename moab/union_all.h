@@ -0,0 +1,92 @@
+#ifndef MOAB_UNION_ALL_H_
+#define MOAB_UNION_ALL_H_
+
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "boost/polygon/polygon.hpp"
+#include "moab/parallel.h"
+#include "moab/rectilinear_grid.h"
+
+namespace moab {
+
+namespace gtl = boost::polygon;
+
+namespace union_all_internal {
+
+// Boost polygon set data that holds the edges of Set: polygon_90_set_data for
+// rectilinear sets (e.g., a std::vector of Box2) and polygon_set_data
+// otherwise.
+template <typename Set>
+using set_data_t = std::conditional_t<
+    std::is_same_v<typename gtl::is_polygon_90_set_type<Set>::type,
+                   gtl::gtl_yes>,
+    gtl::polygon_90_set_data<coordinate_of_t<Set>>,
+    gtl::polygon_set_data<coordinate_of_t<Set>>>;
+
+// Inserts the edges of a polygon set, or of every shape of a container of
+// shapes, without sorting them.
+template <typename Data, typename Set>
+void Insert(Data& data, const Set& s) {
+  using concept_type = typename gtl::geometry_concept<Set>::type;
+  if constexpr (std::is_same_v<concept_type, gtl::undefined_concept>) {
+    data.insert(s.begin(), s.end());
+  } else {
+    data.insert(s);
+  }
+}
+
+}  // namespace union_all_internal
+
+// N-ary polygon set union.
+// lhs |= sets[0] | sets[1] | ... | sets[n - 1];
+//
+// Calling UnionSet once per input re-sorts the growing result every time,
+// which is quadratic in the number of inputs. UnionAll instead gathers the
+// edges of all inputs and merges them with one sort and one scanline pass.
+//
+// With num_threads != 1 (0 means one thread per hardware thread) the inputs
+// are split into contiguous blocks whose unions are swept in parallel, and the
+// partial unions are then merged pairwise in a parallel tree. Merging smaller,
+// already overlap-free partial results keeps every sweep short.
+template <typename Lhs, typename Range>
+Lhs& UnionAll(Lhs& lhs, const Range& sets, std::size_t num_threads = 0) {
+  using Set = std::decay_t<decltype(*std::begin(sets))>;
+  using Data = union_all_internal::set_data_t<Set>;
+  std::vector<const Set*> inputs;
+  for (const Set& s : sets) inputs.push_back(&s);
+  if (inputs.empty()) return lhs;
+
+  constexpr std::size_t kMinSetsPerBlock = 16;
+  std::vector<Data> partial(
+      NumBlocks(inputs.size(), num_threads, kMinSetsPerBlock));
+  ParallelForBlocks(
+      inputs.size(), num_threads,
+      [&](std::size_t block, std::size_t begin, std::size_t end) {
+        Data& data = partial[block];
+        for (std::size_t i = begin; i < end; ++i) {
+          union_all_internal::Insert(data, *inputs[i]);
+        }
+        data.clean();
+      },
+      kMinSetsPerBlock);
+  while (partial.size() > 1) {
+    const std::size_t pairs = partial.size() / 2;
+    ParallelFor(pairs, num_threads, [&](std::size_t i) {
+      partial[2 * i].insert(partial[2 * i + 1]);
+      partial[2 * i].clean();
+    });
+    for (std::size_t i = 1; i < (partial.size() + 1) / 2; ++i) {
+      partial[i] = std::move(partial[2 * i]);
+    }
+    partial.resize((partial.size() + 1) / 2);
+  }
+  return gtl::operators::operator|=(lhs, partial[0]);
+}
+
+}  // namespace moab
+
+#endif  // MOAB_UNION_ALL_H_
@@ -0,0 +1,83 @@
+#include "union_all.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "boost/polygon/polygon.hpp"
+#include "moab/box2.h"
+#include "moab/operation.h"
+#include "moab/point2.h"
+#include "moab/ring2.h"
+
+namespace moab {
+
+using ::testing::ElementsAre;
+
+// Returns n per-cell box vectors of a 10-column grid of 100x100 cells. Boxes
+// spill over cell borders so that neighboring cells overlap.
+std::vector<std::vector<Box2_i>> CellSets(int n, int seed) {
+  std::mt19937 gen(seed);
+  std::uniform_int_distribution<int> pos(-20, 100);
+  std::uniform_int_distribution<int> size(1, 40);
+  std::vector<std::vector<Box2_i>> sets(n);
+  for (int c = 0; c < n; ++c) {
+    const int ox = c % 10 * 100, oy = c / 10 * 100;
+    for (int i = 0; i < 8; ++i) {
+      int x = ox + pos(gen), y = oy + pos(gen);
+      sets[c].emplace_back(x, y, x + size(gen), y + size(gen));
+    }
+  }
+  return sets;
+}
+
+TEST(UnionAll, Empty) {
+  std::vector<Box2_i> result = {Box2_i(0, 0, 1, 1)};
+  UnionAll(result, std::vector<std::vector<Box2_i>>{});
+
+  EXPECT_THAT(result, ElementsAre(Box2_i(0, 0, 1, 1)));
+}
+
+TEST(UnionAll, KeepsLhs) {
+  std::vector<Box2_i> result = {Box2_i(0, 0, 10, 10)};
+  std::vector<std::vector<Box2_i>> sets = {{Box2_i(10, 0, 20, 10)},
+                                           {Box2_i(5, 5, 15, 15)}};
+  UnionAll(result, sets);
+
+  EXPECT_EQ(Area(result), 250);
+}
+
+TEST(UnionAll, Rings) {
+  std::vector<std::vector<Ring2_i>> sets = {
+      {Ring2_i({Point2_i(0, 0), Point2_i(10, 0), Point2_i(0, 10),
+                Point2_i(0, 0)})},
+      {Ring2_i({Point2_i(0, 0), Point2_i(10, 0), Point2_i(10, 10),
+                Point2_i(0, 0)})}};
+  boost::polygon::polygon_set_data<int> result;
+  UnionAll(result, sets);
+
+  EXPECT_EQ(Area(result), 75);
+}
+
+void CheckMatchesRepeatedUnion(int n, std::size_t num_threads) {
+  const std::vector<std::vector<Box2_i>> sets = CellSets(n, 35 + n);
+  std::vector<Box2_i> expected;
+  for (const std::vector<Box2_i>& s : sets) UnionSet(expected, s);
+  std::vector<Box2_i> result;
+  UnionAll(result, sets, num_threads);
+
+  EXPECT_TRUE(Equivalence(result, expected));
+  EXPECT_EQ(Area(result), Area(expected));
+}
+
+TEST(UnionAll, MatchesRepeatedUnion) { CheckMatchesRepeatedUnion(37, 1); }
+
+TEST(UnionAll, ParallelTree) {
+  // 7 blocks: the tree merges an odd number of partial unions.
+  CheckMatchesRepeatedUnion(7 * 16, 7);
+  CheckMatchesRepeatedUnion(200, 4);
+}
+
+}  // namespace moab
@@ -0,0 +1,122 @@
+// Compares the value types with plain structs registered with Boost.Geometry
+// on the operations that dominate large layouts: Boost predicates over many
+// boxes and growing vectors of boxes. The moab types should match the plain
+// structs.
+//
+// Usage:
+//   bazel run -c opt //moab:value_types_benchmark
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "boost/geometry/algorithms/covered_by.hpp"
+#include "boost/geometry/algorithms/intersects.hpp"
+#include "boost/geometry/geometries/register/box.hpp"
+#include "boost/geometry/geometries/register/point.hpp"
+#include "moab/box2.h"
+#include "moab/point2.h"
+
+namespace moab {
+namespace {
+
+struct RawPoint {
+  int x;
+  int y;
+};
+
+struct RawBox {
+  RawPoint ll;
+  RawPoint ur;
+};
+
+}  // namespace
+}  // namespace moab
+
+BOOST_GEOMETRY_REGISTER_POINT_2D(moab::RawPoint, int, cs::cartesian, x, y)
+BOOST_GEOMETRY_REGISTER_BOX(moab::RawBox, moab::RawPoint, ll, ur)
+
+namespace moab {
+namespace {
+
+namespace bg = boost::geometry;
+
+constexpr int kNumBoxes = 1 << 12;
+
+template <typename B>
+B MakeBox(int xl, int yl, int xh, int yh);
+
+template <>
+Box2_i MakeBox<Box2_i>(int xl, int yl, int xh, int yh) {
+  return Box2_i(xl, yl, xh, yh);
+}
+
+template <>
+RawBox MakeBox<RawBox>(int xl, int yl, int xh, int yh) {
+  return RawBox{{xl, yl}, {xh, yh}};
+}
+
+template <typename B>
+std::vector<B> RandomBoxes(int n) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> pos(0, 10000);
+  std::uniform_int_distribution<int> size(1, 100);
+  std::vector<B> boxes;
+  boxes.reserve(n);
+  for (int i = 0; i < n; ++i) {
+    const int x = pos(gen);
+    const int y = pos(gen);
+    boxes.push_back(MakeBox<B>(x, y, x + size(gen), y + size(gen)));
+  }
+  return boxes;
+}
+
+template <typename B>
+void BM_Intersects(benchmark::State& state) {
+  const std::vector<B> boxes = RandomBoxes<B>(kNumBoxes);
+  const B window = MakeBox<B>(2500, 2500, 7500, 7500);
+  for (auto _ : state) {
+    int64_t count = 0;
+    for (const B& b : boxes) count += bg::intersects(b, window);
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumBoxes);
+}
+BENCHMARK_TEMPLATE(BM_Intersects, Box2_i);
+BENCHMARK_TEMPLATE(BM_Intersects, RawBox);
+
+template <typename B>
+void BM_CoveredBy(benchmark::State& state) {
+  const std::vector<B> boxes = RandomBoxes<B>(kNumBoxes);
+  const B window = MakeBox<B>(2500, 2500, 7500, 7500);
+  for (auto _ : state) {
+    int64_t count = 0;
+    for (const B& b : boxes) count += bg::covered_by(b, window);
+    benchmark::DoNotOptimize(count);
+  }
+  state.SetItemsProcessed(state.iterations() * kNumBoxes);
+}
+BENCHMARK_TEMPLATE(BM_CoveredBy, Box2_i);
+BENCHMARK_TEMPLATE(BM_CoveredBy, RawBox);
+
+// Grows a vector without reserving, so the time is dominated by
+// reallocations that move every box. glibc adapts its mmap threshold to the
+// earlier runs, so compare the two types with --benchmark_filter one at a
+// time.
+template <typename B>
+void BM_PushBack(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  for (auto _ : state) {
+    std::vector<B> boxes;
+    for (int i = 0; i < n; ++i) boxes.push_back(MakeBox<B>(i, i, i + 1, i + 1));
+    benchmark::DoNotOptimize(boxes.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK_TEMPLATE(BM_PushBack, Box2_i)->Range(1 << 10, 1 << 20);
+BENCHMARK_TEMPLATE(BM_PushBack, RawBox)->Range(1 << 10, 1 << 20);
+
+}  // namespace
+}  // namespace moab